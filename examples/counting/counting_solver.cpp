@@ -1,5 +1,6 @@
 #include "semx.h"
 #include <iostream>
+#include <limits>
 #include <memory>
 
 using namespace semcal;
@@ -39,11 +40,11 @@ public:
         // Count models in each resulting state
         size_t totalCount = 0;
         for (const auto& resultState : results) {
-            auto models = resultState->concretize(
+            auto models = resultState->models(
                 pipeline_->getSemantics(),
                 pipeline_->getConcretization()
             );
-            totalCount += models.size();
+            totalCount += models->countAtMost(std::numeric_limits<size_t>::max());
         }
 
         return totalCount;
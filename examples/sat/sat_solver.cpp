@@ -1,4 +1,6 @@
 #include "semx.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
 
@@ -8,23 +10,21 @@ using namespace semcal;
  * @brief Example SAT solver built using SemCal operators.
  * 
  * This demonstrates how to construct a pure Boolean satisfiability (SAT) solver
- * by orchestrating semantic operators for propositional logic.
+ * on the CDCL SAT backend: a state is satisfiable exactly when the backend
+ * cannot refute it.
  */
 class SimpleSATSolver {
 private:
-    std::unique_ptr<solver::strategies::LegacyOperatorPipeline> pipeline_;
+    backends::CdclSatBackend backend_;
 
 public:
-    SimpleSATSolver() {
-        pipeline_ = solver::strategies::LegacyPipelineFactory::createDefault();
-    }
-
     /**
      * @brief Check if a Boolean formula is satisfiable.
-     * @param formula The propositional formula to check
-     * @return true if satisfiable, false otherwise
+     * @param formula The propositional formula to check (clausal or CNF)
+     * @return OK if satisfiable, UNSAT if not, UNKNOWN if the formula is
+     *         not clausal
      */
-    bool isSatisfiable(const core::Formula& formula) {
+    util::OpStatus isSatisfiable(const core::Formula& formula) {
         // Create initial semantic state with top abstract element
         auto topElement = std::make_unique<domain::TopElement>();
         auto state = std::make_unique<state::SemanticState>(
@@ -32,27 +32,66 @@ public:
             std::move(topElement)
         );
 
-        // Use depth-first search strategy
-        solver::strategies::LegacyDepthFirstStrategy strategy(100);
-        auto results = strategy.execute(*state, *pipeline_);
+        // OK: the backend found a model; UNSAT: refuted
+        return backend_.refute(*state).status;
+    }
 
-        // If we found any feasible states, the formula is satisfiable
-        return !results.empty();
+    const backends::CdclSolver::Stats& getStats() const {
+        return backend_.getSolver().getStats();
     }
 };
 
-int main() {
+static const char* statusName(util::OpStatus status) {
+    switch (status) {
+    case util::OpStatus::OK:
+        return "Yes";
+    case util::OpStatus::UNSAT:
+        return "No";
+    default:
+        return "Unknown";
+    }
+}
+
+int main(int argc, char** argv) {
     std::cout << "SemCal SAT Solver Example" << std::endl;
     std::cout << "=========================" << std::endl;
 
+    if (argc > 1) {
+        // Solve a DIMACS CNF file ("-" reads standard input)
+        std::string path = argv[1];
+        auto loaded = path == "-" ? io::DimacsReader::readStream(stdin)
+                                  : io::DimacsReader::readFile(path);
+        if (loaded.status != util::OpStatus::OK) {
+            std::cerr << path << ": " << loaded.witness.toString() << std::endl;
+            return 1;
+        }
+        const auto& cnf = **loaded.value;
+        std::cout << "Variables: " << cnf.getClauses().numVars()
+                  << ", clauses: " << cnf.getClauses().numClauses() << std::endl;
+
+        SimpleSATSolver solver;
+        auto start = std::chrono::steady_clock::now();
+        util::OpStatus status = solver.isSatisfiable(cnf);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Satisfiable: " << statusName(status) << std::endl;
+
+        const auto& stats = solver.getStats();
+        std::cout << "Decisions: " << stats.decisions
+                  << ", conflicts: " << stats.conflicts
+                  << ", propagations: " << stats.propagations
+                  << " (" << static_cast<std::uint64_t>(stats.propagations / std::max(seconds, 1e-9))
+                  << "/s), restarts: " << stats.restarts << std::endl;
+        return status == util::OpStatus::OK ? 10 : status == util::OpStatus::UNSAT ? 20 : 0;
+    }
+
     // Create a simple Boolean formula: (a ∨ b) ∧ (¬a ∨ c)
     auto formula1 = std::make_unique<core::ConcreteFormula>("(and (or a b) (or (not a) c))");
     
     SimpleSATSolver solver;
-    bool result = solver.isSatisfiable(*formula1);
+    util::OpStatus result = solver.isSatisfiable(*formula1);
     
     std::cout << "Formula: " << formula1->toString() << std::endl;
-    std::cout << "Satisfiable: " << (result ? "Yes" : "No") << std::endl;
+    std::cout << "Satisfiable: " << statusName(result) << std::endl;
 
     return 0;
 }
@@ -9,22 +9,95 @@ using namespace semcal;
  * 
  * This demonstrates how to construct a Satisfiability Modulo Theories (SMT) solver
  * by orchestrating semantic operators.
+ *
+ * The Boolean skeleton is solved first (lazy SMT): CnfEncoder abstracts
+ * the theory atoms, CDCL enumerates skeleton models, and the LP backend
+ * refutes the atoms each one selects, blocking it. Formulas this does not
+ * decide go to the operator pipeline.
  */
 class SimpleSMTSolver {
 private:
     std::unique_ptr<solver::strategies::LegacyOperatorPipeline> pipeline_;
+    backends::LpSimplexBackend lp_;
+    core::CnfEncoder encoder_;
+    int maxRounds_ = 1000;
+
+    /**
+     * @brief Solve the Boolean skeleton against the linear theory.
+     * @return UNSAT, OK if the formula is propositional and satisfiable,
+     * UNKNOWN otherwise
+     */
+    util::OpStatus checkSkeleton(const core::Formula& formula) {
+        encoder_.encode(formula);
+        backends::CdclSolver sat;
+        sat.ensureVariables(encoder_.numVariables());
+        sat.addClauses(encoder_.getClauses());
+
+        core::TermStore& store = core::TermStore::global();
+        for (int round = 0; round < maxRounds_; ++round) {
+            if (sat.solve() == backends::CdclSolver::Result::UNSAT) {
+                return util::OpStatus::UNSAT;
+            }
+            if (encoder_.isPropositional()) {
+                return util::OpStatus::OK;
+            }
+
+            std::vector<core::TermId> atoms;
+            std::vector<core::Lit> blocking;
+            for (core::Var v = 0; v < encoder_.numVariables(); ++v) {
+                core::TermId atom = encoder_.atomTerm(v);
+                if (atom == core::kNullTerm) {
+                    continue;
+                }
+                bool value = sat.modelValue(v);
+                atoms.push_back(value ? atom : store.mkNot(atom));
+                blocking.push_back(core::mkLit(v, value));
+            }
+            state::SemanticState theory(
+                std::make_unique<core::ConcreteFormula>(store.mkAnd(atoms)),
+                std::make_unique<domain::TopElement>());
+            if (lp_.refute(theory).status != util::OpStatus::UNSAT) {
+                return util::OpStatus::UNKNOWN;
+            }
+            sat.addClause(blocking);
+        }
+        return util::OpStatus::UNKNOWN;
+    }
 
 public:
     SimpleSMTSolver() {
         pipeline_ = solver::strategies::LegacyPipelineFactory::createDefault();
     }
 
+    /**
+     * @brief Take the sorts of the script's constants, so that = and
+     * distinct over Bool constants are solved as Boolean connectives.
+     */
+    void setDeclarations(const std::vector<io::SmtLibDeclaration>& declarations) {
+        core::TermStore& store = core::TermStore::global();
+        encoder_.clearDeclarations();
+        for (const auto& decl : declarations) {
+            if (decl.argSorts.empty()) {
+                encoder_.declare(decl.name, store.isLeaf(decl.sort) && store.name(decl.sort) == "Bool");
+            }
+        }
+    }
+
     /**
      * @brief Check if a formula is satisfiable.
      * @param formula The formula to check
      * @return true if satisfiable, false otherwise
      */
     bool isSatisfiable(const core::Formula& formula) {
+        switch (checkSkeleton(formula)) {
+        case util::OpStatus::UNSAT:
+            return false;
+        case util::OpStatus::OK:
+            return true;
+        default:
+            break;
+        }
+
         // Create initial semantic state with top abstract element
         auto topElement = std::make_unique<domain::TopElement>();
         auto state = std::make_unique<state::SemanticState>(
@@ -41,10 +114,27 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
     std::cout << "SemCal SMT Solver Example" << std::endl;
     std::cout << "=========================" << std::endl;
 
+    if (argc > 1) {
+        // Solve an SMT-LIB v2 script ("-" reads standard input)
+        SimpleSMTSolver solver;
+        io::SmtLibReader reader;
+        reader.setCheckSatCallback([&solver, &reader](const core::Formula& assertions) {
+            solver.setDeclarations(reader.getDeclarations());
+            std::cout << (solver.isSatisfiable(assertions) ? "sat" : "unsat") << std::endl;
+        });
+        std::string path = argv[1];
+        auto result = path == "-" ? reader.readStream(stdin) : reader.readFile(path);
+        if (result.status != util::OpStatus::OK) {
+            std::cerr << path << ": " << result.witness.toString() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Create a simple SMT formula with theory constraints: (x > 0) ∧ (x < 10)
     auto formula1 = std::make_unique<core::ConcreteFormula>("(and (> x 0) (< x 10))");
     
@@ -54,5 +144,12 @@ int main() {
     std::cout << "Formula: " << formula1->toString() << std::endl;
     std::cout << "Satisfiable: " << (result ? "Yes" : "No") << std::endl;
 
+    // A purely propositional one: three Booleans are never pairwise distinct
+    auto formula2 = std::make_unique<core::ConcreteFormula>("(distinct p q r)");
+    result = solver.isSatisfiable(*formula2);
+
+    std::cout << "Formula: " << formula2->toString() << std::endl;
+    std::cout << "Satisfiable: " << (result ? "Yes" : "No") << std::endl;
+
     return 0;
 }
@@ -0,0 +1,244 @@
+#ifndef SEMCAL_BACKENDS_CDCL_H
+#define SEMCAL_BACKENDS_CDCL_H
+
+#include "lrat_writer.h"
+#include "semcal/core/clause_arena.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief Conflict-driven clause-learning SAT solver.
+ *
+ * The usual MiniSat/Glucose architecture:
+ * - two watched literals per clause, with a blocking literal in each
+ *   watcher so satisfied clauses are skipped without touching them
+ * - EVSIDS branching (activity bumps grow by 1/0.95 per conflict) over
+ *   a binary heap, with phase saving
+ * - first-UIP learning with recursive clause minimization
+ * - Glucose restarts: restart when the LBD average of the last 50
+ *   conflicts exceeds the global average by 25%
+ * - learned-clause reduction every 2000 + 300k conflicts, keeping
+ *   glue clauses (LBD ≤ 2) and the better half of the rest by LBD and
+ *   activity; the clause memory is compacted afterwards
+ *
+ * Clauses live in one flat array of 32-bit words (header + literals),
+ * like core::ClauseArena, so propagation walks contiguous memory.
+ *
+ * solve() takes assumptions: on UNSAT, finalConflict() is a clause over
+ * negated assumptions implied by the clauses (empty if the clauses
+ * alone are unsatisfiable). Learned clauses are kept across calls, so
+ * incremental use with changing assumptions gets faster over time.
+ *
+ * With setProof(), every derived clause is written as an LRAT step:
+ * learned clauses with the reasons resolved during analysis as hints,
+ * root-level units, and the final conflict or empty clause of an UNSAT
+ * answer. Input clauses are numbered 1, 2, ... in the order added, so
+ * the proof can be checked against the same clause list.
+ */
+class CdclSolver {
+public:
+    using Lit = core::Lit;
+    using Var = core::Var;
+
+    enum class Result { SAT, UNSAT, UNKNOWN };
+
+    struct Stats {
+        std::uint64_t decisions = 0;
+        std::uint64_t propagations = 0;
+        std::uint64_t conflicts = 0;
+        std::uint64_t restarts = 0;
+        std::uint64_t reductions = 0;
+        std::uint64_t learned = 0;   // learned clauses (units included)
+        std::uint64_t deleted = 0;   // learned clauses dropped by reduction
+    };
+
+    /**
+     * @brief Add a fresh variable.
+     */
+    Var newVariable();
+
+    /**
+     * @brief Make sure variables 0 .. count-1 exist.
+     */
+    void ensureVariables(std::uint32_t count);
+
+    std::uint32_t numVariables() const { return static_cast<std::uint32_t>(level_.size()); }
+
+    /**
+     * @brief Add a clause (variables are created as needed).
+     * @return false if the clause set became unsatisfiable at the root
+     */
+    bool addClause(const Lit* lits, std::size_t count) { return addInput(lits, count, ++lastId_); }
+    bool addClause(const std::vector<Lit>& lits) { return addClause(lits.data(), lits.size()); }
+
+    /**
+     * @brief Add all clauses of an arena. Their proof ids are reserved
+     * up front, so clause i of the arena is id i + 1 in a fresh solver.
+     */
+    bool addClauses(const core::ClauseArena& arena);
+
+    /**
+     * @brief Write an LRAT proof of all derived clauses to a writer that
+     * outlives the solver. Must be called before any clause is added.
+     */
+    void setProof(LratWriter* proof);
+
+    /**
+     * @brief Search for a model under assumptions.
+     * @param maxConflicts Give up with UNKNOWN after this many conflicts (0 = no limit)
+     */
+    Result solve(const std::vector<Lit>& assumptions = {}, std::uint64_t maxConflicts = 0);
+
+    /**
+     * @brief Value of a variable in the model of the last SAT solve().
+     */
+    bool modelValue(Var v) const { return model_[v] != 0; }
+
+    /**
+     * @brief Negated failed assumptions of the last UNSAT solve().
+     */
+    const std::vector<Lit>& finalConflict() const { return conflict_; }
+
+    /**
+     * @brief Check if the clauses are unsatisfiable without assumptions.
+     */
+    bool isInconsistent() const { return !ok_; }
+
+    /**
+     * @brief Check if a variable is assigned at the root (implied by the clauses).
+     */
+    bool isFixed(Var v) const { return values_[core::mkLit(v)] != 0; }
+
+    double getActivity(Var v) const { return activity_[v]; }
+
+    /**
+     * @brief Saved phase: the value the variable had when last unassigned.
+     */
+    bool getPhase(Var v) const { return phase_[v] == 0; }
+
+    const Stats& getStats() const { return stats_; }
+    std::size_t numClauses() const { return clauses_.size(); }
+    std::size_t numLearned() const { return learnts_.size(); }
+
+private:
+    using ClauseRef = std::uint32_t;
+    static constexpr ClauseRef kNoReason = 0xffffffffu;
+    static constexpr Lit kNoLit = 0xffffffffu;
+
+    // Clause at c: memory_[c] size, memory_[c + 1] flags (bit 0 learned,
+    // bit 1 deleted) | lbd << 2, memory_[c + 2] activity (float bits),
+    // with a proof the 64-bit clause id in memory_[c + 3 .. c + 4], then
+    // the literals. Literals 0 and 1 are watched; a reason clause has its
+    // implied literal first.
+    std::uint32_t header_ = 3;
+    std::vector<std::uint32_t> memory_;
+    std::vector<ClauseRef> clauses_;
+    std::vector<ClauseRef> learnts_;
+
+    struct Watcher {
+        ClauseRef clause;
+        Lit blocker;  // some other literal of the clause
+    };
+    // watches_[p]: clauses watching ¬p, visited when p becomes true
+    std::vector<std::vector<Watcher>> watches_;
+
+    std::vector<std::int8_t> values_;  // per literal: 1 true, -1 false, 0 unassigned
+    std::vector<std::uint32_t> level_;
+    std::vector<ClauseRef> reason_;
+    std::vector<Lit> trail_;
+    std::vector<std::size_t> trailLim_;  // trail size at each decision
+    std::size_t qhead_ = 0;
+    bool ok_ = true;
+
+    // EVSIDS
+    std::vector<double> activity_;
+    double varInc_ = 1.0;
+    double clauseInc_ = 1.0;
+    std::vector<Var> heap_;
+    std::vector<std::int32_t> heapIndex_;  // -1 if not in the heap
+    std::vector<std::uint8_t> phase_;      // saved polarity (1 = negated)
+
+    // Conflict analysis
+    std::vector<std::uint8_t> seen_;
+    std::vector<Lit> learnt_;
+    std::vector<Lit> analyzeStack_;
+    std::vector<Lit> analyzeToClear_;
+    std::vector<std::uint64_t> levelStamp_;
+    std::uint64_t stamp_ = 0;
+
+    // Restarts and reduction
+    std::vector<std::uint32_t> lbdQueue_;
+    std::size_t lbdQueueHead_ = 0;
+    std::uint64_t lbdQueueSum_ = 0;
+    std::uint64_t lbdTotal_ = 0;
+    std::uint64_t nextReduce_ = 2000;
+    std::uint64_t reduceIncrement_ = 300;
+
+    std::vector<std::uint8_t> model_;
+    std::vector<Lit> conflict_;
+    Stats stats_;
+
+    // LRAT proof
+    LratWriter* proof_ = nullptr;
+    std::uint64_t lastId_ = 0;
+    std::vector<std::uint64_t> unitId_;     // clause id proving a root-level value
+    std::vector<std::uint32_t> trailIndex_;
+    std::vector<Var> implied_;              // variables whose reasons a derivation uses
+    std::vector<std::uint64_t> hints_;
+    std::vector<std::uint64_t> hintStamp_;
+    std::uint64_t hintStampNow_ = 0;
+
+    std::uint32_t decisionLevel() const { return static_cast<std::uint32_t>(trailLim_.size()); }
+    std::int8_t value(Lit p) const { return values_[p]; }
+    Lit* literals(ClauseRef c) { return reinterpret_cast<Lit*>(memory_.data() + c + header_); }
+    std::uint32_t clauseSize(ClauseRef c) const { return memory_[c]; }
+    bool isLearned(ClauseRef c) const { return (memory_[c + 1] & 1) != 0; }
+    std::uint32_t clauseLbd(ClauseRef c) const { return memory_[c + 1] >> 2; }
+    float clauseActivity(ClauseRef c) const;
+    void setClauseActivity(ClauseRef c, float activity);
+
+    std::uint64_t clauseId(ClauseRef c) const {
+        return memory_[c + 3] | static_cast<std::uint64_t>(memory_[c + 4]) << 32;
+    }
+
+    ClauseRef allocate(const std::vector<Lit>& lits, bool learned, std::uint32_t lbd,
+                       std::uint64_t id);
+    bool addInput(const Lit* lits, std::size_t count, std::uint64_t id);
+    void attach(ClauseRef c);
+    bool locked(ClauseRef c);
+
+    void assign(Lit p, ClauseRef reason);
+    ClauseRef propagate();
+    void cancelUntil(std::uint32_t level);
+    Lit pickBranchLit();
+
+    void analyze(ClauseRef conflict, std::uint32_t& backtrackLevel, std::uint32_t& lbd);
+    bool litRedundant(Lit p, std::uint32_t abstractLevels);
+    void analyzeFinal(Lit p);
+    std::uint32_t computeLbd(const Lit* lits, std::size_t count);
+
+    void proveUnit(Lit p, ClauseRef reason);
+    void proveEmpty(ClauseRef conflict);
+    void addUnitHints(ClauseRef c);
+    void collectHints(ClauseRef conflict);
+
+    void bumpVariable(Var v);
+    void bumpClause(ClauseRef c);
+    bool shouldRestart(std::uint32_t lbd);
+    void reduceLearned();
+    void compact();
+
+    void heapInsert(Var v);
+    Var heapPop();
+    void heapUp(std::size_t i);
+    void heapDown(std::size_t i);
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_CDCL_H
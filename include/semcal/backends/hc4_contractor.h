@@ -0,0 +1,191 @@
+#ifndef SEMCAL_BACKENDS_HC4_CONTRACTOR_H
+#define SEMCAL_BACKENDS_HC4_CONTRACTOR_H
+
+#include "semcal/core/formula.h"
+#include "semcal/core/model.h"
+#include "semcal/core/term_store.h"
+#include "semcal/domain/box_batch.h"
+#include "semcal/domain/interval_box.h"
+#include "semcal/util/fast_interval.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief HC4 interval contractor for conjunctions of real constraints.
+ *
+ * Each atom e₁ ⋈ e₂ (⋈ ∈ {<=, <, >=, >, =}, optionally negated) is
+ * compiled once into a tape for e₁ − e₂ ∈ R, with R derived from ⋈.
+ * Expressions may use +, -, *, / and numerals; shared subterms become
+ * shared tape nodes. HC4-revise evaluates the tape forward over the
+ * box, intersects the root with R, and projects the result back down
+ * to the variables. Strict inequalities are treated as non-strict,
+ * which is a sound over-approximation.
+ *
+ * Atoms outside this fragment are skipped. Contracting with a subset
+ * of the conjuncts is still sound, since [[F]] is contained in the
+ * models of each conjunct.
+ *
+ * Interval operations use util::FastInterval (outward rounding, SSE2).
+ */
+class Hc4Contractor {
+public:
+    /**
+     * @brief Outcome of contract().
+     */
+    struct Outcome {
+        bool empty = false;                          // box proven empty
+        std::vector<core::VariableId> contracted;    // variables whose bounds moved
+        std::size_t revisions = 0;                   // HC4-revise calls
+    };
+
+    /**
+     * @brief How contraction changed one interval.
+     */
+    enum class Change { None, Moved, Progress };
+
+    static constexpr std::size_t kNoVariable = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Classify the change of [lo0, hi0] into [lo1, hi1].
+     *
+     * Bounds are compared one by one, so tightening one side of a
+     * half-unbounded interval counts although its width stays infinite.
+     * A risen lower or fallen upper bound is a move. It is progress when
+     * a bound became finite, when a finite width shrank by more than
+     * minProgress, or when a half-unbounded interval's finite bound
+     * moved by more than minProgress of its magnitude (at least 1).
+     */
+    static Change compareBounds(double lo0, double hi0, double lo1, double hi1, double minProgress);
+
+    Hc4Contractor() = default;
+
+    /**
+     * @brief Compile all supported conjuncts of a formula.
+     */
+    explicit Hc4Contractor(const core::Formula& formula);
+
+    /**
+     * @brief Compile one atom (or a conjunction of atoms).
+     * @return false if (part of) the term was skipped
+     */
+    bool addConstraint(core::TermId term);
+
+    std::size_t numConstraints() const { return constraints_.size(); }
+    std::size_t numSkipped() const { return skipped_; }
+
+    /**
+     * @brief Variables occurring in the compiled constraints, by id.
+     */
+    const std::vector<core::VariableId>& getVariables() const { return variables_; }
+
+    /**
+     * @brief Position of a variable in getVariables(), or kNoVariable.
+     */
+    std::size_t variableIndex(core::VariableId variable) const;
+
+    /**
+     * @brief Variables occurring in one compiled constraint, by id.
+     */
+    const std::vector<core::VariableId>& getConstraintVariables(std::size_t constraint) const {
+        return constraints_[constraint].vars;
+    }
+
+    /**
+     * @brief Run HC4-revise of one constraint on a box.
+     * @return false if the box became empty
+     */
+    bool revise(std::size_t constraint, domain::IntervalBox& box);
+
+    /**
+     * @brief Enclose the partial derivatives of one constraint's
+     * lhs − rhs over a box (its row of the interval Jacobian).
+     *
+     * gradient[j] encloses ∂/∂x_j for x_j = getConstraintVariables(constraint)[j].
+     */
+    void derivatives(std::size_t constraint, const domain::IntervalBox& box,
+                     std::vector<util::FastInterval>& gradient);
+
+    /**
+     * @brief Revise all constraints in rounds until no variable makes
+     * progress (see compareBounds()), or the round limit is reached.
+     */
+    Outcome contract(domain::IntervalBox& box);
+
+    /**
+     * @brief Contract every box of a batch with the same fixpoint as
+     * contract().
+     *
+     * Boxes are processed BoxBatch::kBlock at a time: the tape is walked
+     * once per block, and each node runs across the block's lanes in
+     * SIMD registers. Rounds continue while any box of the block makes
+     * progress. status receives the BoxBatch flags of each box; emptied
+     * boxes are reset with markEmpty().
+     *
+     * @return Number of HC4-revise calls, counting one per block
+     */
+    std::size_t contractBatch(domain::BoxBatch& boxes, std::vector<std::uint8_t>& status);
+
+    /**
+     * @brief Set the round limit of contract() (default 32).
+     */
+    void setMaxRounds(std::size_t rounds) { maxRounds_ = rounds; }
+
+    /**
+     * @brief Set the relative reduction that counts as progress
+     * (default 0.01, see compareBounds()).
+     */
+    void setMinProgress(double ratio) { minProgress_ = ratio; }
+
+private:
+    enum class Op : std::uint8_t { Const, Var, Add, Sub, Neg, Mul, Div, Sqr };
+
+    struct Node {
+        util::FastInterval constant;  // Const only
+        Op op;
+        std::uint32_t a = 0;          // operands (node indices)
+        std::uint32_t b = 0;
+        core::VariableId var = 0;     // Var only
+        std::uint32_t local = 0;      // Var only: index of var in Constraint::vars
+    };
+
+    // Nodes are in topological order, the root last.
+    struct Constraint {
+        std::vector<Node> nodes;
+        util::FastInterval range;
+        std::vector<core::VariableId> vars;
+    };
+
+    std::vector<Constraint> constraints_;
+    std::vector<core::VariableId> variables_;
+    std::vector<util::FastInterval> values_;  // scratch, one per node
+    std::vector<util::FastInterval> adjoints_;
+    std::vector<std::size_t> slots_;          // scratch, box slot (or batch column) per constraint variable
+    std::vector<double> blockValues_;         // scratch, 2 * kBlock per node
+    std::vector<double> blockBounds_;         // scratch, 2 * kBlock per variable
+    std::size_t skipped_ = 0;
+    std::size_t maxRounds_ = 32;
+    double minProgress_ = 0.01;
+
+    // Resolve the box slot of each of the constraint's variables.
+    void bindSlots(const Constraint& constraint, const domain::IntervalBox& box);
+    // Requires bindSlots() for the same constraint and box.
+    void evaluate(const Constraint& constraint, const domain::IntervalBox& box);
+    // Returns the lanes of the block that became empty, as a bit mask.
+    // Requires a batch column for every variable of the constraint.
+    std::uint32_t reviseBlock(const Constraint& constraint, domain::BoxBatch& boxes, std::size_t base);
+
+    bool addAtom(core::TermId atom, bool negated);
+    bool compileRelation(const std::string& relation, core::TermId lhs, core::TermId rhs, bool negated);
+    bool compileExpr(core::TermId term, Constraint& constraint,
+                     std::unordered_map<core::TermId, std::uint32_t>& memo, std::uint32_t& out);
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_HC4_CONTRACTOR_H
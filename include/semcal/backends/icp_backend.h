@@ -4,8 +4,10 @@
 #include "backend_capability.h"
 #include "semcal/core/formula.h"
 #include "semcal/domain/abstract_domain.h"
+#include "semcal/domain/box_batch.h"
 #include "semcal/state/semantic_state.h"
 #include "semcal/util/result.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -25,13 +27,46 @@ struct IcpContractWitness {
     std::string toString() const;
 };
 
+/**
+ * @brief How ICP decomposition picks the variable to split.
+ */
+enum class SplitHeuristic {
+    ROUND_ROBIN,   // Cycle through the variables
+    LARGEST_WIDTH, // Widest interval first
+    MAX_SMEAR      // Largest |∂f/∂x| · width(x) over the constraints f
+};
+
+/**
+ * @brief Name of a heuristic ("round-robin", "largest-width", "max-smear").
+ */
+std::string splitHeuristicName(SplitHeuristic heuristic);
+
+/**
+ * @brief Parse a heuristic name as printed by splitHeuristicName().
+ * @return false if the name is unknown
+ */
+bool parseSplitHeuristic(const std::string& name, SplitHeuristic& heuristic);
+
 /**
  * @brief Witness for ICP decomposition (box splitting).
  */
 struct IcpDecompWitness {
     size_t numBoxes;
     std::string splitVar;
-    double splitPoint;
+    double splitPoint;                // first cut
+    std::vector<double> splitPoints;  // all numBoxes - 1 cuts, ascending
+    std::string heuristic;
+    std::string toString() const;
+};
+
+/**
+ * @brief Witness for batched ICP contraction.
+ */
+struct IcpBatchWitness {
+    size_t numBoxes = 0;
+    size_t numContracted = 0;
+    size_t numEmpty = 0;
+    std::string contractionMethod;
     std::string toString() const;
 };
 
@@ -72,6 +107,27 @@ public:
         const core::Formula& formula,
         const domain::AbstractElement& abstractElement) = 0;
 
+    /**
+     * @brief Contract a batch of boxes for the same formula.
+     *
+     * Each box of the batch is contracted in place with the guarantees
+     * of contract(). The value holds one BoxBatch status per box
+     * (kContracted, kEmpty); a kEmpty box satisfies [[F]] ∩ γ(box) = ∅.
+     *
+     * The default implementation calls contract() once per box.
+     * Backends that can share work across boxes should override it.
+     *
+     * @param formula The constraint F
+     * @param boxes The boxes, contracted in place
+     * @return Result with per-box status flags and witness
+     */
+    virtual util::OpResult<
+        std::vector<std::uint8_t>,
+        IcpBatchWitness
+    > contractBatch(
+        const core::Formula& formula,
+        domain::BoxBatch& boxes);
+
     /**
      * @brief Decompose by splitting boxes (Axiom D).
      * 
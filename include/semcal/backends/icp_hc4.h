@@ -0,0 +1,91 @@
+#ifndef SEMCAL_BACKENDS_ICP_HC4_H
+#define SEMCAL_BACKENDS_ICP_HC4_H
+
+#include "icp_backend.h"
+#include "icp_propagator.h"
+#include <memory>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief ICP backend based on the HC4 contractor over interval boxes.
+ *
+ * - contract: HC4 propagation to a fixpoint through IcpPropagator's
+ *   watch lists (TopElement is read as the full box)
+ * - contractBatch: HC4 rounds across blocks of boxes in SIMD lanes
+ * - decompose: split one variable of the formula into k equal pieces
+ *   (default 2), chosen by a SplitHeuristic (default LARGEST_WIDTH)
+ * - infeasible: UNSAT when contraction empties the box
+ *
+ * The propagator compiled for the last formula is kept, so repeated
+ * calls on the states of one search do not recompile it. Instances are
+ * not thread-safe; use one per worker.
+ */
+class Hc4IcpBackend : public IcpBackend {
+private:
+    core::TermId cachedTerm_ = core::kNullTerm;
+    std::unique_ptr<IcpPropagator> propagator_;
+    std::size_t maxRounds_ = 32;
+    double minProgress_ = 0.01;
+    SplitHeuristic heuristic_ = SplitHeuristic::LARGEST_WIDTH;
+    std::size_t splitWays_ = 2;
+    std::size_t nextSplit_ = 0;  // ROUND_ROBIN position
+
+    IcpPropagator& propagatorFor(const core::Formula& formula);
+
+    // Index into the contractor's variables, or their count if none can be split.
+    std::size_t chooseSplit(Hc4Contractor& contractor, const domain::IntervalBox& box);
+
+public:
+    util::OpResult<
+        std::unique_ptr<domain::AbstractElement>,
+        IcpContractWitness
+    > contract(
+        const core::Formula& formula,
+        const domain::AbstractElement& abstractElement) override;
+
+    util::OpResult<
+        std::vector<std::uint8_t>,
+        IcpBatchWitness
+    > contractBatch(
+        const core::Formula& formula,
+        domain::BoxBatch& boxes) override;
+
+    util::OpResult<
+        std::vector<std::unique_ptr<state::SemanticState>>,
+        IcpDecompWitness
+    > decompose(
+        const core::Formula& formula,
+        const domain::AbstractElement& abstractElement) override;
+
+    util::OpResult<void, std::monostate> infeasible(
+        const core::Formula& formula,
+        const domain::AbstractElement& abstractElement) override;
+
+    /**
+     * @brief Tune the contraction fixpoint: the round limit of batched
+     * contraction and the minimum improvement that counts as progress
+     * (see Hc4Contractor::compareBounds() and IcpPropagator).
+     */
+    void setMaxRounds(std::size_t rounds);
+    void setMinProgress(double ratio);
+
+    /**
+     * @brief Select the split variable heuristic used by decompose().
+     */
+    void setSplitHeuristic(SplitHeuristic heuristic) { heuristic_ = heuristic; }
+    SplitHeuristic getSplitHeuristic() const { return heuristic_; }
+
+    /**
+     * @brief Set the number of pieces per split (at least 2). Unbounded
+     * intervals are always bisected.
+     */
+    void setSplitWays(std::size_t ways) { splitWays_ = ways < 2 ? 2 : ways; }
+    std::size_t getSplitWays() const { return splitWays_; }
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_ICP_HC4_H
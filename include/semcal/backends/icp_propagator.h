@@ -0,0 +1,79 @@
+#ifndef SEMCAL_BACKENDS_ICP_PROPAGATOR_H
+#define SEMCAL_BACKENDS_ICP_PROPAGATOR_H
+
+#include "hc4_contractor.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief AC3-style propagation of the atomic constraints of a formula.
+ *
+ * The formula is split into its atomic constraints (one Hc4Contractor
+ * tape each), and every variable keeps a watch list of the constraints
+ * it occurs in. A worklist holds the constraints to revise; after a
+ * revision narrows a variable by more than the minimum improvement
+ * (see Hc4Contractor::compareBounds()), the other constraints watching
+ * that variable are queued again. The fixpoint is reached when the
+ * worklist is empty; the revision cap is only a backstop.
+ *
+ * Compared to Hc4Contractor::contract(), which revises every constraint
+ * in each round, only constraints whose inputs moved are revisited, and
+ * propagate(box, changed) starts from the constraints of the changed
+ * variables alone (e.g. after a box split).
+ */
+class IcpPropagator {
+public:
+    explicit IcpPropagator(const core::Formula& formula);
+
+    /**
+     * @brief Propagate all constraints to a fixpoint.
+     */
+    Hc4Contractor::Outcome propagate(domain::IntervalBox& box);
+
+    /**
+     * @brief Propagate starting from the constraints watching the given
+     * variables; the box must already be a fixpoint for the others.
+     */
+    Hc4Contractor::Outcome propagate(domain::IntervalBox& box, const std::vector<core::VariableId>& changed);
+
+    /**
+     * @brief Set the relative improvement of a bound that wakes up
+     * watchers (default 0.01). Bounds becoming finite always count.
+     */
+    void setMinImprovement(double ratio) { minImprovement_ = ratio; }
+
+    /**
+     * @brief Cap the revisions of one propagate() call (default 0:
+     * 32 per constraint).
+     */
+    void setMaxRevisions(std::size_t revisions) { maxRevisions_ = revisions; }
+
+    const Hc4Contractor& getContractor() const { return contractor_; }
+    Hc4Contractor& getContractor() { return contractor_; }
+
+    /**
+     * @brief Constraints watching a variable.
+     */
+    const std::vector<std::uint32_t>& getWatchers(core::VariableId variable) const;
+
+private:
+    Hc4Contractor contractor_;
+    std::vector<std::vector<std::uint32_t>> watches_;  // by Hc4Contractor::variableIndex()
+    std::deque<std::uint32_t> queue_;
+    std::vector<bool> queued_;                         // by constraint
+    std::vector<double> bounds_;                       // scratch, lower/upper pairs
+    double minImprovement_ = 0.01;
+    std::size_t maxRevisions_ = 0;
+
+    void enqueue(std::uint32_t constraint);
+    Hc4Contractor::Outcome run(domain::IntervalBox& box);
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_ICP_PROPAGATOR_H
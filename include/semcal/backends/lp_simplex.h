@@ -0,0 +1,129 @@
+#ifndef SEMCAL_BACKENDS_LP_SIMPLEX_H
+#define SEMCAL_BACKENDS_LP_SIMPLEX_H
+
+#include "lp_backend.h"
+#include "simplex.h"
+#include "semcal/core/linear_system.h"
+#include "semcal/core/model.h"
+#include "semcal/core/term_store.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief LP backend deciding the linear part of a state with an exact
+ * rational simplex.
+ *
+ * refute(σ) collects the linear constraints implied by σ = (F, a, μ):
+ * - the rows of F.getLinearSystem() ("row i")
+ * - the bounds of a when it is an IntervalBox ("box x")
+ * - the numeric assignments of μ ("model x")
+ * and checks their real relaxation with Simplex. Strict inequalities
+ * are relaxed to non-strict ones, and atoms that are not linear are
+ * dropped; both only weaken the system, so UNSAT stays sound.
+ *
+ * Arithmetic is exact: util::Rational stays on int64 numerators and
+ * denominators until a result overflows, and only then switches to
+ * big integers.
+ *
+ * On UNSAT the witness holds the Farkas multipliers, e.g.
+ *   (farkas (row 0 upper 1) (row 1 lower 1) (box x upper 2))
+ * where each entry scales the ≤-form of one bound of the named
+ * constraint.
+ *
+ * Simplex variable j is column j of the LinearSystem, so loading a
+ * formula copies its CSR rows straight into the tableau.
+ *
+ * Incremental use: the tableau built for a formula is kept together
+ * with a stack of push() levels, each holding the bounds asserted for
+ * one state. refute(σ) keeps the levels whose bounds σ still implies
+ * (those of its ancestors in the search tree), pops the others (those
+ * of a sibling's branch), and asserts in a new level only the bounds
+ * of σ that are tighter than the kept ones. The basis survives pop(),
+ * so the re-check starts from the last basis and only the bound deltas
+ * cost pivots. The same machinery is available directly:
+ *   load(F); push(); tightenUpper(x, 3); check(); pop();
+ */
+class LpSimplexBackend : public LpBackend {
+public:
+    util::OpResult<void, LpWitness>
+    refute(const state::SemanticState& σ) override;
+
+    /**
+     * @brief Give up with UNKNOWN after this many pivots (default 10000).
+     */
+    void setMaxPivots(std::size_t pivots) { maxPivots_ = pivots; }
+
+    /**
+     * @brief Keep the tableau across refute() calls on the same formula
+     * (default on). When off, every call rebuilds it from scratch.
+     */
+    void setIncremental(bool incremental) { incremental_ = incremental; }
+
+    /**
+     * @brief Build the tableau for the linear atoms of a formula; a no-op
+     * (open levels included) if it is already loaded.
+     * @return false if the formula has no linear atoms
+     */
+    bool load(const core::Formula& formula);
+
+    /**
+     * @brief Open/close a level of bound changes (requires a successful load()).
+     */
+    void push();
+    void pop();
+
+    /**
+     * @brief Assert a bound change on a variable of the loaded formula
+     * in the current level. Certificates name it "box x", so they check
+     * against states whose box implies the bound (e.g. a branch on x).
+     * @return false if the variable occurs in no linear atom
+     */
+    bool tightenLower(core::VariableId variable, const util::Rational& value);
+    bool tightenUpper(core::VariableId variable, const util::Rational& value);
+
+    /**
+     * @brief Check the loaded rows under the current bounds.
+     */
+    util::OpResult<void, LpWitness> check();
+
+    /**
+     * @brief Total pivots performed (warm starts keep this low).
+     */
+    std::size_t getPivotCount() const { return simplex_ ? pivotsBefore_ + simplex_->getPivotCount() : pivotsBefore_; }
+
+private:
+    std::size_t maxPivots_ = 10000;
+    bool incremental_ = true;
+
+    // A bound asserted in a level, labelled "model x" or "box x"
+    struct Assertion {
+        core::LinearSystem::Column column;
+        bool upper;
+        bool model;
+        util::Rational value;
+    };
+    struct Level {
+        std::size_t labels;  // labels_.size() at push()
+        std::vector<Assertion> bounds;
+    };
+
+    std::unique_ptr<Simplex> simplex_;
+    core::TermId loadedTerm_ = core::kNullTerm;
+    std::shared_ptr<const core::LinearSystem> system_;  // rows of the loaded formula
+    std::vector<std::string> labels_;        // certificate label of each reason
+    std::vector<Level> levels_;
+    std::size_t pivotsBefore_ = 0;           // pivots of discarded tableaux
+
+    void reset();
+    bool implies(const state::SemanticState& σ, const Level& level) const;
+    void assertBound(core::LinearSystem::Column column, const util::Rational& value, bool upper, bool model);
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_LP_SIMPLEX_H
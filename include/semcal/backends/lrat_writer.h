@@ -0,0 +1,91 @@
+#ifndef SEMCAL_BACKENDS_LRAT_WRITER_H
+#define SEMCAL_BACKENDS_LRAT_WRITER_H
+
+#include "semcal/core/clause_arena.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief Writer for clausal proofs in binary LRAT.
+ *
+ * Each step is a byte 'a' (addition) or 'd' (deletion) followed by
+ * numbers in 7-bit little-endian varints; a number x is written as
+ * 2|x| + (x < 0), so literal ±v (DIMACS) is 2v + sign and 0 ends a list:
+ *   a <id> <literals> 0 <hints> 0
+ *   d <ids> 0
+ * The hints of an addition are the ids of earlier clauses that become
+ * unit, in order, and then falsified once the new clause is assumed
+ * false (reverse unit propagation). Clauses of the input have ids
+ * 1 .. m in input order.
+ *
+ * Steps are encoded into a buffer that is handed to the sink every
+ * chunkSize bytes, so a proof of any size is written with a bounded
+ * amount of memory. Without a sink the whole proof stays in the buffer.
+ */
+class LratWriter {
+public:
+    using Sink = std::function<void(const std::uint8_t* data, std::size_t size)>;
+
+    LratWriter() = default;
+    explicit LratWriter(Sink sink, std::size_t chunkSize = 1 << 20)
+        : sink_(std::move(sink)), chunkSize_(chunkSize) {}
+    ~LratWriter() { flush(); }
+
+    LratWriter(const LratWriter&) = delete;
+    LratWriter& operator=(const LratWriter&) = delete;
+
+    /**
+     * @brief Add a clause derived by reverse unit propagation over hints.
+     */
+    void add(std::uint64_t id, const core::Lit* lits, std::size_t count,
+             const std::uint64_t* hints, std::size_t numHints);
+    void add(std::uint64_t id, const std::vector<core::Lit>& lits,
+             const std::vector<std::uint64_t>& hints) {
+        add(id, lits.data(), lits.size(), hints.data(), hints.size());
+    }
+
+    /**
+     * @brief Delete clauses no longer needed by later steps.
+     */
+    void remove(const std::uint64_t* ids, std::size_t count);
+    void remove(const std::vector<std::uint64_t>& ids) { remove(ids.data(), ids.size()); }
+
+    /**
+     * @brief Hand the buffered bytes to the sink (a no-op without one).
+     */
+    void flush();
+
+    /**
+     * @brief Bytes not yet flushed (the whole proof without a sink).
+     */
+    const std::vector<std::uint8_t>& getBuffer() const { return buffer_; }
+
+    std::uint64_t getBytes() const { return flushed_ + buffer_.size(); }
+    std::uint64_t getSteps() const { return steps_; }
+
+private:
+    Sink sink_;
+    std::size_t chunkSize_ = 0;
+    std::vector<std::uint8_t> buffer_;
+    std::uint64_t flushed_ = 0;
+    std::uint64_t steps_ = 0;
+
+    void put(std::uint64_t x) {
+        while (x >= 0x80) {
+            buffer_.push_back(static_cast<std::uint8_t>(x | 0x80));
+            x >>= 7;
+        }
+        buffer_.push_back(static_cast<std::uint8_t>(x));
+    }
+    void endStep();
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_LRAT_WRITER_H
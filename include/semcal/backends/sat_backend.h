@@ -0,0 +1,114 @@
+#ifndef SEMCAL_BACKENDS_SAT_BACKEND_H
+#define SEMCAL_BACKENDS_SAT_BACKEND_H
+
+#include "backend_capability.h"
+#include "semcal/core/formula.h"
+#include "semcal/core/model.h"
+#include "semcal/state/semantic_state.h"
+#include "semcal/util/op_result.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief Witness for SAT decomposition (case split on one variable).
+ */
+struct SatDecompWitness {
+    std::string splitVar;
+    bool firstValue = false;  // value assigned in the first state
+    double activity = 0.0;    // branching score of splitVar
+    std::string toString() const;
+};
+
+/**
+ * @brief Witness for SAT refutation.
+ *
+ * failedAssumptions lists the partial-model assignments the conflict
+ * depends on; it is empty if the formula alone is unsatisfiable.
+ * proofFile names a binary LRAT proof whose last step derives the
+ * clause refuting them (empty if no proof was requested).
+ */
+struct SatUnsatWitness {
+    std::vector<std::string> failedAssumptions;
+    std::uint64_t conflicts = 0;
+    std::string proofFile;
+    std::string toString() const;
+};
+
+/**
+ * @brief Witness for SAT refinement (the learned clause).
+ */
+struct SatRefineWitness {
+    std::string clause;
+    std::uint64_t conflicts = 0;
+    std::string toString() const;
+};
+
+/**
+ * @brief SAT backend capability interface.
+ *
+ * SAT provides, over the Boolean variables of a propositional formula
+ * (the partial model μ of a state fixes some of them):
+ * - Decompose: case split on an unassigned variable
+ * - Infeasible: conflict detection (UNSAT)
+ * - Refine: a learned clause excluding a spurious model
+ */
+class SatBackend : public BackendCapability {
+public:
+    virtual ~SatBackend() = default;
+
+    // BackendCapability interface
+    std::string getName() const override { return "SAT"; }
+    bool supportsOperator(const std::string& opName) const override;
+    ApproxDirection getApproxDirection(const std::string& opName) const override;
+
+    /**
+     * @brief Split on a variable (Axiom D).
+     *
+     * Returns σ[x := b] and σ[x := ¬b] for a variable x of F unassigned
+     * in μ, which together cover Conc(σ).
+     *
+     * @param σ The semantic state
+     * @return Result with the two states, or σ alone with progress
+     *         false if every variable is assigned
+     */
+    virtual util::OpResult<
+        std::vector<std::unique_ptr<state::SemanticState>>,
+        SatDecompWitness
+    > decompose(const state::SemanticState& σ) = 0;
+
+    /**
+     * @brief Refute a state (Axiom I).
+     *
+     * If refute(σ) returns UNSAT, no assignment extending μ satisfies F.
+     *
+     * @param σ The semantic state
+     * @return Result with UNSAT if refuted, OK if a model exists, UNKNOWN otherwise
+     */
+    virtual util::OpResult<void, SatUnsatWitness> refute(const state::SemanticState& σ) = 0;
+
+    /**
+     * @brief Learn a clause excluding a spurious model (Axiom C).
+     *
+     * Returns a clause R over the Boolean variables of F such that
+     * F ⇒ R and M ⊭ R, when the Boolean part of M contradicts F.
+     *
+     * @param originalFormula The formula F
+     * @param relaxedFormula The relaxation F^α that M satisfies
+     * @param spuriousModel The model M
+     * @return Result with R, UNKNOWN if M's Boolean part is consistent with F
+     */
+    virtual util::OpResult<std::unique_ptr<core::Formula>, SatRefineWitness> refine(
+        const core::Formula& originalFormula,
+        const core::Formula& relaxedFormula,
+        const core::Model& spuriousModel) = 0;
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_SAT_BACKEND_H
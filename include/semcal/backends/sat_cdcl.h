@@ -0,0 +1,97 @@
+#ifndef SEMCAL_BACKENDS_SAT_CDCL_H
+#define SEMCAL_BACKENDS_SAT_CDCL_H
+
+#include "cdcl.h"
+#include "lrat_writer.h"
+#include "sat_backend.h"
+#include "semcal/core/cnf_encoder.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief SAT backend on the native CdclSolver.
+ *
+ * Formulas are loaded through core::CnfEncoder: a core::CnfFormula
+ * (its clauses are loaded directly, variable v is named "x<v+1>") or
+ * the Tseitin encoding of any other formula's Boolean skeleton, with
+ * theory atoms abstracted; a satisfiable abstraction then gives UNKNOWN
+ * rather than SAT. The Boolean assignments of the partial model μ become solver
+ * assumptions, so all states of one search share the loaded clauses and
+ * everything learned so far.
+ *
+ * - decompose: split on the unassigned formula variable with the
+ *   highest VSIDS activity, saved phase first
+ * - refute: solve under μ; UNSAT lists the failed assumptions
+ * - refine: solve under the Boolean values of M; on UNSAT the learned
+ *   clause over the failed assumptions is implied by F and falsified by M
+ *
+ * With setProofFile(), the solver streams a binary LRAT proof of the
+ * loaded formula to that file, and refutations name it in their
+ * witness; the kernel checks it as evidence of type "lrat-file".
+ *
+ * Instances are not thread-safe; use one per worker.
+ */
+class CdclSatBackend : public SatBackend {
+private:
+    std::unique_ptr<CdclSolver> solver_;
+    core::CnfEncoder encoder_;  // solver variable v is encoder variable v
+    core::TermId loadedTerm_ = core::kNullTerm;
+    std::shared_ptr<const core::ClauseArena> loadedArena_;
+    std::uint64_t maxConflicts_ = 0;
+
+    std::string proofFile_;
+    std::unique_ptr<std::ofstream> proofStream_;
+    std::unique_ptr<LratWriter> proof_;  // writes to proofStream_
+
+    void load(const core::Formula& formula);
+    void startProof();
+    std::string literalName(core::Lit lit) const;
+
+public:
+    CdclSatBackend();
+
+    util::OpResult<
+        std::vector<std::unique_ptr<state::SemanticState>>,
+        SatDecompWitness
+    > decompose(const state::SemanticState& σ) override;
+
+    util::OpResult<void, SatUnsatWitness> refute(const state::SemanticState& σ) override;
+
+    util::OpResult<std::unique_ptr<core::Formula>, SatRefineWitness> refine(
+        const core::Formula& originalFormula,
+        const core::Formula& relaxedFormula,
+        const core::Model& spuriousModel) override;
+
+    /**
+     * @brief Give up with UNKNOWN after this many conflicts per call (0 = no limit).
+     */
+    void setMaxConflicts(std::uint64_t conflicts) { maxConflicts_ = conflicts; }
+
+    /**
+     * @brief Stream LRAT proofs to a file (empty = no proof, the default).
+     *
+     * The file is rewritten whenever a new formula is loaded and holds
+     * the proof of everything derived for it since.
+     */
+    void setProofFile(std::string path);
+
+    /**
+     * @brief The solver of the loaded formula (statistics, model of the last SAT refute()).
+     */
+    const CdclSolver& getSolver() const { return *solver_; }
+
+    /**
+     * @brief The variable of the partial model behind a solver variable.
+     */
+    core::VariableId getVariable(core::Var var) const { return encoder_.variable(var); }
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_SAT_CDCL_H
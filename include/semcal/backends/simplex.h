@@ -0,0 +1,149 @@
+#ifndef SEMCAL_BACKENDS_SIMPLEX_H
+#define SEMCAL_BACKENDS_SIMPLEX_H
+
+#include "semcal/util/rational.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace semcal {
+namespace backends {
+
+/**
+ * @brief Bounded simplex over exact rationals (Dutertre & de Moura).
+ *
+ * Every row introduces a slack variable s = Σ aᵢxᵢ, and constraints are
+ * bounds l ≤ v ≤ u on structural and slack variables alike. check()
+ * is the primal repair loop of Dutertre & de Moura: a basic variable
+ * out of bounds is pivoted with a nonbasic variable that has slack in
+ * the right direction, and Bland's rule (smallest index first)
+ * guarantees termination.
+ *
+ * The tableau is sparse: a row keeps only its nonzero coefficients,
+ * and every nonbasic variable lists the rows it occurs in, so a pivot
+ * touches only the rows of the entering variable.
+ *
+ * Bounds can be tightened under push()/pop() levels, which reuses the
+ * tableau: a re-check after a few bound changes starts from the last
+ * feasible basis and usually needs only a handful of pivots.
+ *
+ * Each bound carries a caller-chosen reason. When check() finds the
+ * bounds infeasible, conflict() lists the bounds of one tableau row
+ * with nonnegative Farkas multipliers: writing each bound in ≤-form
+ * (v ≤ u, −v ≤ −l) and summing with its multiplier yields 0 ≤ c, c < 0.
+ */
+class Simplex {
+public:
+    using Var = std::uint32_t;
+
+    enum class Result { SAT, UNSAT, UNKNOWN };
+
+    struct FarkasTerm {
+        std::uint32_t reason;
+        bool upper;                  // u bound (v ≤ u) or l bound (−v ≤ −l)
+        util::Rational multiplier;   // > 0
+    };
+
+    /**
+     * @brief Add an unbounded structural variable (value 0).
+     */
+    Var addVariable();
+
+    /**
+     * @brief Add a row s = Σ coeff·var over existing variables.
+     * @return The slack variable s (unbounded until bounds are set)
+     */
+    Var addRow(const std::vector<std::pair<Var, util::Rational>>& coeffs);
+
+    /**
+     * @brief Tighten a bound; looser bounds than the current one are ignored.
+     */
+    void setLower(Var v, const util::Rational& value, std::uint32_t reason);
+    void setUpper(Var v, const util::Rational& value, std::uint32_t reason);
+
+    /**
+     * @brief The current bounds of a variable (nullptr if unbounded).
+     */
+    const util::Rational* getLower(Var v) const { return vars_[v].lower.present ? &vars_[v].lower.value : nullptr; }
+    const util::Rational* getUpper(Var v) const { return vars_[v].upper.present ? &vars_[v].upper.value : nullptr; }
+
+    /**
+     * @brief Open a backtracking level; pop() restores the bounds of the
+     * moment push() was called.
+     *
+     * The basis and the assignment are kept across pop() (looser bounds
+     * keep nonbasic values in range), so the next check() starts from the
+     * last basis instead of the slack basis.
+     */
+    void push();
+    void pop();
+    std::size_t getLevel() const { return levels_.size(); }
+
+    /**
+     * @brief Look for an assignment satisfying all bounds.
+     * @return UNKNOWN if the pivot limit was reached
+     */
+    Result check(std::size_t maxPivots = 10000);
+
+    /**
+     * @brief Farkas terms of the last UNSAT check().
+     */
+    const std::vector<FarkasTerm>& conflict() const { return conflict_; }
+
+    const util::Rational& value(Var v) const { return vars_[v].value; }
+    std::size_t numVariables() const { return vars_.size(); }
+    std::size_t numRows() const { return rows_.size(); }
+    std::size_t getPivotCount() const { return pivots_; }
+
+private:
+    struct Bound {
+        bool present = false;
+        util::Rational value;
+        std::uint32_t reason = 0;
+    };
+
+    struct VarInfo {
+        Bound lower;
+        Bound upper;
+        util::Rational value;
+        std::int32_t row = -1;  // row where the variable is basic, or -1
+    };
+
+    struct Entry {
+        Var var;
+        util::Rational coeff;  // nonzero
+    };
+    using Row = std::vector<Entry>;  // sorted by var
+
+    // Row r: basic_[r] = Σ coeff·var over the entries of rows_[r] (all
+    // nonbasic); columns_[v] lists the rows with an entry for v.
+    std::vector<VarInfo> vars_;
+    std::vector<Row> rows_;
+    std::vector<std::vector<std::uint32_t>> columns_;
+    std::vector<Var> basic_;
+    Row scratch_;
+    std::vector<FarkasTerm> conflict_;
+    std::size_t pivots_ = 0;
+
+    struct TrailEntry {
+        Var var;
+        bool upper;
+        Bound previous;
+    };
+    std::vector<TrailEntry> trail_;
+    std::vector<std::size_t> levels_;  // trail size at each push()
+
+    const util::Rational& coefficient(std::size_t row, Var v) const;
+    void unlink(std::size_t row, Var v);
+    void updateNonbasic(Var v, const util::Rational& value);
+    void pivotAndUpdate(std::size_t row, Var entering, const util::Rational& value);
+    void pivot(std::size_t row, Var entering);
+    bool boundsConflict(Var v);
+    void explainRow(std::size_t row, bool belowLower);
+};
+
+} // namespace backends
+} // namespace semcal
+
+#endif // SEMCAL_BACKENDS_SIMPLEX_H
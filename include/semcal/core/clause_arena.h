@@ -0,0 +1,137 @@
+#ifndef SEMCAL_CORE_CLAUSE_ARENA_H
+#define SEMCAL_CORE_CLAUSE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief Propositional literal: (variable << 1) | negated.
+ *
+ * Variables are 0-based; DIMACS variable v is variable v - 1.
+ */
+using Lit = std::uint32_t;
+using Var = std::uint32_t;
+
+inline Lit mkLit(Var var, bool negated = false) { return (var << 1) | static_cast<Lit>(negated); }
+inline Var litVar(Lit lit) { return lit >> 1; }
+inline bool litNegated(Lit lit) { return (lit & 1) != 0; }
+inline Lit litNegate(Lit lit) { return lit ^ 1; }
+
+/**
+ * @brief Convert a DIMACS literal (non-zero signed integer) to a Lit.
+ */
+inline Lit litFromDimacs(std::int64_t lit) {
+    return lit < 0 ? mkLit(static_cast<Var>(-lit - 1), true) : mkLit(static_cast<Var>(lit - 1));
+}
+
+inline std::int64_t litToDimacs(Lit lit) {
+    std::int64_t v = static_cast<std::int64_t>(litVar(lit)) + 1;
+    return litNegated(lit) ? -v : v;
+}
+
+/**
+ * @brief View of one clause in a ClauseArena.
+ */
+struct ClauseView {
+    const Lit* data = nullptr;
+    std::uint32_t count = 0;
+
+    const Lit* begin() const { return data; }
+    const Lit* end() const { return data + count; }
+    std::uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Lit operator[](std::size_t i) const { return data[i]; }
+};
+
+/**
+ * @brief Flat storage of a clause set.
+ *
+ * All literals live in one contiguous array; clause i spans
+ * [offsets[i], offsets[i+1]). Adding a clause appends to the two
+ * arrays, so no allocation happens per clause.
+ */
+class ClauseArena {
+private:
+    std::vector<Lit> literals_;
+    std::vector<std::size_t> offsets_{0};
+    std::uint32_t numVars_ = 0;
+
+public:
+    ClauseArena() = default;
+
+    /**
+     * @brief Reserve room for clauses and literals.
+     */
+    void reserve(std::size_t clauses, std::size_t literals) {
+        offsets_.reserve(clauses + 1);
+        literals_.reserve(literals);
+    }
+
+    /**
+     * @brief Append a literal to the clause under construction.
+     */
+    void addLiteral(Lit lit) {
+        literals_.push_back(lit);
+        if (litVar(lit) >= numVars_) {
+            numVars_ = litVar(lit) + 1;
+        }
+    }
+
+    /**
+     * @brief Close the clause under construction.
+     * @return Index of the new clause
+     */
+    std::size_t endClause() {
+        offsets_.push_back(literals_.size());
+        return offsets_.size() - 2;
+    }
+
+    /**
+     * @brief Check if literals were added since the last endClause().
+     */
+    bool hasOpenClause() const { return literals_.size() != offsets_.back(); }
+
+    /**
+     * @brief Append a whole clause.
+     * @return Index of the new clause
+     */
+    std::size_t addClause(const Lit* lits, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            addLiteral(lits[i]);
+        }
+        return endClause();
+    }
+
+    std::size_t addClause(const std::vector<Lit>& lits) { return addClause(lits.data(), lits.size()); }
+
+    /**
+     * @brief Declare at least the given number of variables
+     * (e.g. from a DIMACS header, for variables without occurrences).
+     */
+    void ensureVars(std::uint32_t count) {
+        if (count > numVars_) {
+            numVars_ = count;
+        }
+    }
+
+    ClauseView clause(std::size_t i) const {
+        return ClauseView{literals_.data() + offsets_[i],
+                          static_cast<std::uint32_t>(offsets_[i + 1] - offsets_[i])};
+    }
+
+    std::size_t numClauses() const { return offsets_.size() - 1; }
+    std::size_t numLiterals() const { return offsets_.back(); }
+    std::uint32_t numVars() const { return numVars_; }
+
+    const std::vector<Lit>& literals() const { return literals_; }
+    const std::vector<std::size_t>& offsets() const { return offsets_; }
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_CLAUSE_ARENA_H
@@ -0,0 +1,166 @@
+#ifndef SEMCAL_CORE_CNF_ENCODER_H
+#define SEMCAL_CORE_CNF_ENCODER_H
+
+#include "clause_arena.h"
+#include "formula.h"
+#include "model.h"
+#include "term_store.h"
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief CNF of the Boolean skeleton of a formula.
+ *
+ * - a CnfFormula is taken as is: its arena is shared, and variable v is
+ *   the one named "x<v+1>"
+ * - any other formula is encoded from its term. Each top-level conjunct
+ *   that is a disjunction of literals becomes one clause (true literals
+ *   drop the clause, false ones are dropped), so clausal terms map
+ *   clause for clause. Other subformulas get a Tseitin variable.
+ *
+ * Tseitin encoding is polarity-aware (Plaisted–Greenbaum): a subformula
+ * that only occurs positively gets the clauses g → def, one that only
+ * occurs negatively gets def → g, and the other half is added only if
+ * the subformula later turns up with the other polarity. Variables are
+ * keyed by TermId, and the TermStore hash-conses terms, so a shared
+ * subterm is encoded once however often it occurs: the walk visits each
+ * DAG node at most once per polarity.
+ *
+ * Connectives: not, and, or, => (right-associative), xor, ite, and =
+ * or distinct over Booleans. An = or distinct is over Booleans when an
+ * argument is visibly Boolean, or when its arguments are variables (or
+ * ites of variables) none of which is declared non-Boolean, is a
+ * numeral, or is compared with or used as an operand of a theory term.
+ * Anything else in a Boolean position is an atom: Boolean variables
+ * keep their VariableId, while theory atoms such as (<= x 3) become
+ * opaque variables (see atomTerm()), and the formula is then not
+ * propositional. Tseitin and theory atom variables are named
+ * "@cnf<term id>".
+ *
+ * The CNF is satisfiable whenever the formula is, so UNSAT transfers to
+ * the formula; SAT does too if isPropositional(). Encoding is
+ * deterministic, so a SAT backend and a proof checker that encode the
+ * same formula agree on clause and variable numbers.
+ */
+class CnfEncoder {
+public:
+    /**
+     * @brief Encode a formula, replacing any previous encoding.
+     */
+    void encode(const Formula& formula);
+
+    /**
+     * @brief Declare whether a variable is Boolean (e.g. from the
+     * declare-fun of a script); undeclared variables are classified
+     * by their use in the formula.
+     */
+    void declare(VariableId variable, bool boolean) { declared_[variable] = boolean; }
+    void clearDeclarations() { declared_.clear(); }
+
+    const ClauseArena& getClauses() const { return *arena_; }
+    std::shared_ptr<const ClauseArena> getArena() const { return arena_; }
+
+    /**
+     * @brief Check that no theory atom was abstracted.
+     */
+    bool isPropositional() const { return propositional_; }
+
+    std::uint32_t numVariables() const { return static_cast<std::uint32_t>(variables_.size()); }
+    VariableId variable(Var var) const { return variables_[var]; }
+
+    /**
+     * @brief Check that a clause variable is a Boolean variable of the
+     * formula, not a Tseitin variable or an abstracted theory atom.
+     */
+    bool isInput(Var var) const { return inputs_[var]; }
+
+    /**
+     * @brief The theory atom a clause variable abstracts.
+     * @return The atom, or kNullTerm for Boolean and Tseitin variables
+     */
+    TermId atomTerm(Var var) const { return atoms_[var]; }
+
+    /**
+     * @brief Find the clause variable of a model variable.
+     * @return false if the variable does not occur in the formula
+     */
+    bool lookup(VariableId variable, Var& var) const {
+        auto it = index_.find(variable);
+        if (it == index_.end()) {
+            return false;
+        }
+        var = it->second;
+        return true;
+    }
+
+    /**
+     * @brief The literals fixed by the Boolean values of a model
+     * (ConcreteModel or PartialModel) on variables of the formula.
+     */
+    template <class Assignments>
+    std::vector<Lit> literalsOf(const Assignments& assignments) const {
+        std::vector<Lit> lits;
+        assignments.forEach([&](VariableId variable, const Value& value) {
+            Var var;
+            if (value.isBool() && lookup(variable, var)) {
+                lits.push_back(mkLit(var, !value.asBool()));
+            }
+        });
+        return lits;
+    }
+
+private:
+    static constexpr std::uint8_t kPositive = 1;
+    static constexpr std::uint8_t kNegative = 2;
+    static constexpr std::uint8_t kBoth = 3;
+
+    struct Node {
+        Var var;
+        std::uint8_t polarities;  // definition clauses emitted so far
+    };
+    struct Frame {
+        TermId term;
+        std::uint8_t polarities;  // still to emit
+        std::uint32_t next;       // next argument to visit
+    };
+
+    std::shared_ptr<const ClauseArena> arena_ = std::make_shared<ClauseArena>();
+    std::vector<VariableId> variables_;  // clause variable -> VariableId
+    std::vector<bool> inputs_;           // clause variable -> isInput()
+    std::vector<TermId> atoms_;          // clause variable -> atomTerm()
+    std::unordered_map<VariableId, Var> index_;
+    bool propositional_ = true;
+    std::unordered_map<VariableId, bool> declared_;
+
+    // Term encoding state
+    ClauseArena* out_ = nullptr;
+    std::unordered_map<TermId, Node> nodes_;     // gates and atoms
+    std::unordered_map<TermId, TermId> rewrites_;  // n-ary xor/=, distinct
+    std::unordered_set<TermId> booleans_;          // = and distinct over Booleans
+    std::vector<Frame> stack_;
+    std::vector<Lit> clause_;
+
+    Var intern(VariableId variable, bool input);
+    void classify(TermId root);
+    void encodeTerm(TermId term);
+    TermId strip(TermId term, bool& negated, std::uint8_t& polarities);
+    bool isGate(TermId term) const;
+    Lit atom(TermId term);
+    Lit literal(TermId term, std::uint8_t polarities);
+    Lit childLiteral(TermId term);
+    std::uint8_t childPolarities(TermId gate, std::uint32_t index, std::uint8_t polarities) const;
+    void define(TermId gate, std::uint8_t polarities);
+    void emit(std::initializer_list<Lit> lits);
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_CNF_ENCODER_H
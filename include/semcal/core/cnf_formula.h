@@ -0,0 +1,54 @@
+#ifndef SEMCAL_CORE_CNF_FORMULA_H
+#define SEMCAL_CORE_CNF_FORMULA_H
+
+#include "clause_arena.h"
+#include "formula.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief A propositional formula in conjunctive normal form.
+ *
+ * Clauses are held in a shared, immutable ClauseArena, so cloning is
+ * O(1) and Boolean backends can read the clauses directly. Variable v
+ * (0-based) is named "x<v+1>" when the formula is rendered as a term,
+ * matching the DIMACS numbering.
+ */
+class CnfFormula : public Formula {
+private:
+    std::shared_ptr<const ClauseArena> arena_;
+    mutable std::atomic<TermId> term_{kNullTerm};  // built on first use
+
+public:
+    explicit CnfFormula(std::shared_ptr<const ClauseArena> arena);
+    explicit CnfFormula(ClauseArena arena);
+    CnfFormula(const CnfFormula& other);
+
+    std::string toString() const override;
+    std::unique_ptr<Formula> clone() const override;
+    bool isEquivalent(const Formula& other) const override;
+
+    /**
+     * @brief Get the formula as an and-of-or term.
+     *
+     * Built in the global TermStore on first call and cached.
+     */
+    TermId getTerm() const override;
+
+    const ClauseArena& getClauses() const { return *arena_; }
+    std::shared_ptr<const ClauseArena> getArena() const { return arena_; }
+
+    /**
+     * @brief Get the name of a variable in term form.
+     */
+    static std::string variableName(Var var);
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_CNF_FORMULA_H
@@ -1,6 +1,9 @@
 #ifndef SEMCAL_CORE_FORMULA_H
 #define SEMCAL_CORE_FORMULA_H
 
+#include "term_store.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +11,8 @@
 namespace semcal {
 namespace core {
 
+class LinearSystem;
+
 /**
  * @brief Represents a constraint (formula) in the semantic calculus.
  * 
@@ -36,25 +41,86 @@ public:
      * @return true if formulas are logically equivalent
      */
     virtual bool isEquivalent(const Formula& other) const = 0;
+
+    /**
+     * @brief Get the structural hash of the formula.
+     *
+     * Formulas with the same normal form (and/or flattened and
+     * AC-sorted) have the same hash. The default implementation reads
+     * the hash precomputed on the root of getTerm().
+     *
+     * @return 64-bit structural hash
+     */
+    virtual std::uint64_t hash() const;
+
+    /**
+     * @brief Get the formula as a term of the global TermStore.
+     *
+     * The default implementation parses toString(); subclasses that
+     * already hold a term should return it directly.
+     *
+     * @return The root term of the formula
+     */
+    virtual TermId getTerm() const;
+
+    /**
+     * @brief Get the linear rows of the formula.
+     *
+     * Shorthand for LinearSystem::of(getTerm()): the system is cached
+     * per term, so every formula with the same root shares one.
+     *
+     * @return Never null (an empty system if there are no linear atoms)
+     */
+    std::shared_ptr<const LinearSystem> getLinearSystem() const;
 };
 
 /**
  * @brief A concrete formula implementation with SMT-LIB style syntax.
+ *
+ * Thin adapter over a hash-consed term of TermStore::global():
+ * cloning copies the root identifier and syntactic comparison is O(1).
  */
 class ConcreteFormula : public Formula {
 private:
-    std::string expression_;
+    TermId term_;
 
 public:
     explicit ConcreteFormula(const std::string& expression);
     explicit ConcreteFormula(const char* expression);
+    explicit ConcreteFormula(TermId term);
 
     std::string toString() const override;
     std::unique_ptr<Formula> clone() const override;
     bool isEquivalent(const Formula& other) const override;
+    TermId getTerm() const override { return term_; }
+
+    std::string getExpression() const { return toString(); }
+    void setExpression(const std::string& expression);
+};
 
-    const std::string& getExpression() const { return expression_; }
-    void setExpression(const std::string& expression) { expression_ = expression; }
+/**
+ * @brief Hash functor so formulas can key unordered containers.
+ */
+struct FormulaHash {
+    std::size_t operator()(const Formula& f) const { return static_cast<std::size_t>(f.hash()); }
+    std::size_t operator()(const Formula* f) const { return (*this)(*f); }
+    std::size_t operator()(const std::unique_ptr<Formula>& f) const { return (*this)(*f); }
+    std::size_t operator()(const std::shared_ptr<const Formula>& f) const { return (*this)(*f); }
+};
+
+/**
+ * @brief Equality functor matching FormulaHash (structural equivalence).
+ */
+struct FormulaEqual {
+    bool operator()(const Formula& a, const Formula& b) const { return a.isEquivalent(b); }
+    bool operator()(const Formula* a, const Formula* b) const { return (*this)(*a, *b); }
+    bool operator()(const std::unique_ptr<Formula>& a, const std::unique_ptr<Formula>& b) const {
+        return (*this)(*a, *b);
+    }
+    bool operator()(const std::shared_ptr<const Formula>& a,
+                    const std::shared_ptr<const Formula>& b) const {
+        return (*this)(*a, *b);
+    }
 };
 
 /**
@@ -0,0 +1,95 @@
+#ifndef SEMCAL_CORE_LINEAR_SYSTEM_H
+#define SEMCAL_CORE_LINEAR_SYSTEM_H
+
+#include "model.h"
+#include "term_store.h"
+#include "semcal/util/rational.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief The linear atoms of a formula as rows lᵣ ≤ Σ aᵣⱼxⱼ ≤ uᵣ in
+ * compressed sparse row form.
+ *
+ * Rows come from the top-level conjunction: and/not are walked down to
+ * the relations <=, <, >=, >, = (chains yield one row per adjacent
+ * pair), and a relation is kept if both sides are linear over +, -,
+ * * by constants, / by constants and to_real. Strict inequalities
+ * become non-strict and nonlinear atoms are dropped, so the rows are
+ * implied by the formula: a contradiction among them refutes it. Row
+ * order is left to right over the normalized term, which lets
+ * certificates refer to row i.
+ *
+ * Columns number the distinct variables in increasing VariableId order;
+ * the nonzeros of row r are at positions [rowBegin(r), rowEnd(r)) of
+ * the column/coefficient arrays, sorted by column.
+ *
+ * Extraction parses numerals once; LinearSystem::of() caches the result
+ * per hash-consed term, so LP backends and the kernel share it across
+ * states and across Formula objects with the same root.
+ */
+class LinearSystem {
+public:
+    using Column = std::uint32_t;
+
+    /**
+     * @brief Extract the linear rows of a term (no rows for kNullTerm).
+     */
+    explicit LinearSystem(TermId term);
+
+    /**
+     * @brief Get the shared system of a term of TermStore::global().
+     *
+     * Extracted on first use and kept for the life of the process, like
+     * the term itself. Thread-safe; a concurrent first call may extract
+     * twice, but all callers receive the same object.
+     */
+    static std::shared_ptr<const LinearSystem> of(TermId term);
+
+    TermId getTerm() const { return term_; }
+    std::size_t numRows() const { return rowStart_.size() - 1; }
+    std::size_t numColumns() const { return variables_.size(); }
+    std::size_t numNonzeros() const { return columns_.size(); }
+    bool empty() const { return numRows() == 0; }
+
+    std::size_t rowBegin(std::size_t row) const { return rowStart_[row]; }
+    std::size_t rowEnd(std::size_t row) const { return rowStart_[row + 1]; }
+    Column column(std::size_t k) const { return columns_[k]; }
+    const util::Rational& coefficient(std::size_t k) const { return values_[k]; }
+
+    bool hasLower(std::size_t row) const { return (sides_[row] & kLower) != 0; }
+    bool hasUpper(std::size_t row) const { return (sides_[row] & kUpper) != 0; }
+    const util::Rational& lower(std::size_t row) const { return lower_[row]; }
+    const util::Rational& upper(std::size_t row) const { return upper_[row]; }
+
+    VariableId variable(Column column) const { return variables_[column]; }
+
+    /**
+     * @brief Find the column of a variable.
+     * @return false if the variable occurs in no row
+     */
+    bool columnOf(VariableId variable, Column& column) const;
+
+private:
+    static constexpr std::uint8_t kLower = 1;
+    static constexpr std::uint8_t kUpper = 2;
+
+    TermId term_;
+    std::vector<std::uint32_t> rowStart_{0};  // numRows() + 1 offsets
+    std::vector<Column> columns_;
+    std::vector<util::Rational> values_;
+    std::vector<std::uint8_t> sides_;
+    std::vector<util::Rational> lower_;
+    std::vector<util::Rational> upper_;
+    std::vector<VariableId> variables_;       // sorted; index = column
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_LINEAR_SYSTEM_H
@@ -1,9 +1,13 @@
 #ifndef SEMCAL_CORE_MODEL_H
 #define SEMCAL_CORE_MODEL_H
 
+#include "term_store.h"
+#include "value.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace semcal {
 namespace core {
@@ -26,6 +30,17 @@ public:
      */
     virtual bool satisfies(const std::string& constraint) const = 0;
 
+    /**
+     * @brief Check if this model satisfies a constraint given as a term.
+     *
+     * The default implementation prints the term and calls the string
+     * overload; models that can evaluate terms directly override it.
+     *
+     * @param constraint Root term of the constraint
+     * @return true if the model satisfies the constraint
+     */
+    virtual bool satisfies(TermId constraint) const;
+
     /**
      * @brief Get a string representation of the model.
      * @return String representation
@@ -44,27 +59,113 @@ public:
      * @return true if models are equal
      */
     virtual bool equals(const Model& other) const = 0;
+
+    /**
+     * @brief Get a canonical hash of the model.
+     *
+     * Models that are equals() must hash equal. The default hashes
+     * toString(), which suits models whose printed form is canonical.
+     *
+     * @return 64-bit hash
+     */
+    virtual std::uint64_t hash() const;
 };
 
+/**
+ * @brief Identifier of a variable: its symbol in TermStore::global().
+ *
+ * Variables share the symbol table of formula terms, so a leaf term
+ * maps to its variable without any string lookup.
+ */
+using VariableId = SymbolId;
+
 /**
  * @brief A concrete model implementation with variable assignments.
+ *
+ * Assignments are kept in a vector sorted by VariableId: a lookup is a
+ * binary search, and setting variables in increasing id order appends.
+ * Symbol ids are global to the term store, so the storage grows with
+ * the number of assignments, not with the largest id.
+ *
+ * The string-based API is kept as a convenience layer: it interns the
+ * variable name and parses or prints the value (values are
+ * canonicalized, e.g. "1.50" reads back as "3/2").
  */
 class ConcreteModel : public Model {
 private:
-    std::unordered_map<std::string, std::string> assignments_;
+    // Assignments sorted by VariableId, so memory follows the model's
+    // size rather than the largest symbol id interned so far.
+    std::vector<std::pair<VariableId, Value>> entries_;
+    std::uint64_t hash_ = 0;  // XOR of per-assignment hashes
+
+    std::vector<std::pair<VariableId, Value>>::const_iterator find(VariableId variable) const;
 
 public:
     ConcreteModel() = default;
     explicit ConcreteModel(const std::unordered_map<std::string, std::string>& assignments);
 
+    /**
+     * @brief Get the identifier of a variable name (interned on demand).
+     */
+    static VariableId variable(std::string_view name);
+
+    void set(VariableId variable, Value value);
+    void unset(VariableId variable);
+
+    /**
+     * @brief Get the value of a variable (None if unassigned).
+     */
+    const Value& get(VariableId variable) const;
+    bool has(VariableId variable) const { return find(variable) != entries_.end(); }
+
+    /**
+     * @brief Get the number of assigned variables.
+     */
+    std::size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Call f(VariableId, const Value&) for each assignment, by id.
+     */
+    template <class F>
+    void forEach(F&& f) const {
+        for (const auto& [variable, value] : entries_) {
+            f(variable, value);
+        }
+    }
+
     void setAssignment(const std::string& variable, const std::string& value);
     std::string getAssignment(const std::string& variable) const;
     bool hasAssignment(const std::string& variable) const;
 
+    /**
+     * @brief Evaluate a term under this model.
+     *
+     * Supports Boolean connectives (not, and, or, xor, =>, ite), =,
+     * distinct, linear and non-linear arithmetic (+, -, *, /) and
+     * comparisons over exact numbers. Returns None when the value is
+     * not determined (unassigned variable, unsupported operator).
+     */
+    Value evaluate(TermId term) const;
+
+    /**
+     * @brief Check a constraint by evaluation.
+     *
+     * Only a constraint that evaluates to false is rejected; undetermined
+     * constraints are accepted, since they cannot be refuted here.
+     */
+    bool satisfies(TermId constraint) const override;
     bool satisfies(const std::string& constraint) const override;
     std::string toString() const override;
     std::unique_ptr<Model> clone() const override;
     bool equals(const Model& other) const override;
+
+    /**
+     * @brief Get the hash of the assignments, maintained by set() in O(1).
+     *
+     * Independent of assignment order, and equal to PartialModel::hash()
+     * of a partial model with the same assignments.
+     */
+    std::uint64_t hash() const override { return hash_; }
 };
 
 } // namespace core
@@ -0,0 +1,81 @@
+#ifndef SEMCAL_CORE_MODEL_SET_H
+#define SEMCAL_CORE_MODEL_SET_H
+
+#include "model.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief Represents a set of models, compared by value.
+ *
+ * Two models are the same element when they are equals(), wherever they
+ * live in memory. Models are kept in a dense array in insertion order
+ * (the iteration order), next to their Model::hash(); an open-addressing
+ * table with linear probing maps hashes to positions in that array. A
+ * lookup compares cached hashes first and calls equals() only on a hash
+ * match, so membership is expected O(1) and intersection, union and
+ * subset run in O(n + m).
+ *
+ * Models are shared, not copied, and must not be modified once inserted.
+ */
+class ModelSet {
+private:
+    std::vector<std::shared_ptr<Model>> models_;  // dense, insertion order
+    std::vector<std::uint64_t> hashes_;           // models_[i]->hash()
+    std::vector<std::uint32_t> table_;            // position + 1, 0 = free
+
+    std::size_t find(const Model& model, std::uint64_t hash) const;
+    bool insert(std::shared_ptr<Model> model, std::uint64_t hash);
+    void rehash(std::size_t buckets);
+
+public:
+    using const_iterator = std::vector<std::shared_ptr<Model>>::const_iterator;
+
+    ModelSet() = default;
+    ModelSet(std::initializer_list<std::shared_ptr<Model>> models);
+
+    /**
+     * @brief Add a model unless an equal one is present.
+     * @return true if the model was added
+     */
+    bool insert(std::shared_ptr<Model> model);
+
+    /**
+     * @brief Check if an equal model is in the set.
+     */
+    bool contains(const Model& model) const;
+
+    /**
+     * @brief Check if every model of this set is in another one.
+     */
+    bool isSubsetOf(const ModelSet& other) const;
+
+    /**
+     * @brief The models of this set that are also in another one.
+     */
+    ModelSet intersect(const ModelSet& other) const;
+
+    /**
+     * @brief The models of either set (this set's first).
+     */
+    ModelSet unite(const ModelSet& other) const;
+
+    void reserve(std::size_t count);
+    void clear();
+
+    std::size_t size() const { return models_.size(); }
+    bool empty() const { return models_.empty(); }
+    const_iterator begin() const { return models_.begin(); }
+    const_iterator end() const { return models_.end(); }
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_MODEL_SET_H
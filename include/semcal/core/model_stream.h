@@ -0,0 +1,73 @@
+#ifndef SEMCAL_CORE_MODEL_STREAM_H
+#define SEMCAL_CORE_MODEL_STREAM_H
+
+#include "model.h"
+#include "model_set.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief Lazy enumeration of a model set.
+ *
+ * Models are produced on demand, so a consumer that needs only some of
+ * them (a witness, emptiness, "at least k") stops the enumeration there
+ * instead of materializing the whole set. A stream is single-pass: each
+ * model is returned once, and an exhausted stream stays exhausted.
+ */
+class ModelStream {
+public:
+    virtual ~ModelStream() = default;
+
+    /**
+     * @brief Produce the next model.
+     * @return The model, or nullptr once the stream is exhausted
+     */
+    virtual std::shared_ptr<Model> next() = 0;
+
+    /**
+     * @brief Count the remaining models, pulling at most k of them.
+     * @param k The bound
+     * @return min(k, number of remaining models)
+     */
+    std::size_t countAtMost(std::size_t k);
+
+    /**
+     * @brief Materialize the remaining models.
+     * @return The set of remaining models
+     */
+    ModelSet collect();
+
+    /**
+     * @brief A stream without models.
+     */
+    static std::unique_ptr<ModelStream> empty();
+
+    /**
+     * @brief A stream over a materialized set.
+     */
+    static std::unique_ptr<ModelStream> of(ModelSet models);
+
+    /**
+     * @brief A stream that calls a generator until it returns nullptr.
+     */
+    static std::unique_ptr<ModelStream> generate(std::function<std::shared_ptr<Model>()> generator);
+
+    /**
+     * @brief The models of a source stream that satisfy a predicate.
+     *
+     * The source is advanced only as far as needed to find the next
+     * accepted model.
+     */
+    static std::unique_ptr<ModelStream> filter(
+        std::unique_ptr<ModelStream> source,
+        std::function<bool(const Model&)> predicate);
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_MODEL_STREAM_H
@@ -1,7 +1,10 @@
 #pragma once
 #include "model.h"
+#include "value.h"
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -10,21 +13,152 @@ namespace core {
 
 /**
  * @brief Partial model (partial valuation).
- * 
+ *
  * A partial model μ is a partial valuation:
  * μ : Var ⇀ Val
- * 
+ *
  * A total model M extends μ iff M ⊇ μ.
  * Partial models represent search decisions.
+ *
+ * Assignments are kept in a vector sorted by VariableId (as in
+ * ConcreteModel) plus a trail recording the previous value of every
+ * change. pushLevel() marks the trail and popToLevel(k) undoes the
+ * changes made above level k, so backtracking costs one update per
+ * change instead of a copy of the whole valuation. snapshot() returns
+ * an immutable handle that stays valid across backtracking.
+ *
+ * At level 0 the trail only serves the next snapshot, so it is cut
+ * back to the changes since the newest snapshot, and dropped (with the
+ * snapshot chain) once it outgrows the valuation itself.
  */
 class PartialModel {
 private:
-  std::unordered_map<std::string, std::string> assignments_;
+  struct TrailEntry {
+    VariableId variable;
+    Value previous;
+  };
+
+  // Assignments of one snapshot not already in its parent, newest last.
+  struct SnapshotChunk {
+    std::vector<std::pair<VariableId, Value>> entries;
+    std::shared_ptr<const SnapshotChunk> parent;
+    std::size_t size;  // assigned variables at snapshot time
+  };
+
+public:
+  /**
+   * @brief Immutable view of a partial model at the time it was taken.
+   *
+   * Snapshots taken in sequence share their common prefix, so taking
+   * one costs O(assignments since the previous live snapshot). Lookups
+   * walk the chain; use materialize() for repeated access.
+   */
+  class Snapshot {
+  private:
+    std::shared_ptr<const SnapshotChunk> head_;
+
+    friend class PartialModel;
+    explicit Snapshot(std::shared_ptr<const SnapshotChunk> head) : head_(std::move(head)) {}
+
+  public:
+    Snapshot() = default;
+
+    const Value& get(VariableId variable) const;
+    bool has(VariableId variable) const { return !get(variable).isNone(); }
+    std::size_t size() const { return head_ ? head_->size : 0; }
+    bool isEmpty() const { return size() == 0; }
+
+    /**
+     * @brief Rebuild a (mutable) partial model with these assignments.
+     */
+    PartialModel materialize() const;
+
+    std::string toString() const;
+
+    /**
+     * @brief Check if two handles refer to the same snapshot.
+     */
+    bool sameAs(const Snapshot& other) const { return head_ == other.head_; }
+  };
+
+private:
+  std::vector<std::pair<VariableId, Value>> entries_;  // sorted by VariableId
+  std::uint64_t hash_ = 0;          // XOR of per-assignment hashes
+  std::vector<TrailEntry> trail_;
+  std::vector<std::size_t> levels_; // trail size at each pushLevel()
+  // Live snapshots: (trail size when taken, chunk), oldest first
+  mutable std::vector<std::pair<std::size_t, std::shared_ptr<const SnapshotChunk>>> snapshots_;
+
+  std::vector<std::pair<VariableId, Value>>::const_iterator find(VariableId variable) const;
+  Value exchange(VariableId variable, Value value);
+  void compactBase();
 
 public:
   PartialModel() = default;
   explicit PartialModel(const std::unordered_map<std::string, std::string>& assignments);
 
+  /**
+   * @brief Assign a value (None unassigns); recorded on the trail.
+   */
+  void set(VariableId variable, Value value);
+  void unset(VariableId variable) { set(variable, Value()); }
+
+  /**
+   * @brief Get the value of a variable (None if unassigned).
+   */
+  const Value& get(VariableId variable) const;
+  bool has(VariableId variable) const { return find(variable) != entries_.end(); }
+  std::size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief Call f(VariableId, const Value&) for each assignment, by id.
+   */
+  template <class F>
+  void forEach(F&& f) const {
+    for (const auto& [variable, value] : entries_) {
+      f(variable, value);
+    }
+  }
+
+  /**
+   * @brief Hash of the current assignments, maintained incrementally.
+   *
+   * Independent of the order in which assignments were made.
+   */
+  std::uint64_t hash() const { return hash_; }
+
+  /**
+   * @brief Check if both partial models assign the same values.
+   */
+  bool equals(const PartialModel& other) const;
+
+  /**
+   * @brief Open a new decision level.
+   * @return The new level (1 for the first push)
+   */
+  std::size_t pushLevel();
+
+  /**
+   * @brief Undo every change made above the given level.
+   * @param level Target level (<= getLevel())
+   */
+  void popToLevel(std::size_t level);
+
+  /**
+   * @brief Get the current decision level (0 = no open level).
+   */
+  std::size_t getLevel() const { return levels_.size(); }
+
+  /**
+   * @brief Get the number of recorded changes.
+   */
+  std::size_t getTrailSize() const { return trail_.size(); }
+
+  /**
+   * @brief Take an immutable snapshot of the current assignments.
+   */
+  Snapshot snapshot() const;
+
   /**
    * @brief Set an assignment for a variable.
    * @param variable Variable name
@@ -73,6 +207,10 @@ public:
 
   /**
    * @brief Clone the partial model.
+   *
+   * Copies the current assignments only; the clone starts at level 0
+   * with an empty trail.
+   *
    * @return A new copy
    */
   std::unique_ptr<PartialModel> clone() const;
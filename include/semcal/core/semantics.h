@@ -2,18 +2,13 @@
 #define SEMCAL_CORE_SEMANTICS_H
 
 #include "model.h"
+#include "model_stream.h"
 #include "formula.h"
-#include <set>
 #include <memory>
 
 namespace semcal {
 namespace core {
 
-/**
- * @brief Represents the set of all models M.
- */
-using ModelSet = std::set<std::shared_ptr<Model>>;
-
 /**
  * @brief Semantic interpretation function.
  * 
@@ -24,12 +19,23 @@ class Semantics {
 public:
     virtual ~Semantics() = default;
 
+    /**
+     * @brief Enumerate the model set of a formula lazily.
+     * @param formula The formula to interpret
+     * @return A stream over [[F]]
+     */
+    virtual std::unique_ptr<ModelStream> models(const Formula& formula) const = 0;
+
     /**
      * @brief Compute the model set of a formula.
+     *
+     * Materializes models(formula); prefer the stream when only some
+     * models are needed.
+     *
      * @param formula The formula to interpret
      * @return The set of models that satisfy the formula
      */
-    virtual ModelSet interpret(const Formula& formula) const = 0;
+    virtual ModelSet interpret(const Formula& formula) const;
 
     /**
      * @brief Check if a model satisfies a formula.
@@ -52,6 +58,9 @@ public:
 
     /**
      * @brief Compute the intersection of two model sets.
+     *
+     * Models are compared by value, in expected O(|s1| + |s2|).
+     *
      * @param s1 First model set
      * @param s2 Second model set
      * @return Intersection of the two sets
@@ -60,6 +69,9 @@ public:
 
     /**
      * @brief Compute the union of two model sets.
+     *
+     * Models are compared by value, in expected O(|s1| + |s2|).
+     *
      * @param s1 First model set
      * @param s2 Second model set
      * @return Union of the two sets
@@ -79,7 +91,7 @@ public:
  */
 class DefaultSemantics : public Semantics {
 public:
-    ModelSet interpret(const Formula& formula) const override;
+    std::unique_ptr<ModelStream> models(const Formula& formula) const override;
     bool satisfies(const Model& model, const Formula& formula) const override;
     bool areEquivalent(const Formula& f1, const Formula& f2) const override;
 };
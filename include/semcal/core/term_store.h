@@ -0,0 +1,308 @@
+#ifndef SEMCAL_CORE_TERM_STORE_H
+#define SEMCAL_CORE_TERM_STORE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief Identifier of an interned term.
+ *
+ * Two terms are structurally equal iff their identifiers are equal.
+ */
+using TermId = std::uint32_t;
+
+/**
+ * @brief Identifier of an interned symbol (operator or leaf name).
+ */
+using SymbolId = std::uint32_t;
+
+constexpr TermId kNullTerm = 0xffffffffu;
+
+namespace detail {
+
+/**
+ * @brief Append-only vector with stable element addresses.
+ *
+ * Elements live in fixed-size pages reached through a directory that is
+ * allocated once, so reads never race with appends (appends must be
+ * serialized by the owner).
+ */
+template <class T, unsigned PageBits = 12, unsigned MaxPages = (1u << 16)>
+class StableVector {
+public:
+    static constexpr std::size_t kPageSize = std::size_t(1) << PageBits;
+
+    StableVector() : pages_(new std::unique_ptr<T[]>[MaxPages]) {}
+
+    const T& operator[](std::size_t i) const {
+        assert((i >> PageBits) < MaxPages && pages_[i >> PageBits]);
+        return pages_[i >> PageBits][i & (kPageSize - 1)];
+    }
+
+    T& operator[](std::size_t i) {
+        assert((i >> PageBits) < MaxPages && pages_[i >> PageBits]);
+        return pages_[i >> PageBits][i & (kPageSize - 1)];
+    }
+
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    std::size_t push_back(T value) {
+        std::size_t i = size_.load(std::memory_order_relaxed);
+        if ((i & (kPageSize - 1)) == 0) {
+            assert((i >> PageBits) < MaxPages && "StableVector capacity exceeded");
+            pages_[i >> PageBits].reset(new T[kPageSize]);
+        }
+        (*this)[i] = std::move(value);
+        size_.store(i + 1, std::memory_order_release);
+        return i;
+    }
+
+private:
+    std::unique_ptr<std::unique_ptr<T[]>[]> pages_;
+    std::atomic<std::size_t> size_{0};
+};
+
+} // namespace detail
+
+/**
+ * @brief Thread-safe string interning table.
+ *
+ * Maps names to dense identifiers. Identifiers and the strings they
+ * refer to stay valid for the lifetime of the table.
+ */
+class SymbolTable {
+private:
+    struct Entry {
+        std::string name;
+        std::uint64_t hash = 0;
+    };
+
+    mutable std::mutex mutex_;
+    detail::StableVector<Entry> entries_;
+    std::unordered_map<std::string_view, SymbolId> index_;
+
+public:
+    SymbolTable() = default;
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * @brief Intern a name.
+     * @param name The name to intern
+     * @return The identifier of the name (stable across calls)
+     */
+    SymbolId intern(std::string_view name);
+
+    /**
+     * @brief Look up a name without interning it.
+     * @param name The name to look up
+     * @param id Set to the identifier when found
+     * @return true if the name is interned
+     */
+    bool lookup(std::string_view name, SymbolId& id) const;
+
+    /**
+     * @brief Get the name of a symbol.
+     */
+    const std::string& name(SymbolId id) const { return entries_[id].name; }
+
+    /**
+     * @brief Get the content hash of a symbol (independent of its id).
+     */
+    std::uint64_t hash(SymbolId id) const { return entries_[id].hash; }
+
+    /**
+     * @brief Get the number of interned symbols.
+     */
+    std::size_t size() const { return entries_.size(); }
+};
+
+/**
+ * @brief Lightweight view of the arguments of a term.
+ */
+struct TermArgs {
+    const TermId* data = nullptr;
+    std::uint32_t count = 0;
+
+    const TermId* begin() const { return data; }
+    const TermId* end() const { return data + count; }
+    std::uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    TermId operator[](std::size_t i) const { return data[i]; }
+};
+
+/**
+ * @brief Hash-consed store of formula terms.
+ *
+ * Terms form a DAG of S-expressions: a term is either a leaf (symbol,
+ * numeral, ...) or an application of a head symbol to argument terms.
+ * Every structurally distinct term is stored exactly once, so:
+ * - structural equality is identifier equality (O(1)),
+ * - subterms are shared between all formulas that contain them,
+ * - copying a formula only copies its root identifier.
+ *
+ * Conjunctions and disjunctions are kept in a normal form: nested
+ * and/or are flattened, arguments are sorted by structural hash,
+ * duplicates and neutral elements are dropped, and singletons collapse
+ * to their argument. Formulas equal modulo associativity, commutativity
+ * and idempotence of and/or therefore get the same identifier.
+ *
+ * Terms are never freed; the store grows monotonically.
+ * Construction is serialized by an internal mutex, reads are lock-free.
+ */
+class TermStore {
+private:
+    struct Node {
+        SymbolId symbol;      // head symbol (applications) or token (leaves)
+        std::uint32_t arity;  // 0 for leaves
+        const TermId* args;   // stable pointer into the argument arena
+        std::uint64_t hash;   // structural hash
+    };
+
+    mutable std::mutex mutex_;
+    SymbolTable symbols_;
+    detail::StableVector<Node> nodes_;
+    std::vector<TermId> table_;  // open-addressing hash-cons table
+    std::vector<std::unique_ptr<TermId[]>> argChunks_;
+    TermId* argCursor_ = nullptr;
+    std::size_t argRemaining_ = 0;
+    SymbolId listSymbol_;
+    SymbolId andSymbol_;
+    SymbolId orSymbol_;
+    TermId trueTerm_;
+    TermId falseTerm_;
+
+    TermId intern(SymbolId symbol, const TermId* args, std::uint32_t arity);
+    TermId internAC(SymbolId symbol, const TermId* args, std::size_t arity);
+    int compareStructure(TermId a, TermId b) const;
+    const TermId* storeArgs(const TermId* args, std::uint32_t arity);
+    void growTable();
+
+public:
+    TermStore();
+    TermStore(const TermStore&) = delete;
+    TermStore& operator=(const TermStore&) = delete;
+
+    /**
+     * @brief Get the process-wide store shared by all formulas.
+     */
+    static TermStore& global();
+
+    /**
+     * @brief Create (or find) a leaf term.
+     * @param token The leaf token, e.g. "x", "42", "true"
+     */
+    TermId mkLeaf(std::string_view token);
+    TermId mkLeaf(SymbolId token);
+
+    /**
+     * @brief Create (or find) an application term.
+     *
+     * Applications of "and" and "or" are normalized (see class comment).
+     *
+     * @param head The head symbol, e.g. "and", "+", "<="
+     * @param args The argument terms
+     */
+    TermId mkApp(std::string_view head, const std::vector<TermId>& args);
+    TermId mkApp(std::string_view head, const TermId* args, std::size_t arity);
+    TermId mkApp(SymbolId head, const TermId* args, std::size_t arity);
+
+    /**
+     * @brief Create (or find) a list term whose head is not a symbol,
+     * e.g. the binder list of a quantifier.
+     */
+    TermId mkList(const TermId* elements, std::size_t count);
+
+    TermId mkTrue() const { return trueTerm_; }
+    TermId mkFalse() const { return falseTerm_; }
+    TermId mkNot(TermId t);
+    TermId mkAnd(const std::vector<TermId>& args);
+    TermId mkOr(const std::vector<TermId>& args);
+    TermId mkImplies(TermId premise, TermId conclusion);
+
+    /**
+     * @brief Parse an SMT-LIB S-expression into the store.
+     *
+     * Text that is not a single well-formed S-expression is interned
+     * as one opaque leaf, so every string has a representation. So is
+     * text containing "()" or a nullary application "(f)", which has no
+     * node distinct from the leaf f.
+     */
+    TermId parse(std::string_view text);
+
+    /**
+     * @brief Check if a term is a leaf.
+     */
+    bool isLeaf(TermId t) const { return nodes_[t].arity == 0; }
+
+    /**
+     * @brief Get the head symbol of an application, or the token of a leaf.
+     */
+    SymbolId symbol(TermId t) const { return nodes_[t].symbol; }
+
+    /**
+     * @brief Get the name of the head symbol or leaf token.
+     */
+    const std::string& name(TermId t) const { return symbols_.name(nodes_[t].symbol); }
+
+    /**
+     * @brief Get the arguments of a term (empty for leaves).
+     */
+    TermArgs args(TermId t) const {
+        const Node& n = nodes_[t];
+        return TermArgs{n.args, n.arity};
+    }
+
+    /**
+     * @brief Get the structural hash of a term.
+     *
+     * Depends only on the term's structure, not on identifiers, so it is
+     * stable across runs.
+     */
+    std::uint64_t hash(TermId t) const { return nodes_[t].hash; }
+
+    /**
+     * @brief Check if an application has the given head symbol.
+     */
+    bool isApp(TermId t, SymbolId head) const {
+        const Node& n = nodes_[t];
+        return n.arity != 0 && n.symbol == head;
+    }
+
+    /**
+     * @brief Get the symbol table used for heads and leaves.
+     */
+    SymbolTable& symbols() { return symbols_; }
+    const SymbolTable& symbols() const { return symbols_; }
+
+    /**
+     * @brief Get the number of distinct terms.
+     */
+    std::size_t size() const { return nodes_.size(); }
+
+    /**
+     * @brief Print a term as an SMT-LIB S-expression.
+     */
+    std::string toString(TermId t) const;
+
+    /**
+     * @brief Append the SMT-LIB rendering of a term to a buffer.
+     */
+    void print(TermId t, std::string& out) const;
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_TERM_STORE_H
@@ -0,0 +1,127 @@
+#ifndef SEMCAL_CORE_VALUE_H
+#define SEMCAL_CORE_VALUE_H
+
+#include "term_store.h"
+#include "semcal/util/rational.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace semcal {
+namespace core {
+
+/**
+ * @brief Closed floating-point interval [lo, hi].
+ */
+struct Interval {
+    double lo = 0.0;
+    double hi = 0.0;
+
+    bool operator==(const Interval& o) const { return lo == o.lo && hi == o.hi; }
+    bool operator!=(const Interval& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Fixed-width bit-vector value.
+ *
+ * Up to 64 bits are stored inline; wider values use a word vector.
+ */
+class BitVector {
+private:
+    std::uint32_t width_ = 0;
+    std::uint64_t bits_ = 0;            // width <= 64
+    std::vector<std::uint64_t> words_;  // width > 64, little-endian
+
+public:
+    BitVector() = default;
+    BitVector(std::uint32_t width, std::uint64_t bits);
+    BitVector(std::uint32_t width, std::vector<std::uint64_t> words);
+
+    /**
+     * @brief Parse "#b0101", "#x1f" or "(_ bv5 8)".
+     * @return false if the text is not a bit-vector literal
+     */
+    static bool parse(std::string_view text, BitVector& out);
+
+    std::uint32_t width() const { return width_; }
+    std::uint64_t word(std::size_t i) const;
+    bool bit(std::uint32_t i) const { return (word(i / 64) >> (i % 64)) & 1; }
+
+    /**
+     * @brief Render as an SMT-LIB binary literal ("#b...").
+     */
+    std::string toString() const;
+    std::uint64_t hash() const;
+
+    bool operator==(const BitVector& o) const {
+        return width_ == o.width_ && bits_ == o.bits_ && words_ == o.words_;
+    }
+    bool operator!=(const BitVector& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Typed value assigned to a variable in a model.
+ *
+ * A tagged union of the value sorts used by the backends. Numbers are
+ * canonical: an integral rational that fits in int64 is always stored
+ * as Int, so equal numbers compare equal regardless of how they were
+ * built. Values without a more specific sort (e.g. enumeration
+ * constants) are kept as interned symbols.
+ */
+class Value {
+public:
+    enum class Kind { None, Bool, Int, Rational, Interval, BitVector, Symbol };
+
+private:
+    // Alternatives are in Kind order.
+    std::variant<std::monostate, bool, std::int64_t, util::Rational, Interval, BitVector, SymbolId> data_;
+
+public:
+    Value() = default;
+
+    static Value boolean(bool b);
+    static Value integer(std::int64_t i);
+    static Value number(const util::Rational& r);
+    static Value interval(double lo, double hi);
+    static Value bitVector(BitVector bv);
+    static Value symbol(SymbolId s);
+
+    /**
+     * @brief Parse the textual form of a value (slow path).
+     *
+     * Accepts true/false, integers, fractions "a/b", decimals, SMT-LIB
+     * negation "(- 5)", bit-vector literals and intervals "[lo, hi]";
+     * any other text becomes a symbol value.
+     */
+    static Value parse(std::string_view text);
+
+    Kind kind() const { return static_cast<Kind>(data_.index()); }
+    bool isNone() const { return kind() == Kind::None; }
+    bool isBool() const { return kind() == Kind::Bool; }
+    bool isNumber() const { return kind() == Kind::Int || kind() == Kind::Rational; }
+
+    bool asBool() const { return std::get<bool>(data_); }
+    std::int64_t asInt() const { return std::get<std::int64_t>(data_); }
+    const util::Rational& asRational() const { return std::get<util::Rational>(data_); }
+    const Interval& asInterval() const { return std::get<Interval>(data_); }
+    const BitVector& asBitVector() const { return std::get<BitVector>(data_); }
+    SymbolId asSymbol() const { return std::get<SymbolId>(data_); }
+
+    /**
+     * @brief Get a number (Int or Rational) as a rational.
+     */
+    util::Rational toRational() const;
+
+    std::string toString() const;
+    std::uint64_t hash() const;
+
+    bool operator==(const Value& o) const { return data_ == o.data_; }
+    bool operator!=(const Value& o) const { return !(*this == o); }
+};
+
+} // namespace core
+} // namespace semcal
+
+#endif // SEMCAL_CORE_VALUE_H
@@ -1,6 +1,7 @@
 #ifndef SEMCAL_DOMAIN_ABSTRACT_DOMAIN_H
 #define SEMCAL_DOMAIN_ABSTRACT_DOMAIN_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -44,6 +45,16 @@ public:
      */
     virtual bool equals(const AbstractElement& other) const = 0;
 
+    /**
+     * @brief Get a hash consistent with equals().
+     *
+     * The default implementation hashes toString(); domains with a
+     * cheaper canonical form should override it.
+     *
+     * @return 64-bit hash
+     */
+    virtual std::uint64_t hash() const;
+
     /**
      * @brief Get a string representation.
      * @return String representation
@@ -0,0 +1,124 @@
+#ifndef SEMCAL_DOMAIN_BOX_BATCH_H
+#define SEMCAL_DOMAIN_BOX_BATCH_H
+
+#include "interval_box.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace semcal {
+namespace domain {
+
+/**
+ * @brief A block of interval boxes in structure-of-arrays layout.
+ *
+ * Bounds are stored column by column: column c belongs to variables()[c],
+ * and lowerAt(c)[i], upperAt(c)[i] are its bounds in box i. As in
+ * IntervalBox, columns are sorted by VariableId and exist only for the
+ * variables of the batch, so a batch built over
+ * Hc4Contractor::getVariables() has the contractor's variable order
+ * and its size does not depend on the global symbol table. Variables
+ * without a column are unbounded. Columns are padded to a multiple of
+ * kBlock boxes so batched kernels can always process whole blocks;
+ * padding lanes hold unspecified values.
+ *
+ * Box i is empty if lo > hi in some column, or if markEmpty() was
+ * called on it (which also writes [+∞, −∞] into the first column).
+ */
+class BoxBatch {
+public:
+    static constexpr std::size_t kBlock = 8;
+    static constexpr std::size_t kNoColumn = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Per-box status flags reported by batched contraction.
+     */
+    static constexpr std::uint8_t kContracted = 1;  // some bound moved
+    static constexpr std::uint8_t kEmpty = 2;       // box proven empty
+
+    /**
+     * @brief Construct an empty batch with a column per variable.
+     * @param variables Variables sorted by id, without duplicates
+     */
+    explicit BoxBatch(std::vector<core::VariableId> variables = {});
+
+    std::size_t size() const { return size_; }
+    std::size_t dimensions() const { return variables_.size(); }
+
+    /**
+     * @brief Variables with a column, sorted by id.
+     */
+    const std::vector<core::VariableId>& variables() const { return variables_; }
+
+    /**
+     * @brief Distance between two columns (a multiple of kBlock).
+     */
+    std::size_t stride() const { return stride_; }
+
+    /**
+     * @brief Get the column of a variable, or kNoColumn.
+     */
+    std::size_t column(core::VariableId variable) const;
+
+    /**
+     * @brief Give every listed variable a column, unbounded in all boxes.
+     *
+     * Columns are renumbered when a variable is added.
+     *
+     * @param variables Variables sorted by id
+     */
+    void addColumns(const std::vector<core::VariableId>& variables);
+
+    /**
+     * @brief Bound columns by column index.
+     */
+    double* lowerAt(std::size_t column) { return lower_.data() + column * stride_; }
+    double* upperAt(std::size_t column) { return upper_.data() + column * stride_; }
+    const double* lowerAt(std::size_t column) const { return lower_.data() + column * stride_; }
+    const double* upperAt(std::size_t column) const { return upper_.data() + column * stride_; }
+
+    /**
+     * @brief Bound columns of a variable; requires a column for it.
+     */
+    double* lower(core::VariableId variable) { return lowerAt(column(variable)); }
+    double* upper(core::VariableId variable) { return upperAt(column(variable)); }
+    const double* lower(core::VariableId variable) const { return lowerAt(column(variable)); }
+    const double* upper(core::VariableId variable) const { return upperAt(column(variable)); }
+
+    /**
+     * @brief Append a box, adding columns as needed.
+     * @return Index of the new box
+     */
+    std::size_t append(const IntervalBox& box);
+
+    /**
+     * @brief Overwrite box i, adding columns as needed.
+     */
+    void assign(std::size_t index, const IntervalBox& box);
+
+    /**
+     * @brief Copy box i out as an IntervalBox.
+     */
+    IntervalBox extract(std::size_t index) const;
+
+    bool isEmpty(std::size_t index) const;
+    void markEmpty(std::size_t index);
+
+    void reserve(std::size_t boxes);
+    void clear() { size_ = 0; }
+
+private:
+    std::vector<core::VariableId> variables_;  // sorted, one per column
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+    std::vector<std::uint8_t> marked_;         // per box: markEmpty() called
+    std::size_t size_ = 0;
+    std::size_t stride_ = 0;
+
+    void relayout(std::vector<core::VariableId> variables, std::size_t stride);
+};
+
+} // namespace domain
+} // namespace semcal
+
+#endif // SEMCAL_DOMAIN_BOX_BATCH_H
@@ -0,0 +1,55 @@
+#ifndef SEMCAL_DOMAIN_BOX_DOMAIN_H
+#define SEMCAL_DOMAIN_BOX_DOMAIN_H
+
+#include "abstract_domain.h"
+#include "concretization.h"
+#include "interval_box.h"
+#include <memory>
+
+namespace semcal {
+namespace domain {
+
+/**
+ * @brief Interval box domain.
+ *
+ * top() is the full box and bottom() the empty box; join is the
+ * interval hull and meet the intersection. Elements that are not
+ * boxes (e.g. TopElement) are read as the full box, which is a sound
+ * over-approximation of any element.
+ */
+class BoxDomain : public AbstractDomain {
+public:
+    std::unique_ptr<AbstractElement> bottom() const override;
+    std::unique_ptr<AbstractElement> top() const override;
+    std::unique_ptr<AbstractElement> join(
+        const AbstractElement& a,
+        const AbstractElement& b) const override;
+    std::unique_ptr<AbstractElement> meet(
+        const AbstractElement& a,
+        const AbstractElement& b) const override;
+};
+
+/**
+ * @brief Concretization of interval boxes.
+ *
+ * contains, containsAll, membership, isEmpty and isSubset are decided
+ * on the bounds in O(dimensions) per model or box instead of
+ * enumerating models. models() can only enumerate point boxes (every
+ * bounded variable fixed); any other box denotes infinitely many models
+ * and yields an empty stream, as does DefaultConcretization.
+ */
+class BoxConcretization : public Concretization {
+public:
+    std::unique_ptr<core::ModelStream> models(const AbstractElement& element) const override;
+    bool contains(const AbstractElement& element, const core::Model& model) const override;
+    bool containsAll(const AbstractElement& element, const core::ModelSet& models) const override;
+    std::function<bool(const core::Model&)> membership(
+        std::shared_ptr<const AbstractElement> element) const override;
+    bool isEmpty(const AbstractElement& element) const override;
+    bool isSubset(const AbstractElement& a, const AbstractElement& b) const override;
+};
+
+} // namespace domain
+} // namespace semcal
+
+#endif // SEMCAL_DOMAIN_BOX_DOMAIN_H
@@ -3,6 +3,7 @@
 
 #include "abstract_domain.h"
 #include "semcal/core/semantics.h"
+#include <functional>
 #include <memory>
 
 namespace semcal {
@@ -18,18 +19,69 @@ class Concretization {
 public:
     virtual ~Concretization() = default;
 
+    /**
+     * @brief Enumerate the models of an abstract element lazily.
+     * @param element The abstract element to concretize
+     * @return A stream over γ(element)
+     */
+    virtual std::unique_ptr<core::ModelStream> models(const AbstractElement& element) const = 0;
+
     /**
      * @brief Concretize an abstract element.
      * 
-     * Returns the set of models represented by the abstract element.
+     * Returns the set of models represented by the abstract element,
+     * materialized from models(element).
      * 
      * @param element The abstract element to concretize
      * @return The set of models γ(element)
      */
-    virtual core::ModelSet concretize(const AbstractElement& element) const = 0;
+    virtual core::ModelSet concretize(const AbstractElement& element) const;
+
+    /**
+     * @brief Check if a model is represented by an abstract element.
+     *
+     * The default implementation scans models(element) and stops at the
+     * first equal model.
+     *
+     * @param element The abstract element
+     * @param model The model to look for
+     * @return true if model ∈ γ(element)
+     */
+    virtual bool contains(const AbstractElement& element, const core::Model& model) const;
+
+    /**
+     * @brief Check if every model of a set is represented by an abstract element.
+     *
+     * The default implementation materializes γ(element) once and looks
+     * the models up by hash, in expected O(|models| + |γ(element)|).
+     *
+     * @param element The abstract element
+     * @param models The models to look for
+     * @return true if models ⊆ γ(element)
+     */
+    virtual bool containsAll(const AbstractElement& element, const core::ModelSet& models) const;
+
+    /**
+     * @brief Get a membership test for γ(element), for many queries.
+     *
+     * The default implementation materializes γ(element) on the first
+     * query and answers each query by hash lookup, instead of scanning
+     * models(element) per query as contains() does. Concretizations
+     * with a direct contains() override this to call it. The test
+     * shares the element and refers to this concretization, which must
+     * outlive it.
+     *
+     * @param element The abstract element
+     * @return A predicate that holds for the models in γ(element)
+     */
+    virtual std::function<bool(const core::Model&)> membership(
+        std::shared_ptr<const AbstractElement> element) const;
 
     /**
      * @brief Check if an abstract element represents an empty set.
+     *
+     * The default implementation pulls at most one model.
+     *
      * @param element The abstract element to check
      * @return true if γ(element) = ∅
      */
@@ -52,7 +104,7 @@ public:
  */
 class DefaultConcretization : public Concretization {
 public:
-    core::ModelSet concretize(const AbstractElement& element) const override;
+    std::unique_ptr<core::ModelStream> models(const AbstractElement& element) const override;
 };
 
 } // namespace domain
@@ -0,0 +1,165 @@
+#ifndef SEMCAL_DOMAIN_INTERVAL_BOX_H
+#define SEMCAL_DOMAIN_INTERVAL_BOX_H
+
+#include "abstract_domain.h"
+#include "semcal/core/model.h"
+#include "semcal/core/value.h"
+#include "semcal/util/rational.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace semcal {
+namespace domain {
+
+/**
+ * @brief Box of closed floating-point intervals, one per variable.
+ *
+ * γ(box) = { M | lo(x) ≤ M(x) ≤ hi(x) for every variable x }.
+ *
+ * A box stores bounds only for its own variables, kept sorted by
+ * VariableId: slot i holds [lowerAt(i), upperAt(i)] for variables()[i],
+ * and variables without a slot are unbounded. Storage therefore follows
+ * the formula, not the global symbol table. A box built over
+ * Hc4Contractor::getVariables() has the contractor's variable order as
+ * its slots; hot loops resolve each VariableId to its slot once and use
+ * the slot accessors from then on.
+ *
+ * Bounds are always sound: conversions from exact numbers round
+ * outward (lower bounds down, upper bounds up), and meet/join only
+ * take minima and maxima, which are exact.
+ *
+ * A box with lo > hi in any dimension is empty (⊥); all empty boxes
+ * are equal.
+ */
+class IntervalBox : public AbstractElement {
+private:
+    std::vector<core::VariableId> variables_;  // sorted, one per slot
+    std::vector<double> bounds_;               // [lo₀, hi₀, lo₁, hi₁, ...] by slot
+    bool empty_ = false;
+
+public:
+    static constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Construct the full box (no variable is bounded).
+     */
+    IntervalBox() = default;
+
+    /**
+     * @brief Construct the full box with an (unbounded) slot per variable.
+     * @param variables Variables sorted by id, without duplicates
+     */
+    explicit IntervalBox(std::vector<core::VariableId> variables);
+
+    /**
+     * @brief Construct the empty box.
+     */
+    static IntervalBox emptyBox();
+
+    /**
+     * @brief Get the number of slots.
+     */
+    std::size_t dimensions() const { return variables_.size(); }
+
+    /**
+     * @brief Variables with a slot, sorted by id (slot i is variables()[i]).
+     */
+    const std::vector<core::VariableId>& variables() const { return variables_; }
+
+    /**
+     * @brief Get the slot of a variable, or kNoSlot.
+     */
+    std::size_t slot(core::VariableId variable) const;
+
+    /**
+     * @brief Give every listed variable a slot, unbounded if new.
+     *
+     * Slots are renumbered when a variable is added, so slots looked
+     * up before the call are stale. Does nothing on the empty box.
+     *
+     * @param variables Variables sorted by id
+     */
+    void addSlots(const std::vector<core::VariableId>& variables);
+
+    double lowerAt(std::size_t slot) const { return bounds_[2 * slot]; }
+    double upperAt(std::size_t slot) const { return bounds_[2 * slot + 1]; }
+
+    /**
+     * @brief Set the bounds of a slot, as set() does for a variable.
+     */
+    void setAt(std::size_t slot, double lo, double hi);
+
+    double lower(core::VariableId variable) const {
+        std::size_t i = slot(variable);
+        return i != kNoSlot ? bounds_[2 * i] : -kInfinity;
+    }
+    double upper(core::VariableId variable) const {
+        std::size_t i = slot(variable);
+        return i != kNoSlot ? bounds_[2 * i + 1] : kInfinity;
+    }
+    core::Interval get(core::VariableId variable) const {
+        return core::Interval{lower(variable), upper(variable)};
+    }
+
+    /**
+     * @brief Set the bounds of a variable; the box becomes empty if lo > hi.
+     *
+     * The doubles are taken as given: callers computing bounds must
+     * already have rounded them outward.
+     */
+    void set(core::VariableId variable, double lo, double hi);
+
+    /**
+     * @brief Set exact bounds, rounding them outward to doubles.
+     */
+    void set(core::VariableId variable, const util::Rational& lo, const util::Rational& hi);
+
+    /**
+     * @brief Remove the bounds of a variable (its slot is kept).
+     */
+    void unbound(core::VariableId variable);
+
+    /**
+     * @brief Intersect with another box in place (meet).
+     */
+    void meetWith(const IntervalBox& other);
+
+    /**
+     * @brief Replace by the interval hull of both boxes in place (join).
+     */
+    void joinWith(const IntervalBox& other);
+
+    /**
+     * @brief Check if γ(other) ⊆ γ(this).
+     */
+    bool contains(const IntervalBox& other) const;
+
+    bool isEmpty() const { return empty_; }
+    bool isFull() const;
+
+    /**
+     * @brief Get the width of a variable's interval (0 when empty).
+     */
+    double width(core::VariableId variable) const {
+        return empty_ ? 0.0 : upper(variable) - lower(variable);
+    }
+
+    bool isLessPreciseThan(const AbstractElement& other) const override;
+    bool equals(const AbstractElement& other) const override;
+    std::uint64_t hash() const override;
+    std::string toString() const override;
+    std::unique_ptr<AbstractElement> clone() const override;
+
+private:
+    // First slot at or after i with a finite bound (dimensions() if none).
+    std::size_t nextBounded(std::size_t i) const;
+    void markEmpty();
+};
+
+} // namespace domain
+} // namespace semcal
+
+#endif // SEMCAL_DOMAIN_INTERVAL_BOX_H
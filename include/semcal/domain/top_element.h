@@ -16,6 +16,7 @@ class TopElement : public AbstractElement {
 public:
     bool isLessPreciseThan(const AbstractElement& other) const override;
     bool equals(const AbstractElement& other) const override;
+    std::uint64_t hash() const override;
     std::string toString() const override;
     std::unique_ptr<AbstractElement> clone() const override;
 };
@@ -0,0 +1,76 @@
+#ifndef SEMCAL_IO_DIMACS_READER_H
+#define SEMCAL_IO_DIMACS_READER_H
+
+#include "semcal/core/clause_arena.h"
+#include "semcal/core/cnf_formula.h"
+#include "semcal/util/op_result.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace semcal {
+namespace io {
+
+/**
+ * @brief Diagnostic reported when a DIMACS file cannot be read.
+ */
+struct DimacsDiagnostic {
+    std::string message;
+    std::size_t line = 0;
+
+    std::string toString() const;
+};
+
+/**
+ * @brief Reader for DIMACS CNF files.
+ *
+ * Files are memory-mapped and literals are scanned with a hand-written
+ * integer parser straight into a ClauseArena sized from the
+ * "p cnf <vars> <clauses>" header; no allocation happens per clause.
+ *
+ * The reader is lenient where solvers usually are: comment lines
+ * ('c') may appear anywhere, a missing final 0 closes the last clause,
+ * '%' ends the clause section (SATLIB files), and the clause count in
+ * the header is only a size hint. Literals above the declared variable
+ * count are an error.
+ */
+class DimacsReader {
+public:
+    using Result = util::OpResult<std::unique_ptr<core::CnfFormula>, DimacsDiagnostic>;
+
+    /**
+     * @brief Read a DIMACS file (memory-mapped when possible).
+     * @param path Path to the file
+     * @return OK with the formula, or ERROR with a diagnostic
+     */
+    static Result readFile(const std::string& path);
+
+    /**
+     * @brief Read DIMACS input from a stream (e.g. a pipe).
+     * @param file Open stream; not closed by the reader
+     * @return OK with the formula, or ERROR with a diagnostic
+     */
+    static Result readStream(std::FILE* file);
+
+    /**
+     * @brief Read DIMACS text held in memory.
+     * @param text The DIMACS text
+     * @return OK with the formula, or ERROR with a diagnostic
+     */
+    static Result readString(std::string_view text);
+
+    /**
+     * @brief Parse DIMACS text into an existing arena.
+     * @param text The DIMACS text
+     * @param arena Arena receiving the clauses
+     * @param diag Set on failure
+     * @return true on success
+     */
+    static bool parse(std::string_view text, core::ClauseArena& arena, DimacsDiagnostic& diag);
+};
+
+} // namespace io
+} // namespace semcal
+
+#endif // SEMCAL_IO_DIMACS_READER_H
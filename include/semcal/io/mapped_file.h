@@ -0,0 +1,50 @@
+#ifndef SEMCAL_IO_MAPPED_FILE_H
+#define SEMCAL_IO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace semcal {
+namespace io {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Used by the input readers to scan large benchmark files without
+ * copying them. Mapping fails for non-regular files (pipes, terminals)
+ * and on platforms without mmap; readers then fall back to buffered
+ * stream input.
+ */
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file.
+     * @param path Path to a regular file
+     * @return true if the file is mapped (possibly empty)
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmap the file.
+     */
+    void close();
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool isOpen() const { return mapped_; }
+};
+
+} // namespace io
+} // namespace semcal
+
+#endif // SEMCAL_IO_MAPPED_FILE_H
@@ -0,0 +1,186 @@
+#ifndef SEMCAL_IO_SMTLIB_READER_H
+#define SEMCAL_IO_SMTLIB_READER_H
+
+#include "semcal/core/formula.h"
+#include "semcal/core/term_store.h"
+#include "semcal/util/op_result.h"
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace semcal {
+namespace io {
+
+/**
+ * @brief Diagnostic reported when an SMT-LIB script cannot be read.
+ */
+struct SmtLibDiagnostic {
+    std::string message;
+    std::size_t line = 0;
+
+    std::string toString() const;
+};
+
+/**
+ * @brief A function symbol introduced by declare-fun / declare-const.
+ */
+struct SmtLibDeclaration {
+    core::SymbolId name;
+    std::vector<core::TermId> argSorts;
+    core::TermId sort;
+};
+
+/**
+ * @brief Streaming reader for SMT-LIB v2 scripts.
+ *
+ * Tokens are scanned directly from a memory-mapped file or from a
+ * buffered stream (pipes, stdin) and terms are built straight into a
+ * TermStore, without materializing intermediate strings. Let-bindings
+ * and define-fun macros are expanded on the fly.
+ *
+ * Supported commands:
+ * - declare-fun, declare-const, define-fun
+ * - assert, push, pop, check-sat, reset, reset-assertions, exit
+ * - set-logic (recorded); other commands are skipped
+ *
+ * The reader keeps the assertion stack of the script: pop discards the
+ * assertions and declarations of the popped scopes, so memory held by
+ * the reader stays proportional to the live assertion set. Terms are
+ * hash-consed into the store, which is never shrunk; a repeated
+ * check-sat over unchanged assertions reuses their conjunction.
+ */
+class SmtLibReader {
+public:
+    /**
+     * @brief Called on every check-sat with the current assertions.
+     */
+    using CheckSatCallback = std::function<void(const core::Formula& assertions)>;
+
+    explicit SmtLibReader(core::TermStore& store = core::TermStore::global());
+
+    /**
+     * @brief Set the callback invoked on check-sat.
+     */
+    void setCheckSatCallback(CheckSatCallback callback) { onCheckSat_ = std::move(callback); }
+
+    /**
+     * @brief Read a script from a file (memory-mapped when possible).
+     * @param path Path to the file
+     * @return OK, or ERROR with a diagnostic
+     */
+    util::OpResult<void, SmtLibDiagnostic> readFile(const std::string& path);
+
+    /**
+     * @brief Read a script incrementally from a stream (e.g. a pipe).
+     * @param file Open stream; not closed by the reader
+     * @return OK, or ERROR with a diagnostic
+     */
+    util::OpResult<void, SmtLibDiagnostic> readStream(std::FILE* file);
+
+    /**
+     * @brief Read a script held in memory.
+     * @param text The script text
+     * @return OK, or ERROR with a diagnostic
+     */
+    util::OpResult<void, SmtLibDiagnostic> readString(std::string_view text);
+
+    /**
+     * @brief Get the live assertions, outermost scope first.
+     */
+    const std::vector<core::TermId>& getAssertions() const { return assertions_; }
+
+    /**
+     * @brief Get the conjunction of the live assertions.
+     */
+    std::unique_ptr<core::Formula> getAssertionFormula() const;
+
+    /**
+     * @brief Get the live declarations.
+     */
+    const std::vector<SmtLibDeclaration>& getDeclarations() const { return declarations_; }
+
+    /**
+     * @brief Get the number of open push scopes.
+     */
+    std::size_t getScopeLevel() const { return scopes_.size(); }
+
+    /**
+     * @brief Get the logic given by set-logic (empty if none).
+     */
+    const std::string& getLogic() const { return logic_; }
+
+    /**
+     * @brief Get the number of check-sat commands read so far.
+     */
+    std::size_t getCheckSatCount() const { return checkSatCount_; }
+
+    class Scanner;
+
+private:
+    enum class Token { LParen, RParen, Atom, End, Error };
+
+    struct Definition {
+        std::vector<core::SymbolId> params;
+        core::TermId body;
+    };
+
+    struct Scope {
+        std::size_t assertions;
+        std::size_t declarations;
+        std::size_t definitions;
+    };
+
+    enum class FrameKind { App, LetBindings, LetBody, Annotation };
+
+    // Open parenthesis of the term being parsed
+    struct Frame {
+        FrameKind kind;
+        bool started;              // head or first argument seen
+        bool hasHead;              // head is a symbol (else: plain list)
+        core::SymbolId head;
+        std::size_t argStart;      // App: into argStack_, Let*: into letPending_
+        core::SymbolId pendingName;  // LetBindings: variable being bound
+    };
+
+    core::TermStore& store_;
+    CheckSatCallback onCheckSat_;
+    std::vector<core::TermId> assertions_;
+    mutable core::TermId conjunction_ = core::kNullTerm;  // of assertions_, built on demand
+    std::vector<SmtLibDeclaration> declarations_;
+    std::vector<core::SymbolId> definitionOrder_;
+    std::unordered_map<core::SymbolId, Definition> definitions_;
+    std::unordered_map<core::SymbolId, std::vector<core::TermId>> bindings_;  // non-empty stacks only
+    std::size_t activeBindings_ = 0;
+    std::vector<Scope> scopes_;
+    std::string logic_;
+    std::size_t checkSatCount_ = 0;
+    bool exited_ = false;
+
+    // Parser scratch, reused across terms
+    std::vector<Frame> frames_;
+    std::vector<core::TermId> argStack_;
+    std::vector<std::pair<core::SymbolId, core::TermId>> letPending_;
+
+    util::OpResult<void, SmtLibDiagnostic> run(Scanner& scanner);
+    bool readCommand(Scanner& scanner, SmtLibDiagnostic& diag);
+    bool readTerm(Scanner& scanner, core::TermId& result, SmtLibDiagnostic& diag);
+    bool readTermFrom(Scanner& scanner, Token first, core::TermId& result, SmtLibDiagnostic& diag);
+    bool readSymbol(Scanner& scanner, core::SymbolId& symbol, SmtLibDiagnostic& diag);
+    bool expect(Scanner& scanner, Token token, SmtLibDiagnostic& diag);
+    bool skipRest(Scanner& scanner, SmtLibDiagnostic& diag);
+    core::TermId resolveSymbol(core::SymbolId symbol);
+    core::TermId conjunction() const;
+    void unbind(core::SymbolId symbol);
+    core::TermId applyDefinition(const Definition& def, const core::TermId* args, std::size_t count);
+    void popScopes(std::size_t count);
+    void reset();
+};
+
+} // namespace io
+} // namespace semcal
+
+#endif // SEMCAL_IO_SMTLIB_READER_H
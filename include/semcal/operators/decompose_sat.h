@@ -0,0 +1,24 @@
+#pragma once
+#include "decompose.h"
+#include "semcal/backends/sat_backend.h"
+
+namespace semcal {
+namespace operators {
+
+/**
+ * @brief SAT-based decomposition operator (case split).
+ * 
+ * Thin wrapper around SatBackend::decompose.
+ */
+class SatDecomposeOp : public DecomposeOp {
+  backends::SatBackend& backend;
+
+public:
+  explicit SatDecomposeOp(backends::SatBackend& b) : backend(b) {}
+
+  util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>
+  apply(const state::SemanticState& σ) override;
+};
+
+} // namespace operators
+} // namespace semcal
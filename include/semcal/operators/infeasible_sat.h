@@ -0,0 +1,24 @@
+#pragma once
+#include "infeasible.h"
+#include "semcal/backends/sat_backend.h"
+
+namespace semcal {
+namespace operators {
+
+/**
+ * @brief SAT-based infeasibility operator (conflict detection).
+ * 
+ * Thin wrapper around SatBackend::refute.
+ */
+class SatInfeasibleOp : public InfeasibleOp {
+  backends::SatBackend& backend;
+
+public:
+  explicit SatInfeasibleOp(backends::SatBackend& b) : backend(b) {}
+
+  util::OpResult<void, InfeasibleWitness>
+  apply(const state::SemanticState& σ) override;
+};
+
+} // namespace operators
+} // namespace semcal
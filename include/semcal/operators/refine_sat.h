@@ -0,0 +1,26 @@
+#pragma once
+#include "refine.h"
+#include "semcal/backends/sat_backend.h"
+
+namespace semcal {
+namespace operators {
+
+/**
+ * @brief SAT-based refinement operator (clause learning).
+ * 
+ * Thin wrapper around SatBackend::refine.
+ */
+class SatRefineOp : public RefineOp {
+  backends::SatBackend& backend;
+
+public:
+  explicit SatRefineOp(backends::SatBackend& b) : backend(b) {}
+
+  util::OpResult<std::unique_ptr<core::Formula>, RefineWitness>
+  apply(const core::Formula& originalFormula,
+        const core::Formula& relaxedFormula,
+        const core::Model& spuriousModel) const override;
+};
+
+} // namespace operators
+} // namespace semcal
@@ -6,6 +6,8 @@
 #include "semcal/domain/abstract_domain.h"
 #include "semcal/core/semantics.h"
 #include "semcal/domain/concretization.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace semcal {
@@ -21,12 +23,34 @@ namespace state {
  * 
  * The concrete meaning is:
  * Conc(σ) = { M ∈ [[F]] ∩ γ(a) | M ⊇ μ }
+ *
+ * States are persistent: the three components are immutable and held
+ * by reference-counted handles, so clone() copies three pointers and a
+ * state derived with withAbstractElement() (or withFormula(),
+ * withPartialModel()) shares the components it does not replace.
+ * To extend μ, copy it, update the copy and derive a state with
+ * withPartialModel().
  */
 class SemanticState {
+public:
+    using FormulaHandle = std::shared_ptr<const core::Formula>;
+    using AbstractElementHandle = std::shared_ptr<const domain::AbstractElement>;
+    using PartialModelHandle = std::shared_ptr<const core::PartialModel>;
+
 private:
-    std::unique_ptr<core::Formula> formula_;
-    std::unique_ptr<domain::AbstractElement> abstractElement_;
-    std::unique_ptr<core::PartialModel> partialModel_;
+    FormulaHandle formula_;
+    AbstractElementHandle abstractElement_;
+    PartialModelHandle partialModel_;
+    // Hash of (F, a), computed on first use (0 = not yet); μ keeps its
+    // own hash. Atomic because shared states are fingerprinted by
+    // several search workers at once.
+    mutable std::atomic<std::uint64_t> componentHash_{0};
+
+    // Not overloaded with the public constructor: unique_ptr arguments
+    // would convert to either signature.
+    struct SharedTag {};
+    SemanticState(SharedTag, FormulaHandle formula, AbstractElementHandle abstractElement,
+                  PartialModelHandle partialModel);
 
 public:
     /**
@@ -40,6 +64,17 @@ public:
         std::unique_ptr<domain::AbstractElement> abstractElement,
         std::unique_ptr<core::PartialModel> partialModel = nullptr);
 
+    /**
+     * @brief Create a semantic state from shared components.
+     * @param formula The constraint formula F
+     * @param abstractElement The abstract element a
+     * @param partialModel The partial model μ (null means empty)
+     */
+    static std::unique_ptr<SemanticState> fromHandles(
+        FormulaHandle formula,
+        AbstractElementHandle abstractElement,
+        PartialModelHandle partialModel = nullptr);
+
     /**
      * @brief Get the formula component.
      * @return Reference to the formula
@@ -58,11 +93,42 @@ public:
      */
     const core::PartialModel& getPartialModel() const { return *partialModel_; }
 
+    const FormulaHandle& getFormulaHandle() const { return formula_; }
+    const AbstractElementHandle& getAbstractElementHandle() const { return abstractElement_; }
+    const PartialModelHandle& getPartialModelHandle() const { return partialModel_; }
+
     /**
-     * @brief Get mutable reference to partial model.
-     * @return Reference to the partial model
+     * @brief Derive a state that differs only in its abstract element.
+     * @param abstractElement The new abstract element
+     * @return New state sharing the formula and partial model
      */
-    core::PartialModel& getPartialModel() { return *partialModel_; }
+    std::unique_ptr<SemanticState> withAbstractElement(AbstractElementHandle abstractElement) const;
+
+    /**
+     * @brief Derive a state that differs only in its formula.
+     */
+    std::unique_ptr<SemanticState> withFormula(FormulaHandle formula) const;
+
+    /**
+     * @brief Derive a state that differs only in its partial model.
+     */
+    std::unique_ptr<SemanticState> withPartialModel(PartialModelHandle partialModel) const;
+
+    /**
+     * @brief Enumerate the concrete meaning of this state lazily.
+     *
+     * Streams [[F]] and keeps the models in γ(a) that extend μ; γ(a)
+     * is tested through Concretization::membership(). The stream shares
+     * F, a and μ with this state but refers to the semantics and
+     * concretization, which must outlive it.
+     *
+     * @param semantics The semantic interpretation function
+     * @param concretization The concretization function
+     * @return A stream over Conc(σ)
+     */
+    std::unique_ptr<core::ModelStream> models(
+        const core::Semantics& semantics,
+        const domain::Concretization& concretization) const;
 
     /**
      * @brief Compute the concrete meaning of this state.
@@ -79,6 +145,9 @@ public:
 
     /**
      * @brief Check if the state is empty (has no models).
+     *
+     * Stops at the first model of Conc(σ).
+     *
      * @param semantics The semantic interpretation function
      * @param concretization The concretization function
      * @return true if Conc(σ) = ∅
@@ -87,6 +156,29 @@ public:
         const core::Semantics& semantics,
         const domain::Concretization& concretization) const;
 
+    /**
+     * @brief Get a hash of the state for cheap identity checks.
+     *
+     * Combines the hashes of F, a and μ. The part for F and a is
+     * computed once per state; the partial model maintains its hash
+     * incrementally, so this stays O(1) after the first call.
+     *
+     * @return 64-bit fingerprint
+     */
+    std::uint64_t fingerprint() const;
+
+    /**
+     * @brief Check if two states have equal components.
+     *
+     * Compares fingerprints first, then shared handles, and only then
+     * the components themselves (formula roots, equals() on abstract
+     * elements, assignments).
+     *
+     * @param other The other state
+     * @return true if both states are the same triple
+     */
+    bool sameAs(const SemanticState& other) const;
+
     /**
      * @brief Get a string representation.
      * @return String representation
@@ -95,6 +187,9 @@ public:
 
     /**
      * @brief Clone the semantic state.
+     *
+     * O(1): the copy shares all components with this state.
+     *
      * @return A new copy
      */
     std::unique_ptr<SemanticState> clone() const;
@@ -0,0 +1,215 @@
+#pragma once
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SEMCAL_INTERVAL_SSE2 1
+#endif
+
+namespace semcal {
+namespace util {
+
+/**
+ * @brief Double interval tuned for interval constraint propagation.
+ *
+ * The lower bound is stored negated, (−lo, hi), so both bounds round
+ * in the same direction: every operation computes the pair in round-
+ * to-nearest and then moves both components one ulp up, which widens
+ * the interval outward. This keeps the results sound without switching
+ * the FPU rounding mode, and lets one SSE2 instruction process both
+ * bounds. A scalar fallback is used when SSE2 is unavailable.
+ *
+ * An interval with lo > hi is empty. 0 · ∞ is taken as 0.
+ */
+struct alignas(16) FastInterval {
+  double negLo;
+  double hi;
+
+  static constexpr double kInf = std::numeric_limits<double>::infinity();
+
+  static FastInterval make(double lo, double hi) { return FastInterval{-lo, hi}; }
+  static FastInterval point(double v) { return FastInterval{-v, v}; }
+  static FastInterval entire() { return FastInterval{kInf, kInf}; }
+  static FastInterval empty() { return FastInterval{-kInf, -kInf}; }
+
+  double lo() const { return -negLo; }
+  bool isEmpty() const { return -negLo > hi; }
+  bool contains(double v) const { return -negLo <= v && v <= hi; }
+  bool isPositive() const { return -negLo > 0; }
+  bool isNegative() const { return hi < 0; }
+};
+
+namespace interval {
+
+#ifdef SEMCAL_INTERVAL_SSE2
+
+inline __m128d load(const FastInterval& a) { return _mm_load_pd(&a.negLo); }
+inline FastInterval store(__m128d v) {
+  FastInterval r;
+  _mm_store_pd(&r.negLo, v);
+  return r;
+}
+
+// Next double toward +∞ in both lanes (±∞ and NaN unchanged, ±0 → 2⁻¹⁰⁷⁴).
+inline __m128d nextUp(__m128d v) {
+  const __m128i one = _mm_set1_epi64x(1);
+  __m128i bits = _mm_castpd_si128(v);
+  __m128i negative = _mm_castpd_si128(_mm_cmplt_pd(v, _mm_setzero_pd()));
+  __m128i stepped = _mm_add_epi64(bits, _mm_add_epi64(one, _mm_add_epi64(negative, negative)));
+  __m128i zero = _mm_castpd_si128(_mm_cmpeq_pd(v, _mm_setzero_pd()));
+  stepped = _mm_or_si128(_mm_andnot_si128(zero, stepped), _mm_and_si128(zero, one));
+  __m128i keep = _mm_castpd_si128(_mm_or_pd(_mm_cmpunord_pd(v, v),
+                                            _mm_cmpeq_pd(v, _mm_set1_pd(FastInterval::kInf))));
+  return _mm_castsi128_pd(_mm_or_si128(_mm_andnot_si128(keep, stepped), _mm_and_si128(keep, bits)));
+}
+
+// (−lo, hi) → (lo, hi)
+inline __m128d bounds(__m128d v) {
+  return _mm_xor_pd(v, _mm_set_pd(0.0, -0.0));
+}
+
+inline FastInterval add(const FastInterval& a, const FastInterval& b) {
+  return store(nextUp(_mm_add_pd(load(a), load(b))));
+}
+
+inline FastInterval sub(const FastInterval& a, const FastInterval& b) {
+  // a − b = [lo_a − hi_b, hi_a − lo_b]: add b with its bounds swapped
+  __m128d vb = load(b);
+  return store(nextUp(_mm_add_pd(load(a), _mm_shuffle_pd(vb, vb, 1))));
+}
+
+inline FastInterval neg(const FastInterval& a) {
+  __m128d va = load(a);
+  return store(_mm_shuffle_pd(va, va, 1));
+}
+
+inline FastInterval mul(const FastInterval& a, const FastInterval& b) {
+  __m128d ba = bounds(load(a));
+  __m128d bb = bounds(load(b));
+  __m128d p = _mm_mul_pd(_mm_unpacklo_pd(ba, ba), bb);  // lo_a·lo_b, lo_a·hi_b
+  __m128d q = _mm_mul_pd(_mm_unpackhi_pd(ba, ba), bb);  // hi_a·lo_b, hi_a·hi_b
+  p = _mm_andnot_pd(_mm_cmpunord_pd(p, p), p);          // 0·∞ = 0
+  q = _mm_andnot_pd(_mm_cmpunord_pd(q, q), q);
+  __m128d mn = _mm_min_pd(p, q);
+  __m128d mx = _mm_max_pd(p, q);
+  mn = _mm_min_pd(mn, _mm_shuffle_pd(mn, mn, 1));
+  mx = _mm_max_pd(mx, _mm_shuffle_pd(mx, mx, 1));
+  // (−min, max)
+  __m128d r = _mm_unpacklo_pd(_mm_xor_pd(mn, _mm_set1_pd(-0.0)), mx);
+  return store(nextUp(r));
+}
+
+// [1/hi, 1/lo] for an interval not containing 0
+inline FastInterval reciprocal(const FastInterval& b) {
+  __m128d vb = bounds(load(b));
+  __m128d swapped = _mm_shuffle_pd(vb, vb, 1);  // (hi, lo)
+  return store(nextUp(_mm_div_pd(_mm_set_pd(1.0, -1.0), swapped)));
+}
+
+inline FastInterval meet(const FastInterval& a, const FastInterval& b) {
+  return store(_mm_min_pd(load(a), load(b)));
+}
+
+inline FastInterval hull(const FastInterval& a, const FastInterval& b) {
+  return store(_mm_max_pd(load(a), load(b)));
+}
+
+#else
+
+inline double nextUp(double x) { return std::nextafter(x, FastInterval::kInf); }
+
+inline double product(double x, double y) {
+  double p = x * y;
+  return p != p ? 0.0 : p;
+}
+
+inline FastInterval add(const FastInterval& a, const FastInterval& b) {
+  return FastInterval{nextUp(a.negLo + b.negLo), nextUp(a.hi + b.hi)};
+}
+
+inline FastInterval sub(const FastInterval& a, const FastInterval& b) {
+  return FastInterval{nextUp(a.negLo + b.hi), nextUp(a.hi + b.negLo)};
+}
+
+inline FastInterval neg(const FastInterval& a) {
+  return FastInterval{a.hi, a.negLo};
+}
+
+inline FastInterval mul(const FastInterval& a, const FastInterval& b) {
+  double alo = a.lo(), blo = b.lo();
+  double p1 = product(alo, blo), p2 = product(alo, b.hi);
+  double p3 = product(a.hi, blo), p4 = product(a.hi, b.hi);
+  double mn = std::fmin(std::fmin(p1, p2), std::fmin(p3, p4));
+  double mx = std::fmax(std::fmax(p1, p2), std::fmax(p3, p4));
+  return FastInterval{nextUp(-mn), nextUp(mx)};
+}
+
+inline FastInterval reciprocal(const FastInterval& b) {
+  return FastInterval{nextUp(-1.0 / b.hi), nextUp(1.0 / b.lo())};
+}
+
+inline FastInterval meet(const FastInterval& a, const FastInterval& b) {
+  return FastInterval{std::fmin(a.negLo, b.negLo), std::fmin(a.hi, b.hi)};
+}
+
+inline FastInterval hull(const FastInterval& a, const FastInterval& b) {
+  return FastInterval{std::fmax(a.negLo, b.negLo), std::fmax(a.hi, b.hi)};
+}
+
+#endif
+
+inline double nextUpScalar(double x) { return std::nextafter(x, FastInterval::kInf); }
+inline double nextDownScalar(double x) { return std::nextafter(x, -FastInterval::kInf); }
+
+/**
+ * @brief a / b; the entire line when b contains 0.
+ */
+inline FastInterval div(const FastInterval& a, const FastInterval& b) {
+  if (!b.isPositive() && !b.isNegative()) {
+    return FastInterval::entire();
+  }
+  return mul(a, reciprocal(b));
+}
+
+/**
+ * @brief a², tighter than mul(a, a) when a contains 0.
+ */
+inline FastInterval sqr(const FastInterval& a) {
+  double lo = a.lo();
+  double hi = a.hi;
+  if (lo >= 0) {
+    return FastInterval{nextUpScalar(-(lo * lo)), nextUpScalar(hi * hi)};
+  }
+  if (hi <= 0) {
+    return FastInterval{nextUpScalar(-(hi * hi)), nextUpScalar(lo * lo)};
+  }
+  double m = std::fmax(-lo, hi);
+  return FastInterval{0.0, nextUpScalar(m * m)};
+}
+
+/**
+ * @brief Hull of { x ∈ a | x² ∈ s } (backward projection of sqr).
+ */
+inline FastInterval sqrtProject(const FastInterval& s, const FastInterval& a) {
+  double shi = s.hi;
+  if (shi < 0) {
+    return FastInterval::empty();
+  }
+  double slo = std::fmax(s.lo(), 0.0);
+  double rhi = nextUpScalar(std::sqrt(shi));
+  double rlo = slo > 0 ? nextDownScalar(std::sqrt(slo)) : 0.0;
+  if (rlo < 0) rlo = 0.0;
+  FastInterval pos = FastInterval::make(rlo, rhi);
+  FastInterval negPart = FastInterval::make(-rhi, -rlo);
+  FastInterval p = meet(pos, a);
+  FastInterval n = meet(negPart, a);
+  if (p.isEmpty()) return n;
+  if (n.isEmpty()) return p;
+  return hull(p, n);
+}
+
+} // namespace interval
+
+} // namespace util
+} // namespace semcal
@@ -53,6 +53,9 @@ struct OpResult {
   OpStatus status;
   std::optional<T> value;
   Witness witness;
+  // false when the operator returned its input unchanged (e.g. a
+  // decomposition with a single piece equal to the state)
+  bool progress = true;
 
   static OpResult<T, Witness> ok(T v) {
     return {OpStatus::OK, std::move(v), {}};
@@ -66,6 +69,10 @@ struct OpResult {
     return {OpStatus::UNKNOWN, std::nullopt, {}};
   }
 
+  static OpResult<T, Witness> noProgress(T v) {
+    return {OpStatus::OK, std::move(v), {}, false};
+  }
+
   static OpResult<T, Witness> partial(T v) {
     return {OpStatus::PARTIAL, std::move(v), {}};
   }
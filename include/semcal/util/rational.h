@@ -0,0 +1,179 @@
+#ifndef SEMCAL_UTIL_RATIONAL_H
+#define SEMCAL_UTIL_RATIONAL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SIZEOF_INT128__)
+#define SEMCAL_HAVE_INT128 1
+#endif
+
+namespace semcal {
+namespace util {
+
+#ifdef SEMCAL_HAVE_INT128
+__extension__ typedef __int128 Int128;
+__extension__ typedef unsigned __int128 UInt128;
+#endif
+
+/**
+ * @brief Arbitrary-precision signed integer.
+ *
+ * Sign-magnitude representation over 32-bit limbs. Only used on the
+ * slow path of Rational, so it favors simplicity over speed.
+ */
+class BigInt {
+private:
+    bool negative_ = false;
+    std::vector<std::uint32_t> mag_;  // little-endian, no leading zero limbs
+
+    void trim();
+
+public:
+    BigInt() = default;
+    BigInt(std::int64_t v);  // NOLINT: implicit by design
+#ifdef SEMCAL_HAVE_INT128
+    static BigInt fromInt128(Int128 v);
+#endif
+
+    /**
+     * @brief Parse an optionally signed decimal integer.
+     * @return false if the text is not a decimal integer
+     */
+    static bool parse(std::string_view text, BigInt& out);
+
+    bool isZero() const { return mag_.empty(); }
+    int sign() const { return isZero() ? 0 : (negative_ ? -1 : 1); }
+    bool fitsInt64() const;
+    std::int64_t toInt64() const;  // requires fitsInt64()
+    double toDouble() const;
+    std::string toString() const;
+    std::uint64_t hash() const;
+
+    BigInt operator-() const;
+    BigInt abs() const;
+
+    friend BigInt operator+(const BigInt& a, const BigInt& b);
+    friend BigInt operator-(const BigInt& a, const BigInt& b);
+    friend BigInt operator*(const BigInt& a, const BigInt& b);
+
+    /**
+     * @brief Truncating division: a = q * b + r with |r| < |b|, sign(r) = sign(a).
+     */
+    static void divMod(const BigInt& a, const BigInt& b, BigInt& q, BigInt& r);
+    static BigInt gcd(BigInt a, BigInt b);
+    static int compare(const BigInt& a, const BigInt& b);
+
+    friend bool operator==(const BigInt& a, const BigInt& b) {
+        return a.negative_ == b.negative_ && a.mag_ == b.mag_;
+    }
+    friend bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
+    friend bool operator<(const BigInt& a, const BigInt& b) { return compare(a, b) < 0; }
+};
+
+/**
+ * @brief Exact rational number with a machine-word fast path.
+ *
+ * Values whose normalized numerator and denominator fit in int64 are
+ * stored inline and combined with 128-bit intermediates; results that
+ * overflow are promoted to BigInt and demoted again when they shrink.
+ * Always normalized: gcd(num, den) = 1 and den > 0.
+ */
+class Rational {
+private:
+    struct Big {
+        BigInt num;
+        BigInt den;
+    };
+
+    std::int64_t num_ = 0;
+    std::int64_t den_ = 1;
+    std::shared_ptr<const Big> big_;  // non-null on the slow path (immutable, shared)
+
+    static Rational fromBig(BigInt num, BigInt den);
+#ifdef SEMCAL_HAVE_INT128
+    static Rational fromWide(Int128 num, Int128 den);
+#endif
+    BigInt bigNum() const;
+    BigInt bigDen() const;
+
+public:
+    Rational() = default;
+    Rational(std::int64_t v) : num_(v) {  // NOLINT: implicit by design
+        if (v == INT64_MIN) {
+            *this = fromBig(BigInt(v), BigInt(1));
+        }
+    }
+
+    /**
+     * @brief Create num/den (den != 0).
+     */
+    static Rational fraction(std::int64_t num, std::int64_t den);
+    static Rational fraction(const BigInt& num, const BigInt& den);
+
+    /**
+     * @brief Parse an integer, fraction "a/b" or decimal "1.25".
+     * @return false if the text is not a number
+     */
+    static bool parse(std::string_view text, Rational& out);
+
+    bool isSmall() const { return !big_; }
+    bool isZero() const { return !big_ && num_ == 0; }
+    bool isInteger() const { return big_ ? big_->den == BigInt(1) : den_ == 1; }
+    int sign() const;
+
+    /**
+     * @brief Get the numerator/denominator (only valid when isSmall()).
+     */
+    std::int64_t smallNum() const { return num_; }
+    std::int64_t smallDen() const { return den_; }
+
+    BigInt numerator() const { return bigNum(); }
+    BigInt denominator() const { return bigDen(); }
+
+    double toDouble() const;
+
+    /**
+     * @brief Greatest double <= value / least double >= value.
+     *
+     * Used for outward rounding of interval bounds. Values outside the
+     * double range round to +-infinity (or +-DBL_MAX on the bounded side).
+     */
+    double toDoubleDown() const;
+    double toDoubleUp() const;
+
+    /**
+     * @brief Exact value of a finite double.
+     */
+    static Rational fromDouble(double d);
+
+    std::string toString() const;
+    std::uint64_t hash() const;
+
+    Rational operator-() const;
+    friend Rational operator+(const Rational& a, const Rational& b);
+    friend Rational operator-(const Rational& a, const Rational& b);
+    friend Rational operator*(const Rational& a, const Rational& b);
+    friend Rational operator/(const Rational& a, const Rational& b);  // b != 0
+
+    Rational& operator+=(const Rational& o) { return *this = *this + o; }
+    Rational& operator-=(const Rational& o) { return *this = *this - o; }
+    Rational& operator*=(const Rational& o) { return *this = *this * o; }
+    Rational& operator/=(const Rational& o) { return *this = *this / o; }
+
+    static int compare(const Rational& a, const Rational& b);
+    friend bool operator==(const Rational& a, const Rational& b) { return compare(a, b) == 0; }
+    friend bool operator!=(const Rational& a, const Rational& b) { return compare(a, b) != 0; }
+    friend bool operator<(const Rational& a, const Rational& b) { return compare(a, b) < 0; }
+    friend bool operator<=(const Rational& a, const Rational& b) { return compare(a, b) <= 0; }
+    friend bool operator>(const Rational& a, const Rational& b) { return compare(a, b) > 0; }
+    friend bool operator>=(const Rational& a, const Rational& b) { return compare(a, b) >= 0; }
+};
+
+} // namespace util
+} // namespace semcal
+
+#endif // SEMCAL_UTIL_RATIONAL_H
@@ -0,0 +1,62 @@
+#ifndef SEMCAL_KERNEL_FARKAS_CHECKER_H
+#define SEMCAL_KERNEL_FARKAS_CHECKER_H
+
+#include "semcal/state/semantic_state.h"
+#include <string>
+#include <utility>
+
+namespace semcal {
+namespace kernel {
+
+/**
+ * @brief Exact checker for the Farkas certificates of LP refutations.
+ *
+ * A certificate such as
+ *   (farkas (row 0 upper 1) (row 1 lower 1/2) (box x upper 2))
+ * names bounds of σ = (F, a, μ) and a multiplier λ ≥ 0 for each:
+ * - row i: row i of F.getLinearSystem()
+ * - box x: a finite bound of x in a, if a is an IntervalBox
+ * - model x: the numeric value of x in μ (usable as either bound)
+ * Every bound is written in ≤-form (Σ cᵢxᵢ ≤ u, or −Σ cᵢxᵢ ≤ −l for a
+ * lower bound) and scaled by λ. The certificate is accepted iff the
+ * variables cancel and the sum reads 0 ≤ c with c < 0, so Conc(σ) = ∅.
+ *
+ * The checker re-derives every bound from σ itself and never trusts the
+ * producer; labels it cannot justify (e.g. "box x" when σ's box leaves
+ * x unbounded) are rejected. The rows are the formula's cached
+ * CSR system, shared with the LP backend, and checking is one pass over
+ * the named bounds: multipliers are scaled to integers and summed in 128-bit
+ * integers when everything fits, with util::Rational as the fallback.
+ */
+class FarkasChecker {
+public:
+    /**
+     * @brief Check that a certificate refutes a state.
+     * @return true if the certificate proves Conc(σ) = ∅
+     */
+    bool check(const state::SemanticState& σ, const std::string& certificate);
+
+    /**
+     * @brief Why the last check() failed (empty after success).
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @brief Whether the last check() summed in 128-bit integers.
+     */
+    bool usedFastPath() const { return fastPath_; }
+
+private:
+    std::string error_;
+    bool fastPath_ = false;
+
+    bool fail(std::string reason) {
+        error_ = std::move(reason);
+        return false;
+    }
+};
+
+} // namespace kernel
+} // namespace semcal
+
+#endif // SEMCAL_KERNEL_FARKAS_CHECKER_H
@@ -85,6 +85,11 @@ public:
    * @brief Check a refutation claim.
    * 
    * Validates: Conc(σ) = ∅
+   *
+   * Evidence of type "farkas" (the certificate of LpInfeasibleOp) is
+   * checked exactly with FarkasChecker. Evidence of type "lrat" (a
+   * binary LRAT proof) or "lrat-file" (the path of one, as named by
+   * SatUnsatWitness::proofFile) is streamed through LratChecker.
    * 
    * @param state The semantic state to check
    * @param evidence Evidence for the refutation
@@ -0,0 +1,123 @@
+#ifndef SEMCAL_KERNEL_LRAT_CHECKER_H
+#define SEMCAL_KERNEL_LRAT_CHECKER_H
+
+#include "semcal/core/clause_arena.h"
+#include "semcal/state/semantic_state.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace semcal {
+namespace kernel {
+
+/**
+ * @brief Streaming checker for binary LRAT refutations of SAT states.
+ *
+ * The proof refers to the clauses of the CNF of F as numbered by
+ * core::CnfEncoder (ids 1 .. m) and is read in the binary LRAT format
+ * written by backends::LratWriter:
+ *   a <id> <literals> 0 <hints> 0    add a clause
+ *   d <ids> 0                        delete clauses
+ * Each addition is checked by reverse unit propagation driven by its
+ * hints: with the new clause assumed false, every hint must become unit
+ * (its literal is then set) until one is falsified. Hints are never
+ * searched for, so checking is a single forward pass in time linear in
+ * the size of the proof plus the clauses it cites. RAT steps (negative
+ * hints) are rejected.
+ *
+ * The proof refutes σ = (F, a, μ) once it derives a clause whose
+ * literals are all false under the Boolean values of μ: the empty
+ * clause, or the final conflict of a solve under assumptions.
+ *
+ * Proofs are fed in chunks, steps may span chunk boundaries, and only
+ * the live clauses are kept: deleted clauses are dropped and their
+ * memory reclaimed, so a file-backed proof of any length is checked in
+ * memory proportional to the largest live clause set.
+ */
+class LratChecker {
+public:
+    /**
+     * @brief Start a check against σ: load the clauses of F and μ.
+     * @return true (the CNF of any formula can be loaded)
+     */
+    bool begin(const state::SemanticState& σ);
+
+    /**
+     * @brief Check the next bytes of the proof.
+     * @return false as soon as a step fails
+     */
+    bool feed(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief End the proof.
+     * @return true if every step checked and one of them refutes σ
+     */
+    bool finish();
+
+    /**
+     * @brief Check a proof held in memory.
+     */
+    bool check(const state::SemanticState& σ, const std::string& proof);
+
+    /**
+     * @brief Check a proof file, reading it in fixed-size chunks.
+     */
+    bool checkFile(const state::SemanticState& σ, const std::string& path);
+
+    /**
+     * @brief Why the check failed (empty while it has not).
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @brief Number of additions checked so far.
+     */
+    std::uint64_t getSteps() const { return steps_; }
+
+private:
+    struct Slot {
+        std::size_t offset;
+        std::uint32_t size;
+    };
+    std::vector<core::Lit> literals_;                  // live clauses (and garbage)
+    std::unordered_map<std::uint64_t, Slot> clauses_;  // id -> clause
+    std::size_t garbage_ = 0;                          // literals of deleted clauses
+
+    std::vector<std::int8_t> values_;      // per literal, during one step
+    std::vector<core::Lit> assigned_;      // literals set true in this step
+    std::vector<std::uint8_t> falsified_;  // per literal: false under μ
+
+    enum class Mode { Step, Id, Literals, Hints, Delete };
+    Mode mode_ = Mode::Step;
+    std::uint64_t number_ = 0;  // varint being read
+    unsigned shift_ = 0;
+    std::uint64_t id_ = 0;
+    std::vector<core::Lit> lits_;
+    std::vector<std::uint64_t> hints_;
+
+    bool refuted_ = false;
+    std::uint64_t steps_ = 0;
+    std::string error_;
+
+    bool number(std::uint64_t x);
+    bool addStep();
+    bool propagate();
+    void store(std::uint64_t id, const core::Lit* lits, std::size_t count);
+    bool remove(std::uint64_t id);
+    void ensureVariables(std::uint32_t count);
+
+    bool fail(std::string reason) {
+        if (error_.empty()) {
+            error_ = std::move(reason);
+        }
+        return false;
+    }
+};
+
+} // namespace kernel
+} // namespace semcal
+
+#endif // SEMCAL_KERNEL_LRAT_CHECKER_H
@@ -0,0 +1,187 @@
+#pragma once
+#include "semcal/state/semantic_state.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace semcal {
+namespace search {
+
+/**
+ * @brief Heuristic for best-first search: lower values are expanded first.
+ */
+using Heuristic = std::function<double(const state::SemanticState&)>;
+
+/**
+ * @brief Container of the states that remain to be explored.
+ *
+ * The frontier alone decides the exploration order; the engine and the
+ * strategies only push and pop.
+ */
+class Frontier {
+public:
+  virtual ~Frontier() = default;
+
+  virtual void push(std::unique_ptr<state::SemanticState> state) = 0;
+
+  /**
+   * @brief Remove the next state to explore.
+   * @return The state, or nullptr if the frontier is empty
+   */
+  virtual std::unique_ptr<state::SemanticState> pop() = 0;
+
+  virtual size_t size() const = 0;
+  virtual void clear() = 0;
+  bool empty() const { return size() == 0; }
+};
+
+/**
+ * @brief LIFO frontier (depth-first).
+ *
+ * Memory stays linear in depth times branching factor.
+ */
+class StackFrontier : public Frontier {
+private:
+  std::vector<std::unique_ptr<state::SemanticState>> stack_;
+
+public:
+  void push(std::unique_ptr<state::SemanticState> state) override;
+  std::unique_ptr<state::SemanticState> pop() override;
+  size_t size() const override { return stack_.size(); }
+  void clear() override { stack_.clear(); }
+};
+
+/**
+ * @brief FIFO frontier (breadth-first).
+ */
+class FifoFrontier : public Frontier {
+private:
+  std::deque<std::unique_ptr<state::SemanticState>> queue_;
+
+public:
+  void push(std::unique_ptr<state::SemanticState> state) override;
+  std::unique_ptr<state::SemanticState> pop() override;
+  size_t size() const override { return queue_.size(); }
+  void clear() override { queue_.clear(); }
+};
+
+/**
+ * @brief Priority frontier (best-first) over an indexed d-ary heap.
+ *
+ * The heuristic is evaluated once per state, when it is pushed, and
+ * the priority is cached with the entry. Equal priorities are served
+ * in insertion order. Entries are addressed by handles so a priority
+ * can be changed in place (decrease-key or increase-key) without
+ * re-inserting the state.
+ *
+ * With a capacity set, the frontier keeps only the best entries: a
+ * push into a full frontier evicts the worst entry (or drops the new
+ * state if it is no better). The worst entry is tracked by a second
+ * heap over the same entries, so eviction costs O(log n).
+ */
+class BestFirstFrontier : public Frontier {
+public:
+  /**
+   * @brief Handle of an entry, valid until the entry is popped or evicted.
+   */
+  using Handle = uint32_t;
+  static constexpr Handle kNoHandle = UINT32_MAX;
+
+  static constexpr size_t kArity = 4;
+
+  /**
+   * @param heuristic Priority function (lower is explored first)
+   * @param capacity Maximum number of entries (0 = unbounded)
+   */
+  explicit BestFirstFrontier(Heuristic heuristic = nullptr, size_t capacity = 0);
+
+  /**
+   * @brief Push a state, computing its priority with the heuristic
+   * (priority 0 when there is none).
+   */
+  void push(std::unique_ptr<state::SemanticState> state) override;
+
+  /**
+   * @brief Push a state with an explicit priority.
+   * @return Handle of the new entry, or kNoHandle if the frontier is
+   * full and the state was dropped
+   */
+  Handle push(std::unique_ptr<state::SemanticState> state, double priority);
+
+  std::unique_ptr<state::SemanticState> pop() override;
+
+  /**
+   * @brief Get the state that pop() would return, without removing it.
+   */
+  const state::SemanticState* top() const;
+  double topPriority() const;
+
+  /**
+   * @brief Change the priority of an entry.
+   */
+  void updatePriority(Handle handle, double priority);
+  double getPriority(Handle handle) const { return entries_[handle].priority; }
+
+  /**
+   * @brief Bound the number of entries, evicting the worst ones if
+   * needed (0 = unbounded).
+   */
+  void setCapacity(size_t capacity);
+  size_t getCapacity() const { return capacity_; }
+
+  /**
+   * @brief Number of states evicted or dropped because of the capacity.
+   */
+  uint64_t getEvictedCount() const { return evicted_; }
+
+  size_t size() const override { return heap_.size(); }
+  void clear() override;
+
+private:
+  struct Entry {
+    double priority;
+    uint64_t sequence;  // tie-breaker: insertion order
+    std::unique_ptr<state::SemanticState> state;
+    size_t position[2]; // index in heap_ and in worstHeap_
+  };
+
+  // Heap selectors: kBest orders best-first, kWorst worst-first.
+  static constexpr int kBest = 0;
+  static constexpr int kWorst = 1;
+
+  Heuristic heuristic_;
+  size_t capacity_;
+  std::vector<Entry> entries_;  // slots addressed by Handle
+  std::vector<Handle> freeSlots_;
+  std::vector<Handle> heap_;
+  std::vector<Handle> worstHeap_;  // maintained only when bounded
+  uint64_t nextSequence_ = 0;
+  uint64_t evicted_ = 0;
+
+  bool before(Handle a, Handle b) const {
+    const Entry& x = entries_[a];
+    const Entry& y = entries_[b];
+    return x.priority < y.priority || (x.priority == y.priority && x.sequence < y.sequence);
+  }
+  bool bounded() const { return capacity_ != 0; }
+  std::vector<Handle>& heapFor(int which) { return which == kBest ? heap_ : worstHeap_; }
+  bool precedes(int which, Handle a, Handle b) const {
+    return which == kBest ? before(a, b) : before(b, a);
+  }
+  void place(int which, size_t position, Handle handle) {
+    heapFor(which)[position] = handle;
+    entries_[handle].position[which] = position;
+  }
+  void insert(int which, Handle handle);
+  void removeAt(int which, size_t position);
+  void siftUp(int which, size_t position);
+  void siftDown(int which, size_t position);
+  void release(Handle handle);
+  void evictWorst();
+};
+
+} // namespace search
+} // namespace semcal
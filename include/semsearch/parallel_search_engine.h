@@ -0,0 +1,120 @@
+#pragma once
+#include "semsearch/search_engine.h"
+#include "semsearch/work_stealing_deque.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace semcal {
+namespace search {
+
+/**
+ * @brief Multi-threaded SearchEngine based on work stealing.
+ *
+ * execute() runs N workers (the calling thread is worker 0). Each
+ * worker owns a Chase-Lev deque: states pushed by the strategy from a
+ * worker go to that worker's deque and are explored depth-first, while
+ * an idle worker steals the oldest state of a randomly chosen victim.
+ * The first SAT or UNSAT returned by any worker raises a termination
+ * flag that every worker checks between states; the search ends with
+ * UNKNOWN once no state is queued or being processed. States pushed
+ * from other threads during execute() go to a shared queue that idle
+ * workers drain before they steal. A worker that finds nothing to do
+ * spins for a few rounds and then parks on a condition variable until
+ * a state is pushed or the search ends, so a narrow frontier does not
+ * keep every core busy.
+ *
+ * An exception thrown by the strategy stops the search; execute()
+ * rethrows the first one once every worker has joined.
+ *
+ * The strategy is called concurrently from several threads and must be
+ * safe to do so. The search policy is ignored: exploration order is
+ * decided by the deques.
+ */
+class ParallelSearchEngine : public SearchEngine {
+public:
+  /**
+   * @brief Construct a parallel engine.
+   * @param numThreads Number of workers (0 = hardware concurrency)
+   */
+  explicit ParallelSearchEngine(size_t numThreads = 0);
+  ~ParallelSearchEngine() override;
+
+  SearchResult execute(
+      const state::SemanticState& initialState,
+      std::function<SearchResult(state::SemanticState&)> strategy,
+      SearchPolicy policy = SearchPolicy::DFS) override;
+
+  /**
+   * @brief Push a state; goes to the calling worker's deque, or to a
+   * shared queue when called outside a worker.
+   */
+  void pushState(std::unique_ptr<state::SemanticState> state) override;
+
+  /**
+   * @brief Pop a state from the calling worker's deque (the shared
+   * queue outside a worker). Does not steal.
+   */
+  std::unique_ptr<state::SemanticState> popState() override;
+
+  /**
+   * @brief Whether no state is queued or being processed.
+   */
+  bool isEmpty() const override;
+  size_t size() const override;
+
+  /**
+   * @brief Drop all queued states. Not to be called during execute().
+   */
+  void clear() override;
+
+  size_t getNumThreads() const { return workers_.size(); }
+
+  /**
+   * @brief Number of successful steals during the last execute().
+   */
+  uint64_t getStealCount() const;
+
+private:
+  struct Worker {
+    WorkStealingDeque deque;
+    uint64_t rng;
+    std::atomic<uint64_t> steals{0};
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::unique_ptr<state::SemanticState>> external_;  // pushed outside workers
+  mutable std::mutex externalMutex_;
+  std::atomic<size_t> externalSize_{0};  // external_.size(), read without the lock
+
+  std::exception_ptr error_;  // first exception thrown by the strategy
+  std::mutex errorMutex_;
+
+  // States queued or being processed; 0 means the search is exhausted.
+  std::atomic<size_t> pending_{0};
+  std::atomic<bool> done_{false};
+  std::atomic<int> result_{static_cast<int>(SearchResult::UNKNOWN)};
+  std::function<SearchResult(state::SemanticState&)> strategy_;
+
+  // Parking of idle workers
+  std::mutex parkMutex_;
+  std::condition_variable parkCv_;
+  std::atomic<size_t> parked_{0};
+  uint64_t wakeups_ = 0;  // guarded by parkMutex_
+
+  void runWorker(size_t index);
+  void park();
+  void wakeOne();
+  void wakeAll();
+  bool hasQueuedWork() const;
+  std::unique_ptr<state::SemanticState> stealFor(size_t thief);
+  std::unique_ptr<state::SemanticState> takeExternal();
+  Worker* currentWorker() const;
+};
+
+} // namespace search
+} // namespace semcal
@@ -1,9 +1,9 @@
 #pragma once
 #include "semcal/state/semantic_state.h"
+#include "semsearch/frontier.h"
 #include <vector>
 #include <memory>
 #include <functional>
-#include <queue>
 
 namespace semcal {
 namespace search {
@@ -91,16 +91,42 @@ public:
   virtual void clear() = 0;
 };
 
+/**
+ * @brief Create the frontier implementing a search policy.
+ *
+ * DFS uses a stack, BFS a FIFO queue and BEST_FIRST a priority heap
+ * ordered by the heuristic (insertion order when there is none).
+ */
+std::unique_ptr<Frontier> makeFrontier(SearchPolicy policy, Heuristic heuristic = nullptr);
+
 /**
  * @brief Default implementation of SearchEngine.
+ *
+ * The frontier is chosen by the search policy (see makeFrontier).
  */
 class DefaultSearchEngine : public SearchEngine {
 private:
-  std::queue<std::unique_ptr<state::SemanticState>> stateQueue_;
+  std::unique_ptr<Frontier> frontier_;
   SearchPolicy currentPolicy_;
+  Heuristic heuristic_;
 
 public:
-  DefaultSearchEngine(SearchPolicy policy = SearchPolicy::DFS);
+  DefaultSearchEngine(SearchPolicy policy = SearchPolicy::DFS, Heuristic heuristic = nullptr);
+
+  /**
+   * @brief Set the heuristic used by best-first search.
+   *
+   * Takes effect on the next execute() or setPolicy().
+   *
+   * @param heuristic Priority function (lower is explored first)
+   */
+  void setHeuristic(Heuristic heuristic) { heuristic_ = std::move(heuristic); }
+
+  /**
+   * @brief Switch policy; discards the current frontier.
+   */
+  void setPolicy(SearchPolicy policy);
+  SearchPolicy getPolicy() const { return currentPolicy_; }
 
   SearchResult execute(
       const state::SemanticState& initialState,
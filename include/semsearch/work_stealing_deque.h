@@ -0,0 +1,95 @@
+#pragma once
+#include "semcal/state/semantic_state.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace semcal {
+namespace search {
+
+/**
+ * @brief Chase-Lev work-stealing deque of semantic states.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO); any other
+ * thread may steal from the top (FIFO), so thieves take the oldest,
+ * typically largest, pieces of work. Push and pop are wait-free in the
+ * common case; only the race for the last element and steals use a CAS.
+ * The buffer grows on demand; retired buffers are kept until the deque
+ * is destroyed because a concurrent thief may still read them.
+ *
+ * Memory orderings follow Lê, Pop, Cohen and Zappa Nardelli,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP'13).
+ *
+ * The deque stores owning raw pointers: a state handed out by pop() or
+ * steal() belongs to the caller, and states left over on destruction
+ * are deleted.
+ */
+class WorkStealingDeque {
+public:
+  explicit WorkStealingDeque(size_t initialCapacity = 64);
+  ~WorkStealingDeque();
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * @brief Push a state at the bottom. Owner thread only.
+   */
+  void push(std::unique_ptr<state::SemanticState> state);
+
+  /**
+   * @brief Pop the most recently pushed state. Owner thread only.
+   * @return The state, or nullptr if the deque is empty
+   */
+  std::unique_ptr<state::SemanticState> pop();
+
+  /**
+   * @brief Steal the oldest state. Any thread.
+   * @return The state, or nullptr if the deque is empty or the steal
+   * lost a race (the caller should simply try elsewhere)
+   */
+  std::unique_ptr<state::SemanticState> steal();
+
+  /**
+   * @brief Approximate number of states (exact when quiescent).
+   */
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Delete all states. Not safe against concurrent access.
+   */
+  void clear();
+
+private:
+  struct Buffer {
+    int64_t capacity;  // power of two
+    std::unique_ptr<std::atomic<state::SemanticState*>[]> slots;
+
+    explicit Buffer(int64_t cap)
+      : capacity(cap), slots(new std::atomic<state::SemanticState*>[static_cast<size_t>(cap)]) {}
+
+    // Slots are published with release/acquire as well as through the
+    // bottom_ fence, so the state's contents are visible to a thief
+    // even under tools that do not model standalone fences.
+    state::SemanticState* get(int64_t i, std::memory_order order = std::memory_order_relaxed) const {
+      return slots[static_cast<size_t>(i & (capacity - 1))].load(order);
+    }
+    void put(int64_t i, state::SemanticState* s) {
+      slots[static_cast<size_t>(i & (capacity - 1))].store(s, std::memory_order_release);
+    }
+  };
+
+  // top_ and bottom_ are written by different threads; keep them apart.
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  alignas(64) std::atomic<Buffer*> buffer_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;  // current and retired, owner only
+
+  Buffer* grow(Buffer* old, int64_t top, int64_t bottom);
+};
+
+} // namespace search
+} // namespace semcal
@@ -65,6 +65,10 @@ public:
 
 /**
  * @brief Best-first search strategy.
+ *
+ * The heuristic is evaluated once per state when it enters the
+ * frontier (lower values are explored first). The frontier is
+ * unbounded: the returned leaves would silently miss evicted states.
  */
 class LegacyBestFirstStrategy : public LegacySearchStrategy {
 private:
@@ -9,14 +9,25 @@
  */
 
 // SemCal: Axiomatic Semantic Calculus
+#include "semcal/core/value.h"
 #include "semcal/core/model.h"
+#include "semcal/core/model_set.h"
+#include "semcal/core/model_stream.h"
 #include "semcal/core/partial_model.h"
+#include "semcal/core/term_store.h"
 #include "semcal/core/formula.h"
+#include "semcal/core/linear_system.h"
+#include "semcal/core/clause_arena.h"
+#include "semcal/core/cnf_formula.h"
+#include "semcal/core/cnf_encoder.h"
 #include "semcal/core/semantics.h"
 #include "semcal/domain/abstract_domain.h"
 #include "semcal/domain/concretization.h"
 #include "semcal/domain/galois.h"
 #include "semcal/domain/top_element.h"
+#include "semcal/domain/interval_box.h"
+#include "semcal/domain/box_batch.h"
+#include "semcal/domain/box_domain.h"
 #include "semcal/state/semantic_state.h"
 #include "semcal/operators/restrict.h"
 #include "semcal/operators/decompose.h"
@@ -27,14 +38,27 @@
 #include "semcal/operators/lift.h"
 #include "semcal/backends/cad_backend.h"
 #include "semcal/backends/lp_backend.h"
+#include "semcal/backends/lp_simplex.h"
 #include "semcal/backends/icp_backend.h"
+#include "semcal/backends/icp_hc4.h"
+#include "semcal/backends/sat_backend.h"
+#include "semcal/backends/sat_cdcl.h"
 #include "semcal/util/op_result.h"
+#include "semcal/util/rational.h"
+#include "semcal/io/mapped_file.h"
+#include "semcal/io/smtlib_reader.h"
+#include "semcal/io/dimacs_reader.h"
 
 // SemKernel: Verified Semantic Kernel
 #include "semkernel/kernel.h"
+#include "semkernel/farkas_checker.h"
+#include "semkernel/lrat_checker.h"
 
 // SemSearch: Generic Search and Execution Engine
+#include "semsearch/frontier.h"
 #include "semsearch/search_engine.h"
+#include "semsearch/work_stealing_deque.h"
+#include "semsearch/parallel_search_engine.h"
 
 // SemSolver: Concrete Solver Instances
 #include "semsolver/solver.h"
@@ -61,6 +85,7 @@ namespace semcal {
     // - semcal::operators (semantic operators)
     // - semcal::backends (backend adapters)
     // - semcal::util (utilities)
+    // - semcal::io (input readers)
     
     // SemKernel namespace:
     // - semcal::kernel (verified semantic validation)
@@ -15,7 +15,7 @@ CadStubBackend::decompose(const state::SemanticState& σ) {
   // Stub: return single state (no decomposition)
   std::vector<std::unique_ptr<state::SemanticState>> result;
   result.push_back(σ.clone());
-  return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::ok(
+  return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::noProgress(
     std::move(result)
   );
 }
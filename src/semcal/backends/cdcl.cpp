@@ -0,0 +1,770 @@
+#include "semcal/backends/cdcl.h"
+#include <algorithm>
+#include <cstring>
+
+namespace semcal {
+namespace backends {
+
+using core::litNegate;
+using core::litNegated;
+using core::litVar;
+using core::mkLit;
+
+namespace {
+
+constexpr double kVarDecay = 0.95;
+constexpr double kClauseDecay = 0.999;
+constexpr std::size_t kLbdWindow = 50;
+constexpr double kRestartMargin = 0.8;  // restart if recent · 0.8 > global
+
+} // namespace
+
+CdclSolver::Var CdclSolver::newVariable() {
+    Var v = numVariables();
+    ensureVariables(v + 1);
+    return v;
+}
+
+void CdclSolver::ensureVariables(std::uint32_t count) {
+    std::uint32_t old = numVariables();
+    if (count <= old) {
+        return;
+    }
+    values_.resize(2 * static_cast<std::size_t>(count), 0);
+    watches_.resize(2 * static_cast<std::size_t>(count));
+    level_.resize(count, 0);
+    reason_.resize(count, kNoReason);
+    activity_.resize(count, 0.0);
+    heapIndex_.resize(count, -1);
+    phase_.resize(count, 1);
+    seen_.resize(count, 0);
+    levelStamp_.resize(count + 1, 0);
+    if (proof_) {
+        unitId_.resize(count, 0);
+        trailIndex_.resize(count, 0);
+        hintStamp_.resize(count, 0);
+    }
+    for (Var v = old; v < count; ++v) {
+        heapInsert(v);
+    }
+}
+
+void CdclSolver::setProof(LratWriter* proof) {
+    proof_ = proof;
+    header_ = proof ? 5 : 3;
+    unitId_.resize(numVariables(), 0);
+    trailIndex_.resize(numVariables(), 0);
+    hintStamp_.resize(numVariables(), 0);
+}
+
+float CdclSolver::clauseActivity(ClauseRef c) const {
+    float activity;
+    std::memcpy(&activity, &memory_[c + 2], sizeof(float));
+    return activity;
+}
+
+void CdclSolver::setClauseActivity(ClauseRef c, float activity) {
+    std::memcpy(&memory_[c + 2], &activity, sizeof(float));
+}
+
+CdclSolver::ClauseRef CdclSolver::allocate(const std::vector<Lit>& lits, bool learned,
+                                           std::uint32_t lbd, std::uint64_t id) {
+    auto c = static_cast<ClauseRef>(memory_.size());
+    memory_.push_back(static_cast<std::uint32_t>(lits.size()));
+    memory_.push_back((lbd << 2) | (learned ? 1u : 0u));
+    memory_.push_back(0);
+    if (proof_) {
+        memory_.push_back(static_cast<std::uint32_t>(id));
+        memory_.push_back(static_cast<std::uint32_t>(id >> 32));
+    }
+    memory_.insert(memory_.end(), lits.begin(), lits.end());
+    return c;
+}
+
+void CdclSolver::attach(ClauseRef c) {
+    const Lit* lits = literals(c);
+    watches_[litNegate(lits[0])].push_back(Watcher{c, lits[1]});
+    watches_[litNegate(lits[1])].push_back(Watcher{c, lits[0]});
+}
+
+bool CdclSolver::locked(ClauseRef c) {
+    Lit first = literals(c)[0];
+    return value(first) == 1 && reason_[litVar(first)] == c;
+}
+
+bool CdclSolver::addInput(const Lit* lits, std::size_t count, std::uint64_t id) {
+    if (!ok_) {
+        return false;
+    }
+    cancelUntil(0);
+
+    std::vector<Lit> clause(lits, lits + count);
+    std::sort(clause.begin(), clause.end());
+    if (!clause.empty()) {
+        ensureVariables(litVar(clause.back()) + 1);
+    }
+    // Drop duplicates and root-false literals; skip tautologies and
+    // clauses satisfied at the root.
+    hints_.clear();
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < clause.size(); ++i) {
+        Lit p = clause[i];
+        if (i > 0 && clause[i - 1] == p) {
+            continue;
+        }
+        if (value(p) == 1 || (i > 0 && clause[i - 1] == litNegate(p))) {
+            if (proof_) {
+                proof_->remove(&id, 1);
+            }
+            return true;
+        }
+        if (value(p) == -1) {
+            if (proof_) {
+                hints_.push_back(unitId_[litVar(p)]);
+            }
+            continue;
+        }
+        clause[j++] = p;
+    }
+    clause.resize(j);
+    if (proof_ && (!hints_.empty() || clause.empty())) {
+        // The clause without its root-false literals
+        hints_.push_back(id);
+        proof_->add(++lastId_, clause, hints_);
+        proof_->remove(&id, 1);
+        id = lastId_;
+    }
+
+    if (clause.empty()) {
+        ok_ = false;
+        return false;
+    }
+    if (clause.size() == 1) {
+        if (proof_) {
+            unitId_[litVar(clause[0])] = id;
+        }
+        assign(clause[0], kNoReason);
+        ClauseRef conflict = propagate();
+        if (conflict != kNoReason) {
+            proveEmpty(conflict);
+            ok_ = false;
+        }
+        return ok_;
+    }
+    ClauseRef c = allocate(clause, false, 0, id);
+    clauses_.push_back(c);
+    attach(c);
+    return true;
+}
+
+bool CdclSolver::addClauses(const core::ClauseArena& arena) {
+    ensureVariables(arena.numVars());
+    memory_.reserve(memory_.size() + arena.numLiterals() + header_ * arena.numClauses());
+    std::uint64_t firstId = lastId_ + 1;
+    lastId_ += arena.numClauses();
+    for (std::size_t i = 0; i < arena.numClauses(); ++i) {
+        core::ClauseView clause = arena.clause(i);
+        if (!addInput(clause.data, clause.size(), firstId + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CdclSolver::assign(Lit p, ClauseRef reason) {
+    Var v = litVar(p);
+    values_[p] = 1;
+    values_[litNegate(p)] = -1;
+    level_[v] = decisionLevel();
+    reason_[v] = reason;
+    if (proof_) {
+        trailIndex_[v] = static_cast<std::uint32_t>(trail_.size());
+        if (reason != kNoReason && decisionLevel() == 0) {
+            proveUnit(p, reason);
+        }
+    }
+    trail_.push_back(p);
+}
+
+void CdclSolver::proveUnit(Lit p, ClauseRef reason) {
+    // p is implied at the root: the other literals of its reason are
+    // false by their own units.
+    hints_.clear();
+    const Lit* lits = literals(reason);
+    for (std::uint32_t k = 1; k < clauseSize(reason); ++k) {
+        hints_.push_back(unitId_[litVar(lits[k])]);
+    }
+    hints_.push_back(clauseId(reason));
+    unitId_[litVar(p)] = ++lastId_;
+    proof_->add(lastId_, &p, 1, hints_.data(), hints_.size());
+}
+
+void CdclSolver::proveEmpty(ClauseRef conflict) {
+    if (!proof_) {
+        return;
+    }
+    hints_.clear();
+    const Lit* lits = literals(conflict);
+    for (std::uint32_t k = 0; k < clauseSize(conflict); ++k) {
+        hints_.push_back(unitId_[litVar(lits[k])]);
+    }
+    hints_.push_back(clauseId(conflict));
+    proof_->add(++lastId_, nullptr, 0, hints_.data(), hints_.size());
+}
+
+void CdclSolver::addUnitHints(ClauseRef c) {
+    const Lit* lits = literals(c);
+    for (std::uint32_t k = 0; k < clauseSize(c); ++k) {
+        Var v = litVar(lits[k]);
+        if (level_[v] == 0 && hintStamp_[v] != hintStampNow_) {
+            hintStamp_[v] = hintStampNow_;
+            hints_.push_back(unitId_[v]);
+        }
+    }
+}
+
+void CdclSolver::collectHints(ClauseRef conflict) {
+    // Assuming the derived clause false, the root units, then the reasons
+    // of implied_ in trail order, each propagate their implied literal;
+    // the conflict clause (if any) is then false.
+    ++hintStampNow_;
+    hints_.clear();
+    for (Var v : implied_) {
+        addUnitHints(reason_[v]);
+    }
+    if (conflict != kNoReason) {
+        addUnitHints(conflict);
+    }
+    std::sort(implied_.begin(), implied_.end(),
+              [this](Var a, Var b) { return trailIndex_[a] < trailIndex_[b]; });
+    for (Var v : implied_) {
+        hints_.push_back(clauseId(reason_[v]));
+    }
+    if (conflict != kNoReason) {
+        hints_.push_back(clauseId(conflict));
+    }
+}
+
+CdclSolver::ClauseRef CdclSolver::propagate() {
+    ClauseRef conflict = kNoReason;
+    while (qhead_ < trail_.size()) {
+        Lit p = trail_[qhead_++];
+        Lit falseLit = litNegate(p);
+        std::vector<Watcher>& ws = watches_[p];
+        ++stats_.propagations;
+
+        Watcher* i = ws.data();
+        Watcher* j = i;
+        Watcher* end = i + ws.size();
+        while (i != end) {
+            if (value(i->blocker) == 1) {
+                *j++ = *i++;
+                continue;
+            }
+            ClauseRef c = i->clause;
+            Lit* lits = literals(c);
+            if (lits[0] == falseLit) {
+                lits[0] = lits[1];
+                lits[1] = falseLit;
+            }
+            ++i;
+
+            Lit first = lits[0];
+            Watcher w{c, first};
+            if (value(first) == 1) {
+                *j++ = w;
+                continue;
+            }
+
+            // Look for a new literal to watch.
+            std::uint32_t size = clauseSize(c);
+            bool moved = false;
+            for (std::uint32_t k = 2; k < size; ++k) {
+                if (value(lits[k]) != -1) {
+                    lits[1] = lits[k];
+                    lits[k] = falseLit;
+                    watches_[litNegate(lits[1])].push_back(w);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+
+            // Unit or conflicting.
+            *j++ = w;
+            if (value(first) == -1) {
+                conflict = c;
+                qhead_ = trail_.size();
+                while (i != end) {
+                    *j++ = *i++;
+                }
+            } else {
+                assign(first, c);
+            }
+        }
+        ws.resize(static_cast<std::size_t>(j - ws.data()));
+    }
+    return conflict;
+}
+
+void CdclSolver::cancelUntil(std::uint32_t level) {
+    if (decisionLevel() <= level) {
+        return;
+    }
+    for (std::size_t i = trail_.size(); i-- > trailLim_[level];) {
+        Lit p = trail_[i];
+        Var v = litVar(p);
+        values_[p] = 0;
+        values_[litNegate(p)] = 0;
+        reason_[v] = kNoReason;
+        phase_[v] = litNegated(p) ? 1 : 0;
+        if (heapIndex_[v] < 0) {
+            heapInsert(v);
+        }
+    }
+    trail_.resize(trailLim_[level]);
+    trailLim_.resize(level);
+    qhead_ = trail_.size();
+}
+
+CdclSolver::Lit CdclSolver::pickBranchLit() {
+    while (!heap_.empty()) {
+        Var v = heapPop();
+        if (values_[mkLit(v)] == 0) {
+            return mkLit(v, phase_[v] != 0);
+        }
+    }
+    return kNoLit;
+}
+
+std::uint32_t CdclSolver::computeLbd(const Lit* lits, std::size_t count) {
+    ++stamp_;
+    std::uint32_t lbd = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t level = level_[litVar(lits[i])];
+        if (levelStamp_[level] != stamp_) {
+            levelStamp_[level] = stamp_;
+            ++lbd;
+        }
+    }
+    return lbd;
+}
+
+void CdclSolver::analyze(ClauseRef conflict, std::uint32_t& backtrackLevel, std::uint32_t& lbd) {
+    learnt_.clear();
+    learnt_.push_back(kNoLit);  // the UIP, filled in last
+    implied_.clear();
+    ClauseRef first = conflict;
+    int pathCount = 0;
+    Lit p = kNoLit;
+    std::size_t index = trail_.size();
+
+    do {
+        if (isLearned(conflict)) {
+            bumpClause(conflict);
+        }
+        const Lit* lits = literals(conflict);
+        std::uint32_t size = clauseSize(conflict);
+        for (std::uint32_t k = p == kNoLit ? 0 : 1; k < size; ++k) {
+            Lit q = lits[k];
+            Var v = litVar(q);
+            if (!seen_[v] && level_[v] > 0) {
+                bumpVariable(v);
+                seen_[v] = 1;
+                if (level_[v] >= decisionLevel()) {
+                    ++pathCount;
+                } else {
+                    learnt_.push_back(q);
+                }
+            }
+        }
+        // Next literal of the current level on the trail
+        do {
+            --index;
+        } while (!seen_[litVar(trail_[index])]);
+        p = trail_[index];
+        conflict = reason_[litVar(p)];
+        seen_[litVar(p)] = 0;
+        --pathCount;
+        if (proof_ && pathCount > 0) {
+            implied_.push_back(litVar(p));
+        }
+    } while (pathCount > 0);
+    learnt_[0] = litNegate(p);
+
+    // Recursive minimization: drop literals implied by the others.
+    analyzeToClear_.assign(learnt_.begin(), learnt_.end());
+    std::uint32_t abstractLevels = 0;
+    for (std::size_t i = 1; i < learnt_.size(); ++i) {
+        abstractLevels |= 1u << (level_[litVar(learnt_[i])] & 31);
+    }
+    std::size_t j = 1;
+    for (std::size_t i = 1; i < learnt_.size(); ++i) {
+        if (reason_[litVar(learnt_[i])] == kNoReason || !litRedundant(learnt_[i], abstractLevels)) {
+            learnt_[j++] = learnt_[i];
+        } else if (proof_) {
+            implied_.push_back(litVar(learnt_[i]));
+        }
+    }
+    if (proof_) {
+        // Literals proven redundant on the way are implied as well.
+        for (std::size_t i = learnt_.size(); i < analyzeToClear_.size(); ++i) {
+            implied_.push_back(litVar(analyzeToClear_[i]));
+        }
+        collectHints(first);
+    }
+    learnt_.resize(j);
+    for (Lit q : analyzeToClear_) {
+        seen_[litVar(q)] = 0;
+    }
+
+    // Second watch: the literal of the highest remaining level
+    backtrackLevel = 0;
+    if (learnt_.size() > 1) {
+        std::size_t max = 1;
+        for (std::size_t i = 2; i < learnt_.size(); ++i) {
+            if (level_[litVar(learnt_[i])] > level_[litVar(learnt_[max])]) {
+                max = i;
+            }
+        }
+        std::swap(learnt_[1], learnt_[max]);
+        backtrackLevel = level_[litVar(learnt_[1])];
+    }
+    lbd = computeLbd(learnt_.data(), learnt_.size());
+}
+
+bool CdclSolver::litRedundant(Lit p, std::uint32_t abstractLevels) {
+    analyzeStack_.clear();
+    analyzeStack_.push_back(p);
+    std::size_t top = analyzeToClear_.size();
+    while (!analyzeStack_.empty()) {
+        ClauseRef reason = reason_[litVar(analyzeStack_.back())];
+        analyzeStack_.pop_back();
+        const Lit* lits = literals(reason);
+        std::uint32_t size = clauseSize(reason);
+        for (std::uint32_t k = 1; k < size; ++k) {
+            Lit q = lits[k];
+            Var v = litVar(q);
+            if (seen_[v] || level_[v] == 0) {
+                continue;
+            }
+            if (reason_[v] != kNoReason && ((1u << (level_[v] & 31)) & abstractLevels) != 0) {
+                seen_[v] = 1;
+                analyzeStack_.push_back(q);
+                analyzeToClear_.push_back(q);
+            } else {
+                for (std::size_t i = top; i < analyzeToClear_.size(); ++i) {
+                    seen_[litVar(analyzeToClear_[i])] = 0;
+                }
+                analyzeToClear_.resize(top);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void CdclSolver::analyzeFinal(Lit p) {
+    // p is true and its negation was assumed; collect the assumptions
+    // (decisions) it depends on.
+    conflict_.clear();
+    conflict_.push_back(p);
+    if (level_[litVar(p)] == 0) {
+        if (proof_) {
+            proof_->add(++lastId_, conflict_, {unitId_[litVar(p)]});
+        }
+        return;
+    }
+    implied_.clear();
+    seen_[litVar(p)] = 1;
+    for (std::size_t i = trail_.size(); i-- > trailLim_[0];) {
+        Var v = litVar(trail_[i]);
+        if (!seen_[v]) {
+            continue;
+        }
+        if (reason_[v] == kNoReason) {
+            conflict_.push_back(litNegate(trail_[i]));
+        } else {
+            if (proof_) {
+                implied_.push_back(v);
+            }
+            const Lit* lits = literals(reason_[v]);
+            std::uint32_t size = clauseSize(reason_[v]);
+            for (std::uint32_t k = 1; k < size; ++k) {
+                if (level_[litVar(lits[k])] > 0) {
+                    seen_[litVar(lits[k])] = 1;
+                }
+            }
+        }
+        seen_[v] = 0;
+    }
+    seen_[litVar(p)] = 0;
+    if (proof_) {
+        collectHints(kNoReason);
+        proof_->add(++lastId_, conflict_, hints_);
+    }
+}
+
+void CdclSolver::bumpVariable(Var v) {
+    if ((activity_[v] += varInc_) > 1e100) {
+        for (double& a : activity_) {
+            a *= 1e-100;
+        }
+        varInc_ *= 1e-100;
+    }
+    if (heapIndex_[v] >= 0) {
+        heapUp(static_cast<std::size_t>(heapIndex_[v]));
+    }
+}
+
+void CdclSolver::bumpClause(ClauseRef c) {
+    float activity = clauseActivity(c) + static_cast<float>(clauseInc_);
+    setClauseActivity(c, activity);
+    if (activity > 1e20f) {
+        for (ClauseRef l : learnts_) {
+            setClauseActivity(l, clauseActivity(l) * 1e-20f);
+        }
+        clauseInc_ *= 1e-20;
+    }
+}
+
+bool CdclSolver::shouldRestart(std::uint32_t lbd) {
+    lbdTotal_ += lbd;
+    if (lbdQueue_.size() < kLbdWindow) {
+        lbdQueue_.push_back(lbd);
+        lbdQueueSum_ += lbd;
+        return false;
+    }
+    lbdQueueSum_ += lbd - lbdQueue_[lbdQueueHead_];
+    lbdQueue_[lbdQueueHead_] = lbd;
+    lbdQueueHead_ = (lbdQueueHead_ + 1) % kLbdWindow;
+    double recent = static_cast<double>(lbdQueueSum_) / kLbdWindow;
+    double global = static_cast<double>(lbdTotal_) / static_cast<double>(stats_.conflicts);
+    if (recent * kRestartMargin > global) {
+        lbdQueue_.clear();
+        lbdQueueHead_ = 0;
+        lbdQueueSum_ = 0;
+        return true;
+    }
+    return false;
+}
+
+void CdclSolver::reduceLearned() {
+    ++stats_.reductions;
+    // Worst first: high LBD, then low activity
+    std::sort(learnts_.begin(), learnts_.end(), [this](ClauseRef a, ClauseRef b) {
+        if (clauseLbd(a) != clauseLbd(b)) {
+            return clauseLbd(a) > clauseLbd(b);
+        }
+        return clauseActivity(a) < clauseActivity(b);
+    });
+    std::size_t limit = learnts_.size() / 2;
+    std::size_t j = 0;
+    hints_.clear();
+    for (std::size_t i = 0; i < learnts_.size(); ++i) {
+        ClauseRef c = learnts_[i];
+        if (i < limit && clauseLbd(c) > 2 && clauseSize(c) > 2 && !locked(c)) {
+            memory_[c + 1] |= 2;
+            ++stats_.deleted;
+            if (proof_) {
+                hints_.push_back(clauseId(c));
+            }
+        } else {
+            learnts_[j++] = c;
+        }
+    }
+    learnts_.resize(j);
+    if (proof_) {
+        proof_->remove(hints_);
+    }
+    compact();
+}
+
+void CdclSolver::compact() {
+    // Copy live clauses into fresh memory, leaving the new offset in the
+    // activity slot of the old header to remap reasons (reasons are
+    // locked, so never deleted), then rebuild the watch lists.
+    std::vector<std::uint32_t> memory;
+    memory.reserve(memory_.size());
+    auto move = [&](std::vector<ClauseRef>& refs) {
+        for (ClauseRef& c : refs) {
+            auto moved = static_cast<ClauseRef>(memory.size());
+            memory.insert(memory.end(), memory_.begin() + c, memory_.begin() + c + header_ + clauseSize(c));
+            memory_[c + 2] = moved;
+            c = moved;
+        }
+    };
+    move(clauses_);
+    move(learnts_);
+    for (Lit p : trail_) {
+        ClauseRef& reason = reason_[litVar(p)];
+        if (reason != kNoReason) {
+            reason = memory_[reason + 2];
+        }
+    }
+    memory_.swap(memory);
+
+    for (std::vector<Watcher>& ws : watches_) {
+        ws.clear();
+    }
+    for (ClauseRef c : clauses_) {
+        attach(c);
+    }
+    for (ClauseRef c : learnts_) {
+        attach(c);
+    }
+}
+
+CdclSolver::Result CdclSolver::solve(const std::vector<Lit>& assumptions, std::uint64_t maxConflicts) {
+    conflict_.clear();
+    model_.clear();
+    if (!ok_) {
+        return Result::UNSAT;
+    }
+    for (Lit p : assumptions) {
+        ensureVariables(litVar(p) + 1);
+    }
+    cancelUntil(0);
+
+    std::uint64_t conflicts = 0;
+    for (;;) {
+        ClauseRef conflict = propagate();
+        if (conflict != kNoReason) {
+            ++stats_.conflicts;
+            ++conflicts;
+            if (decisionLevel() == 0) {
+                proveEmpty(conflict);
+                ok_ = false;
+                return Result::UNSAT;
+            }
+            std::uint32_t backtrackLevel;
+            std::uint32_t lbd;
+            analyze(conflict, backtrackLevel, lbd);
+            cancelUntil(backtrackLevel);
+            ++stats_.learned;
+            std::uint64_t id = 0;
+            if (proof_) {
+                id = ++lastId_;
+                proof_->add(id, learnt_, hints_);
+            }
+            if (learnt_.size() == 1) {
+                if (proof_) {
+                    unitId_[litVar(learnt_[0])] = id;
+                }
+                assign(learnt_[0], kNoReason);
+            } else {
+                ClauseRef c = allocate(learnt_, true, lbd, id);
+                learnts_.push_back(c);
+                attach(c);
+                bumpClause(c);
+                assign(learnt_[0], c);
+            }
+            varInc_ /= kVarDecay;
+            clauseInc_ /= kClauseDecay;
+
+            if (shouldRestart(lbd)) {
+                ++stats_.restarts;
+                cancelUntil(0);
+            }
+            if (stats_.conflicts >= nextReduce_) {
+                nextReduce_ = stats_.conflicts + 2000 + reduceIncrement_;
+                reduceIncrement_ += 300;
+                reduceLearned();
+            }
+            if (maxConflicts != 0 && conflicts >= maxConflicts) {
+                cancelUntil(0);
+                return Result::UNKNOWN;
+            }
+            continue;
+        }
+
+        Lit next = kNoLit;
+        while (decisionLevel() < assumptions.size()) {
+            Lit p = assumptions[decisionLevel()];
+            if (value(p) == 1) {
+                trailLim_.push_back(trail_.size());  // already true: empty level
+            } else if (value(p) == -1) {
+                analyzeFinal(litNegate(p));
+                cancelUntil(0);
+                return Result::UNSAT;
+            } else {
+                next = p;
+                break;
+            }
+        }
+        if (next == kNoLit) {
+            next = pickBranchLit();
+            if (next == kNoLit) {
+                model_.resize(numVariables());
+                for (Var v = 0; v < numVariables(); ++v) {
+                    model_[v] = values_[mkLit(v)] == 1 ? 1 : 0;
+                }
+                cancelUntil(0);
+                return Result::SAT;
+            }
+            ++stats_.decisions;
+        }
+        trailLim_.push_back(trail_.size());
+        assign(next, kNoReason);
+    }
+}
+
+void CdclSolver::heapInsert(Var v) {
+    heapIndex_[v] = static_cast<std::int32_t>(heap_.size());
+    heap_.push_back(v);
+    heapUp(heap_.size() - 1);
+}
+
+CdclSolver::Var CdclSolver::heapPop() {
+    Var top = heap_[0];
+    heapIndex_[top] = -1;
+    Var last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heap_[0] = last;
+        heapIndex_[last] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+void CdclSolver::heapUp(std::size_t i) {
+    Var v = heap_[i];
+    while (i > 0) {
+        std::size_t parent = (i - 1) / 2;
+        if (activity_[heap_[parent]] >= activity_[v]) {
+            break;
+        }
+        heap_[i] = heap_[parent];
+        heapIndex_[heap_[i]] = static_cast<std::int32_t>(i);
+        i = parent;
+    }
+    heap_[i] = v;
+    heapIndex_[v] = static_cast<std::int32_t>(i);
+}
+
+void CdclSolver::heapDown(std::size_t i) {
+    Var v = heap_[i];
+    for (;;) {
+        std::size_t child = 2 * i + 1;
+        if (child >= heap_.size()) {
+            break;
+        }
+        if (child + 1 < heap_.size() && activity_[heap_[child + 1]] > activity_[heap_[child]]) {
+            ++child;
+        }
+        if (activity_[heap_[child]] <= activity_[v]) {
+            break;
+        }
+        heap_[i] = heap_[child];
+        heapIndex_[heap_[i]] = static_cast<std::int32_t>(i);
+        i = child;
+    }
+    heap_[i] = v;
+    heapIndex_[v] = static_cast<std::int32_t>(i);
+}
+
+} // namespace backends
+} // namespace semcal
@@ -0,0 +1,770 @@
+#include "semcal/backends/hc4_contractor.h"
+#include "semcal/util/rational.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace semcal {
+namespace backends {
+
+using util::FastInterval;
+namespace iv = util::interval;
+
+namespace {
+
+FastInterval slotInterval(const domain::IntervalBox& box, std::size_t slot) {
+    return slot == domain::IntervalBox::kNoSlot ? FastInterval::entire()
+                                                : FastInterval::make(box.lowerAt(slot), box.upperAt(slot));
+}
+
+// Lane-wise versions of the FastInterval kernels for batched contraction.
+// A Block holds the (−lo, hi) pairs of kWidth independent intervals, one
+// per lane, so interval operations map one-to-one onto vector instructions.
+namespace lanes {
+
+constexpr double kInf = FastInterval::kInf;
+
+#if defined(__AVX2__)
+
+constexpr std::size_t kWidth = 4;
+using Vec = __m256d;
+
+inline Vec load(const double* p) { return _mm256_loadu_pd(p); }
+inline void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+inline Vec splat(double x) { return _mm256_set1_pd(x); }
+inline Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+inline Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+inline Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+inline Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+inline Vec negate(Vec a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+inline Vec zeroNaN(Vec a) { return _mm256_andnot_pd(_mm256_cmp_pd(a, a, _CMP_UNORD_Q), a); }
+inline unsigned lessMask(Vec a, Vec b) {
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+}
+
+using Mask = __m256d;
+inline Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+inline Mask notNegative(Vec a) { return _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_NLT_UQ); }
+inline Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+inline Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_pd(b, a, m); }
+
+// Same bit stepping as util::interval::nextUp, four lanes at a time.
+inline Vec nextUp(Vec v) {
+    const __m256i one = _mm256_set1_epi64x(1);
+    __m256i bits = _mm256_castpd_si256(v);
+    __m256i negative = _mm256_castpd_si256(_mm256_cmp_pd(v, _mm256_setzero_pd(), _CMP_LT_OQ));
+    __m256i stepped = _mm256_add_epi64(bits, _mm256_add_epi64(one, _mm256_add_epi64(negative, negative)));
+    __m256i zero = _mm256_castpd_si256(_mm256_cmp_pd(v, _mm256_setzero_pd(), _CMP_EQ_OQ));
+    stepped = _mm256_blendv_epi8(stepped, one, zero);
+    __m256i keep = _mm256_castpd_si256(_mm256_or_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q),
+                                                    _mm256_cmp_pd(v, splat(kInf), _CMP_EQ_OQ)));
+    return _mm256_castsi256_pd(_mm256_blendv_epi8(stepped, bits, keep));
+}
+
+#elif defined(SEMCAL_INTERVAL_SSE2)
+
+constexpr std::size_t kWidth = 2;
+using Vec = __m128d;
+
+inline Vec load(const double* p) { return _mm_loadu_pd(p); }
+inline void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+inline Vec splat(double x) { return _mm_set1_pd(x); }
+inline Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+inline Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+inline Vec min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+inline Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+inline Vec negate(Vec a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+inline Vec zeroNaN(Vec a) { return _mm_andnot_pd(_mm_cmpunord_pd(a, a), a); }
+inline unsigned lessMask(Vec a, Vec b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(a, b))); }
+inline Vec nextUp(Vec v) { return iv::nextUp(v); }
+
+using Mask = __m128d;
+inline Vec div(Vec a, Vec b) { return _mm_div_pd(a, b); }
+inline Mask notNegative(Vec a) { return _mm_cmpnlt_pd(a, _mm_setzero_pd()); }
+inline Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+inline Vec select(Mask m, Vec a, Vec b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+
+#else
+
+constexpr std::size_t kWidth = 1;
+using Vec = double;
+
+inline Vec load(const double* p) { return *p; }
+inline void store(double* p, Vec v) { *p = v; }
+inline Vec splat(double x) { return x; }
+inline Vec add(Vec a, Vec b) { return a + b; }
+inline Vec mul(Vec a, Vec b) { return a * b; }
+// Operand order matches minpd/maxpd: the second operand wins on NaN.
+inline Vec min(Vec a, Vec b) { return a < b ? a : b; }
+inline Vec max(Vec a, Vec b) { return a > b ? a : b; }
+inline Vec negate(Vec a) { return -a; }
+inline Vec zeroNaN(Vec a) { return a != a ? 0.0 : a; }
+inline unsigned lessMask(Vec a, Vec b) { return a < b ? 1u : 0u; }
+inline Vec nextUp(Vec v) { return std::nextafter(v, kInf); }
+
+using Mask = bool;
+inline Vec div(Vec a, Vec b) { return a / b; }
+inline Mask notNegative(Vec a) { return !(a < 0); }
+inline Mask both(Mask a, Mask b) { return a && b; }
+inline Vec select(Mask m, Vec a, Vec b) { return m ? a : b; }
+
+#endif
+
+struct Block {
+    Vec negLo;
+    Vec hi;
+};
+
+inline Block add(const Block& a, const Block& b) {
+    return Block{nextUp(add(a.negLo, b.negLo)), nextUp(add(a.hi, b.hi))};
+}
+
+inline Block sub(const Block& a, const Block& b) {
+    return Block{nextUp(add(a.negLo, b.hi)), nextUp(add(a.hi, b.negLo))};
+}
+
+inline Block neg(const Block& a) {
+    return Block{a.hi, a.negLo};
+}
+
+inline Block mul(const Block& a, const Block& b) {
+    Vec alo = negate(a.negLo);
+    Vec blo = negate(b.negLo);
+    Vec p1 = zeroNaN(mul(alo, blo));
+    Vec p2 = zeroNaN(mul(alo, b.hi));
+    Vec p3 = zeroNaN(mul(a.hi, blo));
+    Vec p4 = zeroNaN(mul(a.hi, b.hi));
+    Vec mn = min(min(p1, p2), min(p3, p4));
+    Vec mx = max(max(p1, p2), max(p3, p4));
+    return Block{nextUp(negate(mn)), nextUp(mx)};
+}
+
+// a·a met with [0, ∞) is exactly the hull of a²
+inline Block sqr(const Block& a) {
+    Block r = mul(a, a);
+    r.negLo = min(r.negLo, splat(0.0));
+    return r;
+}
+
+// Lanes whose interval contains 0 (or is NaN), where division gives up.
+inline Mask straddlesZero(const Block& b) {
+    return both(notNegative(b.negLo), notNegative(b.hi));
+}
+
+inline Block entireWhere(Mask m, const Block& a) {
+    return Block{select(m, splat(kInf), a.negLo), select(m, splat(kInf), a.hi)};
+}
+
+// a / b as a · [1/hi_b, 1/lo_b]; the entire line in lanes where b contains 0
+inline Block div(const Block& a, const Block& b) {
+    Block reciprocal{nextUp(div(splat(-1.0), b.hi)), nextUp(div(splat(-1.0), b.negLo))};
+    return entireWhere(straddlesZero(b), mul(a, reciprocal));
+}
+
+inline Block meet(const Block& a, const Block& b) {
+    return Block{min(a.negLo, b.negLo), min(a.hi, b.hi)};
+}
+
+inline Block keepWhere(Mask m, const Block& a, const Block& b) {
+    return Block{select(m, a.negLo, b.negLo), select(m, a.hi, b.hi)};
+}
+
+inline unsigned emptyMask(const Block& a) {
+    return lessMask(a.hi, negate(a.negLo));
+}
+
+} // namespace lanes
+
+constexpr std::size_t kBlock = domain::BoxBatch::kBlock;
+static_assert(kBlock % lanes::kWidth == 0, "blocks must hold whole vectors");
+
+} // namespace
+
+Hc4Contractor::Hc4Contractor(const core::Formula& formula) {
+    addConstraint(formula.getTerm());
+}
+
+std::size_t Hc4Contractor::variableIndex(core::VariableId variable) const {
+    auto it = std::lower_bound(variables_.begin(), variables_.end(), variable);
+    return it != variables_.end() && *it == variable ? static_cast<std::size_t>(it - variables_.begin()) : kNoVariable;
+}
+
+bool Hc4Contractor::addConstraint(core::TermId term) {
+    return addAtom(term, false);
+}
+
+bool Hc4Contractor::addAtom(core::TermId atom, bool negated) {
+    const core::TermStore& store = core::TermStore::global();
+    if (store.isLeaf(atom)) {
+        const std::string& name = store.name(atom);
+        if (name == (negated ? "false" : "true")) {
+            return true;
+        }
+        ++skipped_;
+        return false;
+    }
+    const std::string& head = store.name(atom);
+    core::TermArgs args = store.args(atom);
+    if (head == "and" && !negated) {
+        bool all = true;
+        for (core::TermId arg : args) {
+            all = addAtom(arg, false) && all;
+        }
+        return all;
+    }
+    if (head == "not" && args.size() == 1) {
+        return addAtom(args[0], !negated);
+    }
+    if ((head == "<=" || head == "<" || head == ">=" || head == ">" || head == "=") && args.size() >= 2) {
+        if (negated && (head == "=" || args.size() > 2)) {
+            ++skipped_;
+            return false;
+        }
+        // Chains (<= a b c) mean (and (<= a b) (<= b c)).
+        bool all = true;
+        for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+            all = compileRelation(head, args[i], args[i + 1], negated) && all;
+        }
+        return all;
+    }
+    ++skipped_;
+    return false;
+}
+
+bool Hc4Contractor::compileRelation(const std::string& relation, core::TermId lhs, core::TermId rhs,
+                                    bool negated) {
+    // lhs − rhs ∈ range; ¬(a <= b) is a > b and so on.
+    bool upperOnly = relation == "<=" || relation == "<";
+    bool lowerOnly = relation == ">=" || relation == ">";
+    if (negated) {
+        std::swap(upperOnly, lowerOnly);
+    }
+    Constraint constraint;
+    if (upperOnly) {
+        constraint.range = FastInterval::make(-FastInterval::kInf, 0.0);
+    } else if (lowerOnly) {
+        constraint.range = FastInterval::make(0.0, FastInterval::kInf);
+    } else {
+        constraint.range = FastInterval::point(0.0);
+    }
+
+    std::unordered_map<core::TermId, std::uint32_t> memo;
+    std::uint32_t left = 0;
+    std::uint32_t right = 0;
+    if (!compileExpr(lhs, constraint, memo, left) || !compileExpr(rhs, constraint, memo, right)) {
+        ++skipped_;
+        return false;
+    }
+    Node root;
+    root.op = Op::Sub;
+    root.a = left;
+    root.b = right;
+    constraint.nodes.push_back(root);
+
+    std::sort(constraint.vars.begin(), constraint.vars.end());
+    for (Node& node : constraint.nodes) {
+        if (node.op == Op::Var) {
+            node.local = static_cast<std::uint32_t>(
+                std::lower_bound(constraint.vars.begin(), constraint.vars.end(), node.var) -
+                constraint.vars.begin());
+        }
+    }
+    for (core::VariableId var : constraint.vars) {
+        if (std::find(variables_.begin(), variables_.end(), var) == variables_.end()) {
+            variables_.push_back(var);
+        }
+    }
+    std::sort(variables_.begin(), variables_.end());
+    if (values_.size() < constraint.nodes.size()) {
+        values_.resize(constraint.nodes.size());
+        blockValues_.resize(2 * kBlock * constraint.nodes.size());
+    }
+    constraints_.push_back(std::move(constraint));
+    return true;
+}
+
+bool Hc4Contractor::compileExpr(core::TermId term, Constraint& constraint,
+                                std::unordered_map<core::TermId, std::uint32_t>& memo,
+                                std::uint32_t& out) {
+    auto found = memo.find(term);
+    if (found != memo.end()) {
+        out = found->second;
+        return true;
+    }
+    const core::TermStore& store = core::TermStore::global();
+    Node node;
+    if (store.isLeaf(term)) {
+        util::Rational value;
+        if (util::Rational::parse(store.name(term), value)) {
+            node.op = Op::Const;
+            node.constant = FastInterval::make(value.toDoubleDown(), value.toDoubleUp());
+        } else {
+            node.op = Op::Var;
+            node.var = store.symbol(term);
+            constraint.vars.push_back(node.var);
+        }
+    } else {
+        const std::string& head = store.name(term);
+        core::TermArgs args = store.args(term);
+        if (head == "to_real" && args.size() == 1) {
+            if (!compileExpr(args[0], constraint, memo, out)) {
+                return false;
+            }
+            memo[term] = out;
+            return true;
+        }
+        Op op;
+        if (head == "+") {
+            op = Op::Add;
+        } else if (head == "-") {
+            op = args.size() == 1 ? Op::Neg : Op::Sub;
+        } else if (head == "*") {
+            op = Op::Mul;
+        } else if (head == "/") {
+            op = Op::Div;
+        } else {
+            return false;
+        }
+        std::uint32_t first = 0;
+        if (!compileExpr(args[0], constraint, memo, first)) {
+            return false;
+        }
+        if (op == Op::Neg) {
+            node.op = Op::Neg;
+            node.a = first;
+        } else {
+            if (args.size() < 2) {
+                return false;
+            }
+            // n-ary operators fold to the left
+            std::uint32_t acc = first;
+            for (std::size_t i = 1; i < args.size(); ++i) {
+                std::uint32_t next = 0;
+                if (!compileExpr(args[i], constraint, memo, next)) {
+                    return false;
+                }
+                Node step;
+                step.op = (op == Op::Mul && next == acc) ? Op::Sqr : op;
+                step.a = acc;
+                step.b = next;
+                if (i + 1 == args.size()) {
+                    node = step;
+                    break;
+                }
+                constraint.nodes.push_back(step);
+                acc = static_cast<std::uint32_t>(constraint.nodes.size() - 1);
+            }
+        }
+    }
+    constraint.nodes.push_back(node);
+    out = static_cast<std::uint32_t>(constraint.nodes.size() - 1);
+    memo[term] = out;
+    return true;
+}
+
+void Hc4Contractor::bindSlots(const Constraint& c, const domain::IntervalBox& box) {
+    slots_.resize(c.vars.size());
+    for (std::size_t j = 0; j < c.vars.size(); ++j) {
+        slots_[j] = box.slot(c.vars[j]);
+    }
+}
+
+void Hc4Contractor::evaluate(const Constraint& c, const domain::IntervalBox& box) {
+    const std::size_t n = c.nodes.size();
+    FastInterval* v = values_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const Node& node = c.nodes[i];
+        switch (node.op) {
+            case Op::Const: v[i] = node.constant; break;
+            case Op::Var: v[i] = slotInterval(box, slots_[node.local]); break;
+            case Op::Add: v[i] = iv::add(v[node.a], v[node.b]); break;
+            case Op::Sub: v[i] = iv::sub(v[node.a], v[node.b]); break;
+            case Op::Neg: v[i] = iv::neg(v[node.a]); break;
+            case Op::Mul: v[i] = iv::mul(v[node.a], v[node.b]); break;
+            case Op::Div: v[i] = iv::div(v[node.a], v[node.b]); break;
+            case Op::Sqr: v[i] = iv::sqr(v[node.a]); break;
+        }
+    }
+}
+
+bool Hc4Contractor::revise(std::size_t index, domain::IntervalBox& box) {
+    const Constraint& c = constraints_[index];
+    const std::size_t n = c.nodes.size();
+    FastInterval* v = values_.data();
+    if (box.isEmpty()) {
+        return false;
+    }
+    box.addSlots(c.vars);
+    bindSlots(c, box);
+
+    // Forward: evaluate every node over the box.
+    evaluate(c, box);
+    v[n - 1] = iv::meet(v[n - 1], c.range);
+
+    // Backward: project each node's narrowed value onto its operands.
+    // Parents come after their operands, so a node is final when reached.
+    for (std::size_t i = n; i-- > 0;) {
+        const FastInterval z = v[i];
+        if (z.isEmpty()) {
+            box = domain::IntervalBox::emptyBox();
+            return false;
+        }
+        const Node& node = c.nodes[i];
+        FastInterval& a = v[node.a];
+        FastInterval& b = v[node.b];
+        switch (node.op) {
+            case Op::Const:
+                break;
+            case Op::Var: {
+                std::size_t slot = slots_[node.local];
+                box.setAt(slot, std::max(box.lowerAt(slot), z.lo()), std::min(box.upperAt(slot), z.hi));
+                if (box.isEmpty()) {
+                    return false;
+                }
+                break;
+            }
+            case Op::Add:
+                a = iv::meet(a, iv::sub(z, b));
+                b = iv::meet(b, iv::sub(z, a));
+                break;
+            case Op::Sub:
+                a = iv::meet(a, iv::add(z, b));
+                b = iv::meet(b, iv::sub(a, z));
+                break;
+            case Op::Neg:
+                a = iv::meet(a, iv::neg(z));
+                break;
+            case Op::Mul:
+                // div() yields the entire line when the divisor contains 0
+                a = iv::meet(a, iv::div(z, b));
+                b = iv::meet(b, iv::div(z, a));
+                break;
+            case Op::Div:
+                // z = a / b only constrains a when b excludes 0
+                if (b.isPositive() || b.isNegative()) {
+                    a = iv::meet(a, iv::mul(z, b));
+                    b = iv::meet(b, iv::div(a, z));
+                }
+                break;
+            case Op::Sqr:
+                a = iv::meet(a, iv::sqrtProject(z, a));
+                break;
+        }
+    }
+    return true;
+}
+
+void Hc4Contractor::derivatives(std::size_t index, const domain::IntervalBox& box,
+                                std::vector<FastInterval>& gradient) {
+    const Constraint& c = constraints_[index];
+    const std::size_t n = c.nodes.size();
+    const FastInterval* v = values_.data();
+    bindSlots(c, box);
+    evaluate(c, box);
+
+    // Reverse-mode differentiation over the tape: adjoint[i] encloses
+    // ∂root/∂node_i on the box.
+    adjoints_.assign(n, FastInterval::point(0.0));
+    adjoints_[n - 1] = FastInterval::point(1.0);
+    gradient.assign(c.vars.size(), FastInterval::point(0.0));
+    for (std::size_t i = n; i-- > 0;) {
+        const Node& node = c.nodes[i];
+        const FastInterval d = adjoints_[i];
+        FastInterval& da = adjoints_[node.a];
+        FastInterval& db = adjoints_[node.b];
+        switch (node.op) {
+            case Op::Const:
+                break;
+            case Op::Var:
+                gradient[node.local] = iv::add(gradient[node.local], d);
+                break;
+            case Op::Add:
+                da = iv::add(da, d);
+                db = iv::add(db, d);
+                break;
+            case Op::Sub:
+                da = iv::add(da, d);
+                db = iv::sub(db, d);
+                break;
+            case Op::Neg:
+                da = iv::sub(da, d);
+                break;
+            case Op::Mul:
+                da = iv::add(da, iv::mul(d, v[node.b]));
+                db = iv::add(db, iv::mul(d, v[node.a]));
+                break;
+            case Op::Div:
+                // ∂(a/b)/∂a = 1/b, ∂(a/b)/∂b = −a/b²
+                da = iv::add(da, iv::div(d, v[node.b]));
+                db = iv::sub(db, iv::mul(d, iv::div(v[i], v[node.b])));
+                break;
+            case Op::Sqr:
+                da = iv::add(da, iv::mul(d, iv::add(v[node.a], v[node.a])));
+                break;
+        }
+    }
+}
+
+Hc4Contractor::Change Hc4Contractor::compareBounds(double lo0, double hi0, double lo1, double hi1,
+                                                   double minProgress) {
+    bool rose = lo1 > lo0;
+    bool fell = hi1 < hi0;
+    if (!rose && !fell) {
+        return Change::None;
+    }
+    if ((std::isinf(lo0) && !std::isinf(lo1)) || (std::isinf(hi0) && !std::isinf(hi1))) {
+        return Change::Progress;
+    }
+    double before = hi0 - lo0;
+    if (!std::isinf(before)) {
+        return hi1 - lo1 < before * (1.0 - minProgress) ? Change::Progress : Change::Moved;
+    }
+    // Half-unbounded: only the finite bound can have moved.
+    double step = rose ? lo1 - lo0 : hi0 - hi1;
+    double scale = std::max(1.0, std::fabs(rose ? lo0 : hi0));
+    return step > minProgress * scale ? Change::Progress : Change::Moved;
+}
+
+Hc4Contractor::Outcome Hc4Contractor::contract(domain::IntervalBox& box) {
+    Outcome outcome;
+    if (box.isEmpty()) {
+        outcome.empty = true;
+        return outcome;
+    }
+    std::vector<bool> moved(variables_.size(), false);  // by variableIndex()
+    std::vector<double> bounds;
+    box.addSlots(variables_);  // once, rather than in the first revisions
+    for (std::size_t round = 0; round < maxRounds_; ++round) {
+        bool progress = false;
+        for (std::size_t k = 0; k < constraints_.size(); ++k) {
+            const std::vector<core::VariableId>& vars = constraints_[k].vars;
+            bounds.resize(2 * vars.size());
+            for (std::size_t j = 0; j < vars.size(); ++j) {
+                bounds[2 * j] = box.lower(vars[j]);
+                bounds[2 * j + 1] = box.upper(vars[j]);
+            }
+            ++outcome.revisions;
+            if (!revise(k, box)) {
+                outcome.empty = true;
+                return outcome;
+            }
+            for (std::size_t j = 0; j < vars.size(); ++j) {
+                Change change = compareBounds(bounds[2 * j], bounds[2 * j + 1],
+                                              box.lower(vars[j]), box.upper(vars[j]), minProgress_);
+                if (change == Change::None) {
+                    continue;
+                }
+                moved[variableIndex(vars[j])] = true;
+                progress = progress || change == Change::Progress;
+            }
+        }
+        if (!progress) {
+            break;
+        }
+    }
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+        if (moved[i]) {
+            outcome.contracted.push_back(variables_[i]);
+        }
+    }
+    return outcome;
+}
+
+std::uint32_t Hc4Contractor::reviseBlock(const Constraint& c, domain::BoxBatch& boxes, std::size_t base) {
+    using lanes::Block;
+    constexpr std::size_t W = lanes::kWidth;
+    const std::size_t n = c.nodes.size();
+    slots_.resize(c.vars.size());
+    for (std::size_t j = 0; j < c.vars.size(); ++j) {
+        slots_[j] = boxes.column(c.vars[j]);
+    }
+    // Node i owns kBlock negated lower bounds followed by kBlock upper bounds.
+    double* values = blockValues_.data();
+    auto negLoRow = [values](std::size_t i) { return values + 2 * kBlock * i; };
+    auto hiRow = [values](std::size_t i) { return values + 2 * kBlock * i + kBlock; };
+    auto load = [&](std::size_t i, std::size_t k) {
+        return Block{lanes::load(negLoRow(i) + k), lanes::load(hiRow(i) + k)};
+    };
+    auto store = [&](std::size_t i, std::size_t k, const Block& r) {
+        lanes::store(negLoRow(i) + k, r.negLo);
+        lanes::store(hiRow(i) + k, r.hi);
+    };
+
+    // Forward: evaluate every node over the block.
+    for (std::size_t i = 0; i < n; ++i) {
+        const Node& node = c.nodes[i];
+        switch (node.op) {
+            case Op::Const:
+                std::fill_n(negLoRow(i), kBlock, node.constant.negLo);
+                std::fill_n(hiRow(i), kBlock, node.constant.hi);
+                break;
+            case Op::Var: {
+                const double* lo = boxes.lowerAt(slots_[node.local]) + base;
+                const double* hi = boxes.upperAt(slots_[node.local]) + base;
+                for (std::size_t k = 0; k < kBlock; k += W) {
+                    store(i, k, Block{lanes::negate(lanes::load(lo + k)), lanes::load(hi + k)});
+                }
+                break;
+            }
+            case Op::Add:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::add(load(node.a, k), load(node.b, k)));
+                break;
+            case Op::Sub:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::sub(load(node.a, k), load(node.b, k)));
+                break;
+            case Op::Neg:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::neg(load(node.a, k)));
+                break;
+            case Op::Mul:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::mul(load(node.a, k), load(node.b, k)));
+                break;
+            case Op::Div:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::div(load(node.a, k), load(node.b, k)));
+                break;
+            case Op::Sqr:
+                for (std::size_t k = 0; k < kBlock; k += W) store(i, k, lanes::sqr(load(node.a, k)));
+                break;
+        }
+    }
+
+    const Block range{lanes::splat(c.range.negLo), lanes::splat(c.range.hi)};
+    for (std::size_t k = 0; k < kBlock; k += W) {
+        store(n - 1, k, lanes::meet(load(n - 1, k), range));
+    }
+
+    // Backward, as in revise(). Operands are reloaded after each store
+    // so that x + x and the like see their own narrowing.
+    std::uint32_t emptied = 0;
+    for (std::size_t i = n; i-- > 0;) {
+        const Node& node = c.nodes[i];
+        for (std::size_t k = 0; k < kBlock; k += W) {
+            const Block z = load(i, k);
+            emptied |= lanes::emptyMask(z) << k;
+            switch (node.op) {
+                case Op::Const:
+                    break;
+                case Op::Var: {
+                    double* lo = boxes.lowerAt(slots_[node.local]) + base + k;
+                    double* hi = boxes.upperAt(slots_[node.local]) + base + k;
+                    lanes::Vec l = lanes::max(lanes::load(lo), lanes::negate(z.negLo));
+                    lanes::Vec h = lanes::min(lanes::load(hi), z.hi);
+                    lanes::store(lo, l);
+                    lanes::store(hi, h);
+                    emptied |= lanes::lessMask(h, l) << k;
+                    break;
+                }
+                case Op::Add:
+                    store(node.a, k, lanes::meet(load(node.a, k), lanes::sub(z, load(node.b, k))));
+                    store(node.b, k, lanes::meet(load(node.b, k), lanes::sub(z, load(node.a, k))));
+                    break;
+                case Op::Sub:
+                    store(node.a, k, lanes::meet(load(node.a, k), lanes::add(z, load(node.b, k))));
+                    store(node.b, k, lanes::meet(load(node.b, k), lanes::sub(load(node.a, k), z)));
+                    break;
+                case Op::Neg:
+                    store(node.a, k, lanes::meet(load(node.a, k), lanes::neg(z)));
+                    break;
+                case Op::Mul:
+                    store(node.a, k, lanes::meet(load(node.a, k), lanes::div(z, load(node.b, k))));
+                    store(node.b, k, lanes::meet(load(node.b, k), lanes::div(z, load(node.a, k))));
+                    break;
+                case Op::Div: {
+                    const Block b = load(node.b, k);
+                    const lanes::Mask skip = lanes::straddlesZero(b);
+                    const Block a = load(node.a, k);
+                    store(node.a, k, lanes::keepWhere(skip, a, lanes::meet(a, lanes::mul(z, b))));
+                    const Block a2 = load(node.a, k);
+                    const Block b2 = load(node.b, k);
+                    store(node.b, k, lanes::keepWhere(skip, b2, lanes::meet(b2, lanes::div(a2, z))));
+                    break;
+                }
+                case Op::Sqr:
+                    // Rarely hot; the lanes are projected one at a time.
+                    for (std::size_t j = k; j < k + W; ++j) {
+                        FastInterval zj{negLoRow(i)[j], hiRow(i)[j]};
+                        FastInterval aj{negLoRow(node.a)[j], hiRow(node.a)[j]};
+                        FastInterval r = iv::meet(aj, iv::sqrtProject(zj, aj));
+                        negLoRow(node.a)[j] = r.negLo;
+                        hiRow(node.a)[j] = r.hi;
+                    }
+                    break;
+            }
+        }
+    }
+    return emptied;
+}
+
+std::size_t Hc4Contractor::contractBatch(domain::BoxBatch& boxes, std::vector<std::uint8_t>& status) {
+    status.assign(boxes.size(), 0);
+    boxes.addColumns(variables_);
+    std::vector<std::size_t> columns(variables_.size());
+    for (std::size_t j = 0; j < variables_.size(); ++j) {
+        columns[j] = boxes.column(variables_[j]);
+    }
+    blockBounds_.resize(2 * variables_.size() * kBlock);
+    std::size_t revisions = 0;
+
+    for (std::size_t base = 0; base < boxes.size(); base += kBlock) {
+        const std::size_t used = std::min(kBlock, boxes.size() - base);
+        const std::uint32_t live = (1u << used) - 1;
+        std::uint32_t empty = 0;
+        std::uint32_t moved = 0;
+        for (std::size_t k = 0; k < used; ++k) {
+            if (boxes.isEmpty(base + k)) {
+                empty |= 1u << k;
+            }
+        }
+
+        for (std::size_t round = 0; round < maxRounds_ && (live & ~empty); ++round) {
+            for (std::size_t j = 0; j < variables_.size(); ++j) {
+                const double* lo = boxes.lowerAt(columns[j]) + base;
+                const double* hi = boxes.upperAt(columns[j]) + base;
+                std::copy(lo, lo + kBlock, blockBounds_.begin() + 2 * j * kBlock);
+                std::copy(hi, hi + kBlock, blockBounds_.begin() + (2 * j + 1) * kBlock);
+            }
+            for (const Constraint& constraint : constraints_) {
+                ++revisions;
+                empty |= reviseBlock(constraint, boxes, base) & live;
+                if (!(live & ~empty)) {
+                    break;
+                }
+            }
+            std::uint32_t progress = 0;
+            for (std::size_t j = 0; j < variables_.size(); ++j) {
+                const double* lo = boxes.lowerAt(columns[j]) + base;
+                const double* hi = boxes.upperAt(columns[j]) + base;
+                const double* lo0 = blockBounds_.data() + 2 * j * kBlock;
+                const double* hi0 = lo0 + kBlock;
+                for (std::size_t k = 0; k < used; ++k) {
+                    Change change = compareBounds(lo0[k], hi0[k], lo[k], hi[k], minProgress_);
+                    if (change != Change::None) {
+                        moved |= 1u << k;
+                    }
+                    if (change == Change::Progress) {
+                        progress |= 1u << k;
+                    }
+                }
+            }
+            if (!(progress & live & ~empty)) {
+                break;
+            }
+        }
+
+        for (std::size_t k = 0; k < used; ++k) {
+            if (empty & (1u << k)) {
+                boxes.markEmpty(base + k);
+                status[base + k] = domain::BoxBatch::kEmpty;
+            } else if (moved & (1u << k)) {
+                status[base + k] = domain::BoxBatch::kContracted;
+            }
+        }
+    }
+    return revisions;
+}
+
+} // namespace backends
+} // namespace semcal
@@ -1,4 +1,5 @@
 #include "semcal/backends/icp_backend.h"
+#include "semcal/domain/interval_box.h"
 #include <sstream>
 
 namespace semcal {
@@ -13,15 +14,85 @@ std::string IcpContractWitness::toString() const {
     return oss.str();
 }
 
+// SplitHeuristic names
+std::string splitHeuristicName(SplitHeuristic heuristic) {
+    switch (heuristic) {
+        case SplitHeuristic::ROUND_ROBIN: return "round-robin";
+        case SplitHeuristic::LARGEST_WIDTH: return "largest-width";
+        case SplitHeuristic::MAX_SMEAR: return "max-smear";
+    }
+    return "unknown";
+}
+
+bool parseSplitHeuristic(const std::string& name, SplitHeuristic& heuristic) {
+    for (SplitHeuristic h : {SplitHeuristic::ROUND_ROBIN, SplitHeuristic::LARGEST_WIDTH, SplitHeuristic::MAX_SMEAR}) {
+        if (name == splitHeuristicName(h)) {
+            heuristic = h;
+            return true;
+        }
+    }
+    return false;
+}
+
 // IcpDecompWitness implementation
 std::string IcpDecompWitness::toString() const {
     std::ostringstream oss;
     oss << "ICP Decomposition: " << numBoxes << " boxes, split on " 
         << splitVar << " at " << splitPoint;
+    for (size_t i = 1; i < splitPoints.size(); ++i) {
+        oss << ", " << splitPoints[i];
+    }
+    if (!heuristic.empty()) {
+        oss << " (" << heuristic << ")";
+    }
+    return oss.str();
+}
+
+// IcpBatchWitness implementation
+std::string IcpBatchWitness::toString() const {
+    std::ostringstream oss;
+    oss << "ICP Batch Contraction: method=" << contractionMethod
+        << ", " << numBoxes << " boxes, " << numContracted << " contracted, "
+        << numEmpty << " empty";
     return oss.str();
 }
 
 // IcpBackend implementation
+util::OpResult<std::vector<std::uint8_t>, IcpBatchWitness> IcpBackend::contractBatch(
+    const core::Formula& formula,
+    domain::BoxBatch& boxes) {
+    util::OpResult<std::vector<std::uint8_t>, IcpBatchWitness> result;
+    result.status = util::OpStatus::OK;
+    result.value.emplace(boxes.size(), std::uint8_t{0});
+    std::vector<std::uint8_t>& status = *result.value;
+    IcpBatchWitness witness;
+    witness.numBoxes = boxes.size();
+
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        domain::IntervalBox box = boxes.extract(i);
+        auto contracted = contract(formula, box);
+        if (contracted.status != util::OpStatus::OK || !contracted.value) {
+            continue;
+        }
+        const auto* narrowed = dynamic_cast<const domain::IntervalBox*>(contracted.value->get());
+        if (!narrowed) {
+            continue;
+        }
+        witness.contractionMethod = contracted.witness.contractionMethod;
+        if (narrowed->isEmpty()) {
+            boxes.markEmpty(i);
+            status[i] = domain::BoxBatch::kEmpty;
+            ++witness.numEmpty;
+        } else if (!narrowed->equals(box)) {
+            boxes.assign(i, *narrowed);
+            status[i] = domain::BoxBatch::kContracted;
+            ++witness.numContracted;
+        }
+    }
+    result.witness = std::move(witness);
+    return result;
+}
+
 bool IcpBackend::supportsOperator(const std::string& opName) const {
     return opName == "Restrict" || opName == "Decompose" || opName == "Infeasible";
 }
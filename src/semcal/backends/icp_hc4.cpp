@@ -0,0 +1,227 @@
+#include "semcal/backends/icp_hc4.h"
+#include "semcal/domain/interval_box.h"
+#include <algorithm>
+#include <cmath>
+
+namespace semcal {
+namespace backends {
+
+namespace {
+
+domain::IntervalBox toBox(const domain::AbstractElement& element) {
+    const auto* box = dynamic_cast<const domain::IntervalBox*>(&element);
+    return box ? *box : domain::IntervalBox();
+}
+
+// Split point of [lo, hi]: the midpoint, or a finite point for unbounded sides.
+double splitPoint(double lo, double hi) {
+    const double inf = domain::IntervalBox::kInfinity;
+    if (lo == -inf && hi == inf) {
+        return 0.0;
+    }
+    if (lo == -inf) {
+        return hi > 0 ? -hi : 2 * hi - 1;
+    }
+    if (hi == inf) {
+        return lo < 0 ? -lo : 2 * lo + 1;
+    }
+    return lo + (hi - lo) / 2;
+}
+
+} // namespace
+
+IcpPropagator& Hc4IcpBackend::propagatorFor(const core::Formula& formula) {
+    core::TermId term = formula.getTerm();
+    if (!propagator_ || term != cachedTerm_) {
+        propagator_ = std::make_unique<IcpPropagator>(formula);
+        propagator_->getContractor().setMaxRounds(maxRounds_);
+        propagator_->getContractor().setMinProgress(minProgress_);
+        propagator_->setMinImprovement(minProgress_);
+        cachedTerm_ = term;
+        nextSplit_ = 0;
+    }
+    return *propagator_;
+}
+
+void Hc4IcpBackend::setMaxRounds(std::size_t rounds) {
+    maxRounds_ = rounds;
+    if (propagator_) {
+        propagator_->getContractor().setMaxRounds(rounds);
+    }
+}
+
+void Hc4IcpBackend::setMinProgress(double ratio) {
+    minProgress_ = ratio;
+    if (propagator_) {
+        propagator_->getContractor().setMinProgress(ratio);
+        propagator_->setMinImprovement(ratio);
+    }
+}
+
+util::OpResult<std::unique_ptr<domain::AbstractElement>, IcpContractWitness>
+Hc4IcpBackend::contract(
+    const core::Formula& formula,
+    const domain::AbstractElement& abstractElement) {
+    auto box = std::make_unique<domain::IntervalBox>(toBox(abstractElement));
+    Hc4Contractor::Outcome outcome = propagatorFor(formula).propagate(*box);
+
+    IcpContractWitness witness;
+    witness.contractionMethod = "HC4";
+    witness.roundingMode = "directed-rounding";
+    const core::SymbolTable& symbols = core::TermStore::global().symbols();
+    for (core::VariableId var : outcome.contracted) {
+        witness.contractedVars.push_back(symbols.name(var));
+    }
+
+    util::OpResult<std::unique_ptr<domain::AbstractElement>, IcpContractWitness> result;
+    result.status = util::OpStatus::OK;
+    result.value = std::move(box);
+    result.witness = std::move(witness);
+    result.progress = !outcome.contracted.empty() || outcome.empty;
+    return result;
+}
+
+util::OpResult<std::vector<std::uint8_t>, IcpBatchWitness>
+Hc4IcpBackend::contractBatch(
+    const core::Formula& formula,
+    domain::BoxBatch& boxes) {
+    util::OpResult<std::vector<std::uint8_t>, IcpBatchWitness> result;
+    result.status = util::OpStatus::OK;
+    result.value.emplace();
+    propagatorFor(formula).getContractor().contractBatch(boxes, *result.value);
+
+    IcpBatchWitness witness;
+    witness.numBoxes = boxes.size();
+    witness.contractionMethod = "HC4";
+    for (std::uint8_t flags : *result.value) {
+        witness.numContracted += (flags & domain::BoxBatch::kContracted) ? 1 : 0;
+        witness.numEmpty += (flags & domain::BoxBatch::kEmpty) ? 1 : 0;
+    }
+    result.witness = std::move(witness);
+    return result;
+}
+
+std::size_t Hc4IcpBackend::chooseSplit(Hc4Contractor& contractor, const domain::IntervalBox& box) {
+    const std::vector<core::VariableId>& vars = contractor.getVariables();
+    const std::size_t n = vars.size();
+    auto splittable = [&](std::size_t j) {
+        double lo = box.lower(vars[j]);
+        double hi = box.upper(vars[j]);
+        double mid = splitPoint(lo, hi);
+        return lo < mid && mid < hi;
+    };
+    auto largest = [&](const std::vector<double>& score) {
+        std::size_t best = n;
+        for (std::size_t j = 0; j < n; ++j) {
+            if (splittable(j) && (best == n || score[j] > score[best])) {
+                best = j;
+            }
+        }
+        return best;
+    };
+
+    std::vector<double> widths(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        widths[j] = box.width(vars[j]);
+    }
+
+    switch (heuristic_) {
+        case SplitHeuristic::ROUND_ROBIN:
+            for (std::size_t t = 0; t < n; ++t) {
+                std::size_t j = (nextSplit_ + t) % n;
+                if (splittable(j)) {
+                    nextSplit_ = j + 1;
+                    return j;
+                }
+            }
+            return n;
+        case SplitHeuristic::LARGEST_WIDTH:
+            return largest(widths);
+        case SplitHeuristic::MAX_SMEAR: {
+            std::vector<double> smear(n, 0.0);
+            std::vector<util::FastInterval> gradient;
+            for (std::size_t c = 0; c < contractor.numConstraints(); ++c) {
+                contractor.derivatives(c, box, gradient);
+                const std::vector<core::VariableId>& cvars = contractor.getConstraintVariables(c);
+                for (std::size_t k = 0; k < cvars.size(); ++k) {
+                    std::size_t j = std::lower_bound(vars.begin(), vars.end(), cvars[k]) - vars.begin();
+                    double magnitude = std::max(-gradient[k].lo(), gradient[k].hi);
+                    double value = magnitude > 0 && widths[j] > 0 ? magnitude * widths[j] : 0.0;
+                    smear[j] = std::max(smear[j], value);
+                }
+            }
+            std::size_t best = largest(smear);
+            // No variable has any influence on the box: fall back to width.
+            return best < n && smear[best] > 0 ? best : largest(widths);
+        }
+    }
+    return n;
+}
+
+util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>, IcpDecompWitness>
+Hc4IcpBackend::decompose(
+    const core::Formula& formula,
+    const domain::AbstractElement& abstractElement) {
+    using Result = util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>, IcpDecompWitness>;
+    domain::IntervalBox box = toBox(abstractElement);
+    Hc4Contractor& contractor = propagatorFor(formula).getContractor();
+    const std::size_t n = contractor.getVariables().size();
+    std::size_t chosen = box.isEmpty() ? n : chooseSplit(contractor, box);
+
+    Result result;
+    result.status = util::OpStatus::OK;
+    result.value.emplace();
+    result.witness.heuristic = splitHeuristicName(heuristic_);
+    if (chosen == n) {
+        result.value->push_back(std::make_unique<state::SemanticState>(
+            formula.clone(), std::make_unique<domain::IntervalBox>(box)));
+        result.witness.numBoxes = 1;
+        result.witness.splitPoint = 0.0;
+        result.progress = false;
+        return result;
+    }
+
+    core::VariableId splitVar = contractor.getVariables()[chosen];
+    double lo = box.lower(splitVar);
+    double hi = box.upper(splitVar);
+    std::vector<double> cuts;
+    if (std::isfinite(lo) && std::isfinite(hi)) {
+        for (std::size_t i = 1; i < splitWays_; ++i) {
+            double t = static_cast<double>(i) / static_cast<double>(splitWays_);
+            double cut = lo * (1 - t) + hi * t;
+            if (cut > (cuts.empty() ? lo : cuts.back()) && cut < hi) {
+                cuts.push_back(cut);
+            }
+        }
+    }
+    if (cuts.empty()) {
+        cuts.push_back(splitPoint(lo, hi));
+    }
+
+    double from = lo;
+    for (std::size_t i = 0; i <= cuts.size(); ++i) {
+        double to = i < cuts.size() ? cuts[i] : hi;
+        auto piece = std::make_unique<domain::IntervalBox>(box);
+        piece->set(splitVar, from, to);
+        result.value->push_back(std::make_unique<state::SemanticState>(formula.clone(), std::move(piece)));
+        from = to;
+    }
+    result.witness.numBoxes = cuts.size() + 1;
+    result.witness.splitVar = core::TermStore::global().symbols().name(splitVar);
+    result.witness.splitPoint = cuts.front();
+    result.witness.splitPoints = std::move(cuts);
+    return result;
+}
+
+util::OpResult<void, std::monostate> Hc4IcpBackend::infeasible(
+    const core::Formula& formula,
+    const domain::AbstractElement& abstractElement) {
+    domain::IntervalBox box = toBox(abstractElement);
+    if (propagatorFor(formula).propagate(box).empty) {
+        return util::OpResult<void, std::monostate>::unsat();
+    }
+    return util::OpResult<void, std::monostate>::unknown();
+}
+
+} // namespace backends
+} // namespace semcal
@@ -0,0 +1,107 @@
+#include "semcal/backends/icp_propagator.h"
+
+namespace semcal {
+namespace backends {
+
+IcpPropagator::IcpPropagator(const core::Formula& formula)
+    : contractor_(formula) {
+    watches_.resize(contractor_.getVariables().size());
+    for (std::size_t c = 0; c < contractor_.numConstraints(); ++c) {
+        for (core::VariableId var : contractor_.getConstraintVariables(c)) {
+            watches_[contractor_.variableIndex(var)].push_back(static_cast<std::uint32_t>(c));
+        }
+    }
+    queued_.assign(contractor_.numConstraints(), false);
+}
+
+const std::vector<std::uint32_t>& IcpPropagator::getWatchers(core::VariableId variable) const {
+    static const std::vector<std::uint32_t> none;
+    std::size_t i = contractor_.variableIndex(variable);
+    return i != Hc4Contractor::kNoVariable ? watches_[i] : none;
+}
+
+void IcpPropagator::enqueue(std::uint32_t constraint) {
+    if (!queued_[constraint]) {
+        queued_[constraint] = true;
+        queue_.push_back(constraint);
+    }
+}
+
+Hc4Contractor::Outcome IcpPropagator::propagate(domain::IntervalBox& box) {
+    for (std::size_t c = 0; c < contractor_.numConstraints(); ++c) {
+        enqueue(static_cast<std::uint32_t>(c));
+    }
+    return run(box);
+}
+
+Hc4Contractor::Outcome IcpPropagator::propagate(domain::IntervalBox& box,
+                                                const std::vector<core::VariableId>& changed) {
+    for (core::VariableId var : changed) {
+        for (std::uint32_t c : getWatchers(var)) {
+            enqueue(c);
+        }
+    }
+    return run(box);
+}
+
+Hc4Contractor::Outcome IcpPropagator::run(domain::IntervalBox& box) {
+    Hc4Contractor::Outcome outcome;
+    std::size_t budget = maxRevisions_ ? maxRevisions_ : 32 * contractor_.numConstraints();
+    std::vector<bool> moved(watches_.size(), false);  // by variableIndex()
+    box.addSlots(contractor_.getVariables());  // once, rather than per revision
+
+    while (!queue_.empty() && !box.isEmpty()) {
+        if (outcome.revisions == budget) {
+            break;
+        }
+        std::uint32_t c = queue_.front();
+        queue_.pop_front();
+        queued_[c] = false;
+
+        const std::vector<core::VariableId>& vars = contractor_.getConstraintVariables(c);
+        bounds_.resize(2 * vars.size());
+        for (std::size_t j = 0; j < vars.size(); ++j) {
+            bounds_[2 * j] = box.lower(vars[j]);
+            bounds_[2 * j + 1] = box.upper(vars[j]);
+        }
+        ++outcome.revisions;
+        if (!contractor_.revise(c, box)) {
+            break;
+        }
+        for (std::size_t j = 0; j < vars.size(); ++j) {
+            Hc4Contractor::Change change = Hc4Contractor::compareBounds(
+                bounds_[2 * j], bounds_[2 * j + 1], box.lower(vars[j]), box.upper(vars[j]), minImprovement_);
+            if (change == Hc4Contractor::Change::None) {
+                continue;
+            }
+            std::size_t index = contractor_.variableIndex(vars[j]);
+            moved[index] = true;
+            if (change != Hc4Contractor::Change::Progress) {
+                continue;
+            }
+            // HC4-revise is close to idempotent, so c itself is not requeued.
+            for (std::uint32_t watcher : watches_[index]) {
+                if (watcher != c) {
+                    enqueue(watcher);
+                }
+            }
+        }
+    }
+
+    // Leave no work behind for the next call.
+    for (std::uint32_t c : queue_) {
+        queued_[c] = false;
+    }
+    queue_.clear();
+
+    outcome.empty = box.isEmpty();
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+        if (moved[i]) {
+            outcome.contracted.push_back(contractor_.getVariables()[i]);
+        }
+    }
+    return outcome;
+}
+
+} // namespace backends
+} // namespace semcal
@@ -0,0 +1,205 @@
+#include "semcal/backends/lp_simplex.h"
+#include "semcal/core/term_store.h"
+#include "semcal/domain/interval_box.h"
+#include <cmath>
+#include <sstream>
+
+namespace semcal {
+namespace backends {
+
+using util::Rational;
+
+void LpSimplexBackend::reset() {
+    if (simplex_) {
+        pivotsBefore_ += simplex_->getPivotCount();
+    }
+    simplex_.reset();
+    loadedTerm_ = core::kNullTerm;
+    system_.reset();
+    labels_.clear();
+    levels_.clear();
+}
+
+bool LpSimplexBackend::load(const core::Formula& formula) {
+    core::TermId term = formula.getTerm();
+    if (term == loadedTerm_) {
+        return simplex_ != nullptr;
+    }
+
+    reset();
+    loadedTerm_ = term;
+    std::shared_ptr<const core::LinearSystem> system = formula.getLinearSystem();
+    if (system->empty()) {
+        return false;
+    }
+    system_ = std::move(system);
+    simplex_ = std::make_unique<Simplex>();
+    for (std::size_t j = 0; j < system_->numColumns(); ++j) {
+        simplex_->addVariable();
+    }
+    std::vector<std::pair<Simplex::Var, Rational>> coeffs;
+    for (std::size_t i = 0; i < system_->numRows(); ++i) {
+        coeffs.clear();
+        for (std::size_t k = system_->rowBegin(i); k < system_->rowEnd(i); ++k) {
+            coeffs.emplace_back(system_->column(k), system_->coefficient(k));
+        }
+        Simplex::Var slack = simplex_->addRow(coeffs);
+        auto reason = static_cast<std::uint32_t>(labels_.size());
+        labels_.push_back("row " + std::to_string(i));
+        if (system_->hasLower(i)) {
+            simplex_->setLower(slack, system_->lower(i), reason);
+        }
+        if (system_->hasUpper(i)) {
+            simplex_->setUpper(slack, system_->upper(i), reason);
+        }
+    }
+    return true;
+}
+
+void LpSimplexBackend::push() {
+    simplex_->push();
+    levels_.push_back(Level{labels_.size(), {}});
+}
+
+void LpSimplexBackend::pop() {
+    simplex_->pop();
+    labels_.resize(levels_.back().labels);
+    levels_.pop_back();
+}
+
+void LpSimplexBackend::assertBound(core::LinearSystem::Column column, const Rational& value, bool upper,
+                                   bool model) {
+    auto reason = static_cast<std::uint32_t>(labels_.size());
+    labels_.push_back((model ? "model " : "box ") +
+                      core::TermStore::global().symbols().name(system_->variable(column)));
+    if (upper) {
+        simplex_->setUpper(column, value, reason);
+    } else {
+        simplex_->setLower(column, value, reason);
+    }
+    if (!levels_.empty()) {
+        levels_.back().bounds.push_back(Assertion{column, upper, model, value});
+    }
+}
+
+bool LpSimplexBackend::tightenLower(core::VariableId variable, const Rational& value) {
+    core::LinearSystem::Column column;
+    if (!system_->columnOf(variable, column)) {
+        return false;
+    }
+    assertBound(column, value, false, false);
+    return true;
+}
+
+bool LpSimplexBackend::tightenUpper(core::VariableId variable, const Rational& value) {
+    core::LinearSystem::Column column;
+    if (!system_->columnOf(variable, column)) {
+        return false;
+    }
+    assertBound(column, value, true, false);
+    return true;
+}
+
+util::OpResult<void, LpWitness> LpSimplexBackend::check() {
+    if (simplex_->check(maxPivots_) != Simplex::Result::UNSAT) {
+        return util::OpResult<void, LpWitness>::unknown();
+    }
+    std::ostringstream certificate;
+    certificate << "(farkas";
+    for (const Simplex::FarkasTerm& term : simplex_->conflict()) {
+        certificate << " (" << labels_[term.reason] << (term.upper ? " upper " : " lower ")
+                    << term.multiplier.toString() << ")";
+    }
+    certificate << ")";
+    return util::OpResult<void, LpWitness>::unsat({certificate.str()});
+}
+
+bool LpSimplexBackend::implies(const state::SemanticState& σ, const Level& level) const {
+    // A kept bound stays justified if σ bounds the variable at least as
+    // tightly, from the same source: certificates name the source, and
+    // the kernel re-reads the bound from σ.
+    const auto* box = dynamic_cast<const domain::IntervalBox*>(&σ.getAbstractElement());
+    for (const Assertion& assertion : level.bounds) {
+        core::VariableId var = system_->variable(assertion.column);
+        Rational bound;
+        if (assertion.model) {
+            const core::Value& value = σ.getPartialModel().get(var);
+            if (!value.isNumber()) {
+                return false;
+            }
+            bound = value.toRational();
+        } else {
+            if (!box) {
+                return false;
+            }
+            double value = assertion.upper ? box->upper(var) : box->lower(var);
+            if (!std::isfinite(value)) {
+                return false;
+            }
+            bound = Rational::fromDouble(value);
+        }
+        if (assertion.upper ? assertion.value < bound : bound < assertion.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+util::OpResult<void, LpWitness>
+LpSimplexBackend::refute(const state::SemanticState& σ) {
+    if (!incremental_) {
+        reset();
+    }
+    if (!load(σ.getFormula())) {
+        return util::OpResult<void, LpWitness>::unknown();
+    }
+
+    // Keep the levels of σ's ancestors, drop those of other branches.
+    std::size_t kept = 0;
+    while (kept < levels_.size() && implies(σ, levels_[kept])) {
+        ++kept;
+    }
+    while (levels_.size() > kept) {
+        pop();
+    }
+
+    // Assert the bounds implied by the partial model and the abstract
+    // element that are tighter than the kept ones.
+    push();
+    auto assertTighter = [&](core::LinearSystem::Column column, const Rational& value, bool upper, bool model) {
+        const Rational* current = upper ? simplex_->getUpper(column) : simplex_->getLower(column);
+        if (!current || (upper ? value < *current : *current < value)) {
+            assertBound(column, value, upper, model);
+        }
+    };
+    σ.getPartialModel().forEach([&](core::VariableId var, const core::Value& value) {
+        core::LinearSystem::Column column;
+        if (value.isNumber() && system_->columnOf(var, column)) {
+            Rational exact = value.toRational();
+            assertTighter(column, exact, false, true);
+            assertTighter(column, exact, true, true);
+        }
+    });
+    if (const auto* box = dynamic_cast<const domain::IntervalBox*>(&σ.getAbstractElement())) {
+        for (core::LinearSystem::Column column = 0; column < system_->numColumns(); ++column) {
+            core::VariableId var = system_->variable(column);
+            double lo = box->lower(var);
+            double hi = box->upper(var);
+            if (std::isfinite(lo)) {
+                assertTighter(column, Rational::fromDouble(lo), false, false);
+            }
+            if (std::isfinite(hi)) {
+                assertTighter(column, Rational::fromDouble(hi), true, false);
+            }
+        }
+    }
+
+    auto result = check();
+    if (levels_.back().bounds.empty()) {
+        pop();
+    }
+    return result;
+}
+
+} // namespace backends
+} // namespace semcal
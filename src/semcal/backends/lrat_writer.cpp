@@ -0,0 +1,50 @@
+#include "semcal/backends/lrat_writer.h"
+
+namespace semcal {
+namespace backends {
+
+void LratWriter::add(std::uint64_t id, const core::Lit* lits, std::size_t count,
+                     const std::uint64_t* hints, std::size_t numHints) {
+    buffer_.push_back('a');
+    put(2 * id);
+    for (std::size_t i = 0; i < count; ++i) {
+        put(static_cast<std::uint64_t>(lits[i]) + 2);  // 2(v + 1) + sign
+    }
+    put(0);
+    for (std::size_t i = 0; i < numHints; ++i) {
+        put(2 * hints[i]);
+    }
+    put(0);
+    endStep();
+}
+
+void LratWriter::remove(const std::uint64_t* ids, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    buffer_.push_back('d');
+    for (std::size_t i = 0; i < count; ++i) {
+        put(2 * ids[i]);
+    }
+    put(0);
+    endStep();
+}
+
+void LratWriter::endStep() {
+    ++steps_;
+    if (sink_ && buffer_.size() >= chunkSize_) {
+        flush();
+    }
+}
+
+void LratWriter::flush() {
+    if (!sink_ || buffer_.empty()) {
+        return;
+    }
+    sink_(buffer_.data(), buffer_.size());
+    flushed_ += buffer_.size();
+    buffer_.clear();
+}
+
+} // namespace backends
+} // namespace semcal
@@ -0,0 +1,56 @@
+#include "semcal/backends/sat_backend.h"
+#include <sstream>
+
+namespace semcal {
+namespace backends {
+
+// SatDecompWitness implementation
+std::string SatDecompWitness::toString() const {
+    if (splitVar.empty()) {
+        return "SAT Decomposition: no variable left to split";
+    }
+    std::ostringstream oss;
+    oss << "SAT Decomposition: split on " << splitVar << ", "
+        << (firstValue ? "true" : "false") << " first (activity " << activity << ")";
+    return oss.str();
+}
+
+// SatUnsatWitness implementation
+std::string SatUnsatWitness::toString() const {
+    std::ostringstream oss;
+    oss << "SAT Refutation: " << conflicts << " conflicts";
+    if (failedAssumptions.empty()) {
+        oss << ", formula unsatisfiable";
+    } else {
+        oss << ", failed assumptions:";
+        for (const std::string& a : failedAssumptions) {
+            oss << " " << a;
+        }
+    }
+    if (!proofFile.empty()) {
+        oss << ", LRAT proof in " << proofFile;
+    }
+    return oss.str();
+}
+
+// SatRefineWitness implementation
+std::string SatRefineWitness::toString() const {
+    std::ostringstream oss;
+    oss << "SAT Refinement: learned " << clause << " after " << conflicts << " conflicts";
+    return oss.str();
+}
+
+// SatBackend implementation
+bool SatBackend::supportsOperator(const std::string& opName) const {
+    return opName == "Decompose" || opName == "Infeasible" || opName == "Refine";
+}
+
+ApproxDirection SatBackend::getApproxDirection(const std::string& opName) const {
+    if (opName == "Decompose") return ApproxDirection::PRESERVING;
+    if (opName == "Infeasible") return ApproxDirection::REFUTE_CERTIFIED;
+    if (opName == "Refine") return ApproxDirection::PRESERVING;
+    return ApproxDirection::PRESERVING;
+}
+
+} // namespace backends
+} // namespace semcal
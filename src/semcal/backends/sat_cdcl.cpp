@@ -0,0 +1,173 @@
+#include "semcal/backends/sat_cdcl.h"
+#include "semcal/core/cnf_formula.h"
+#include "semcal/core/partial_model.h"
+
+namespace semcal {
+namespace backends {
+
+using core::Lit;
+using core::Var;
+
+CdclSatBackend::CdclSatBackend()
+    : solver_(std::make_unique<CdclSolver>()) {
+}
+
+void CdclSatBackend::setProofFile(std::string path) {
+    proofFile_ = std::move(path);
+    // Reload on the next call so the proof starts with the formula.
+    loadedTerm_ = core::kNullTerm;
+    loadedArena_.reset();
+}
+
+void CdclSatBackend::startProof() {
+    proof_.reset();
+    proofStream_.reset();
+    if (proofFile_.empty()) {
+        return;
+    }
+    proofStream_ = std::make_unique<std::ofstream>(proofFile_, std::ios::binary | std::ios::trunc);
+    std::ofstream* stream = proofStream_.get();
+    proof_ = std::make_unique<LratWriter>([stream](const std::uint8_t* data, std::size_t size) {
+        stream->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    });
+    solver_->setProof(proof_.get());
+}
+
+void CdclSatBackend::load(const core::Formula& formula) {
+    const auto* cnf = dynamic_cast<const core::CnfFormula*>(&formula);
+    if (cnf && cnf->getArena() == loadedArena_) {
+        return;
+    }
+    core::TermId term = cnf ? core::kNullTerm : formula.getTerm();
+    if (!cnf && term == loadedTerm_) {
+        return;
+    }
+
+    solver_ = std::make_unique<CdclSolver>();
+    loadedArena_.reset();
+    loadedTerm_ = core::kNullTerm;
+    startProof();
+    encoder_.encode(formula);
+    solver_->ensureVariables(encoder_.numVariables());
+    solver_->addClauses(encoder_.getClauses());
+    if (cnf) {
+        loadedArena_ = cnf->getArena();
+    } else {
+        loadedTerm_ = term;
+    }
+}
+
+std::string CdclSatBackend::literalName(Lit lit) const {
+    const core::TermStore& store = core::TermStore::global();
+    core::TermId atom = encoder_.atomTerm(core::litVar(lit));
+    std::string name = atom != core::kNullTerm ? store.toString(atom)
+                                               : store.symbols().name(encoder_.variable(core::litVar(lit)));
+    return core::litNegated(lit) ? "(not " + name + ")" : name;
+}
+
+util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>, SatDecompWitness>
+CdclSatBackend::decompose(const state::SemanticState& σ) {
+    using Result = util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>, SatDecompWitness>;
+    load(σ.getFormula());
+
+    const core::PartialModel& μ = σ.getPartialModel();
+    Var best = solver_->numVariables();
+    for (Var v = 0; v < solver_->numVariables(); ++v) {
+        if (!encoder_.isInput(v) || solver_->isFixed(v) || μ.get(encoder_.variable(v)).isBool()) {
+            continue;
+        }
+        if (best == solver_->numVariables() || solver_->getActivity(v) > solver_->getActivity(best)) {
+            best = v;
+        }
+    }
+    if (best == solver_->numVariables()) {
+        // Every input is assigned: σ is a leaf, not a failure.
+        std::vector<std::unique_ptr<state::SemanticState>> states;
+        states.push_back(σ.clone());
+        Result result = Result::ok(std::move(states));
+        result.progress = false;
+        return result;
+    }
+
+    SatDecompWitness witness;
+    witness.splitVar = core::TermStore::global().symbols().name(encoder_.variable(best));
+    witness.firstValue = solver_->getPhase(best);
+    witness.activity = solver_->getActivity(best);
+
+    std::vector<std::unique_ptr<state::SemanticState>> states;
+    for (bool value : {witness.firstValue, !witness.firstValue}) {
+        auto child = std::make_shared<core::PartialModel>(μ);
+        child->set(encoder_.variable(best), core::Value::boolean(value));
+        states.push_back(σ.withPartialModel(std::move(child)));
+    }
+    Result result = Result::ok(std::move(states));
+    result.witness = std::move(witness);
+    return result;
+}
+
+util::OpResult<void, SatUnsatWitness> CdclSatBackend::refute(const state::SemanticState& σ) {
+    load(σ.getFormula());
+
+    std::uint64_t before = solver_->getStats().conflicts;
+    switch (solver_->solve(encoder_.literalsOf(σ.getPartialModel()), maxConflicts_)) {
+    case CdclSolver::Result::SAT:
+        // A model of the abstraction may violate the theory atoms.
+        if (!encoder_.isPropositional()) {
+            return util::OpResult<void, SatUnsatWitness>::unknown();
+        }
+        return util::OpResult<void, SatUnsatWitness>::ok();
+    case CdclSolver::Result::UNKNOWN:
+        return util::OpResult<void, SatUnsatWitness>::unknown();
+    case CdclSolver::Result::UNSAT:
+        break;
+    }
+    SatUnsatWitness witness;
+    witness.conflicts = solver_->getStats().conflicts - before;
+    for (Lit lit : solver_->finalConflict()) {
+        witness.failedAssumptions.push_back(literalName(core::litNegate(lit)));
+    }
+    if (proof_) {
+        proof_->flush();
+        proofStream_->flush();
+        witness.proofFile = proofFile_;
+    }
+    return util::OpResult<void, SatUnsatWitness>::unsat(std::move(witness));
+}
+
+util::OpResult<std::unique_ptr<core::Formula>, SatRefineWitness> CdclSatBackend::refine(
+    const core::Formula& originalFormula,
+    const core::Formula& relaxedFormula,
+    const core::Model& spuriousModel) {
+    using Result = util::OpResult<std::unique_ptr<core::Formula>, SatRefineWitness>;
+    (void)relaxedFormula;
+    const auto* model = dynamic_cast<const core::ConcreteModel*>(&spuriousModel);
+    if (!model) {
+        return Result::unknown();
+    }
+    load(originalFormula);
+
+    std::uint64_t before = solver_->getStats().conflicts;
+    if (solver_->solve(encoder_.literalsOf(*model), maxConflicts_) != CdclSolver::Result::UNSAT) {
+        return Result::unknown();
+    }
+
+    // The final conflict is a clause of negated assumptions: implied by
+    // F, and false in M because M sets every assumption.
+    core::TermStore& store = core::TermStore::global();
+    std::vector<core::TermId> lits;
+    for (Lit lit : solver_->finalConflict()) {
+        core::TermId atom = store.mkLeaf(encoder_.variable(core::litVar(lit)));
+        lits.push_back(core::litNegated(lit) ? store.mkNot(atom) : atom);
+    }
+    auto clause = std::make_unique<core::ConcreteFormula>(store.mkOr(lits));
+
+    SatRefineWitness witness;
+    witness.clause = clause->toString();
+    witness.conflicts = solver_->getStats().conflicts - before;
+    Result result = Result::ok(std::move(clause));
+    result.witness = std::move(witness);
+    return result;
+}
+
+} // namespace backends
+} // namespace semcal
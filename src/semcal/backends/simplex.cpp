@@ -0,0 +1,293 @@
+#include "semcal/backends/simplex.h"
+#include <algorithm>
+#include <limits>
+
+namespace semcal {
+namespace backends {
+
+using util::Rational;
+
+namespace {
+
+template <class Entry>
+bool byVar(const Entry& entry, std::uint32_t var) {
+    return entry.var < var;
+}
+
+} // namespace
+
+Simplex::Var Simplex::addVariable() {
+    vars_.emplace_back();
+    columns_.emplace_back();
+    return static_cast<Var>(vars_.size() - 1);
+}
+
+Simplex::Var Simplex::addRow(const std::vector<std::pair<Var, Rational>>& coeffs) {
+    Var slack = addVariable();
+    Row row;
+    Rational value;
+    for (const auto& [v, a] : coeffs) {
+        if (a.isZero()) {
+            continue;
+        }
+        value += a * vars_[v].value;
+        if (vars_[v].row >= 0) {
+            // Substitute the basic variable by its row.
+            for (const Entry& entry : rows_[vars_[v].row]) {
+                row.push_back(Entry{entry.var, a * entry.coeff});
+            }
+        } else {
+            row.push_back(Entry{v, a});
+        }
+    }
+
+    // Sort, merge repeated variables and drop cancelled ones.
+    std::sort(row.begin(), row.end(), [](const Entry& a, const Entry& b) { return a.var < b.var; });
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < row.size(); ++i) {
+        if (size > 0 && row[size - 1].var == row[i].var) {
+            row[size - 1].coeff += row[i].coeff;
+            continue;
+        }
+        if (size > 0 && row[size - 1].coeff.isZero()) {
+            --size;
+        }
+        if (size != i) {
+            row[size] = std::move(row[i]);
+        }
+        ++size;
+    }
+    if (size > 0 && row[size - 1].coeff.isZero()) {
+        --size;
+    }
+    row.resize(size);
+
+    auto r = static_cast<std::uint32_t>(rows_.size());
+    for (const Entry& entry : row) {
+        columns_[entry.var].push_back(r);
+    }
+    vars_[slack].value = value;
+    vars_[slack].row = static_cast<std::int32_t>(r);
+    rows_.push_back(std::move(row));
+    basic_.push_back(slack);
+    return slack;
+}
+
+const Rational& Simplex::coefficient(std::size_t row, Var v) const {
+    const Row& entries = rows_[row];
+    return std::lower_bound(entries.begin(), entries.end(), v, byVar<Entry>)->coeff;
+}
+
+void Simplex::unlink(std::size_t row, Var v) {
+    std::vector<std::uint32_t>& column = columns_[v];
+    auto it = std::find(column.begin(), column.end(), static_cast<std::uint32_t>(row));
+    *it = column.back();
+    column.pop_back();
+}
+
+void Simplex::setLower(Var v, const Rational& value, std::uint32_t reason) {
+    Bound& lower = vars_[v].lower;
+    if (lower.present && value <= lower.value) {
+        return;
+    }
+    if (!levels_.empty()) {
+        trail_.push_back(TrailEntry{v, false, lower});
+    }
+    lower = Bound{true, value, reason};
+    if (vars_[v].row < 0 && vars_[v].value < value) {
+        updateNonbasic(v, value);
+    }
+}
+
+void Simplex::setUpper(Var v, const Rational& value, std::uint32_t reason) {
+    Bound& upper = vars_[v].upper;
+    if (upper.present && value >= upper.value) {
+        return;
+    }
+    if (!levels_.empty()) {
+        trail_.push_back(TrailEntry{v, true, upper});
+    }
+    upper = Bound{true, value, reason};
+    if (vars_[v].row < 0 && vars_[v].value > value) {
+        updateNonbasic(v, value);
+    }
+}
+
+void Simplex::push() {
+    levels_.push_back(trail_.size());
+}
+
+void Simplex::pop() {
+    std::size_t size = levels_.back();
+    levels_.pop_back();
+    while (trail_.size() > size) {
+        TrailEntry& entry = trail_.back();
+        VarInfo& info = vars_[entry.var];
+        (entry.upper ? info.upper : info.lower) = std::move(entry.previous);
+        trail_.pop_back();
+    }
+}
+
+void Simplex::updateNonbasic(Var v, const Rational& value) {
+    Rational delta = value - vars_[v].value;
+    for (std::uint32_t r : columns_[v]) {
+        vars_[basic_[r]].value += coefficient(r, v) * delta;
+    }
+    vars_[v].value = value;
+}
+
+bool Simplex::boundsConflict(Var v) {
+    const VarInfo& info = vars_[v];
+    if (info.lower.present && info.upper.present && info.lower.value > info.upper.value) {
+        conflict_ = {FarkasTerm{info.lower.reason, false, Rational(1)},
+                     FarkasTerm{info.upper.reason, true, Rational(1)}};
+        return true;
+    }
+    return false;
+}
+
+Simplex::Result Simplex::check(std::size_t maxPivots) {
+    conflict_.clear();
+    for (Var v = 0; v < vars_.size(); ++v) {
+        if (boundsConflict(v)) {
+            return Result::UNSAT;
+        }
+    }
+
+    constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+    for (std::size_t iteration = 0;; ++iteration) {
+        // Bland's rule: the violated basic variable with the smallest index
+        std::size_t row = kNone;
+        bool below = false;
+        for (std::size_t r = 0; r < rows_.size(); ++r) {
+            Var b = basic_[r];
+            if (row != kNone && b > basic_[row]) {
+                continue;
+            }
+            const VarInfo& info = vars_[b];
+            if (info.lower.present && info.value < info.lower.value) {
+                row = r;
+                below = true;
+            } else if (info.upper.present && info.value > info.upper.value) {
+                row = r;
+                below = false;
+            }
+        }
+        if (row == kNone) {
+            return Result::SAT;
+        }
+        if (iteration == maxPivots) {
+            return Result::UNKNOWN;
+        }
+
+        // ... and the smallest nonbasic variable that can move it back.
+        Var entering = static_cast<Var>(vars_.size());
+        for (const Entry& entry : rows_[row]) {
+            const VarInfo& info = vars_[entry.var];
+            bool increase = below == (entry.coeff.sign() > 0);
+            bool canMove = increase ? !info.upper.present || info.value < info.upper.value
+                                    : !info.lower.present || info.value > info.lower.value;
+            if (canMove) {
+                entering = entry.var;
+                break;
+            }
+        }
+        if (entering == vars_.size()) {
+            explainRow(row, below);
+            return Result::UNSAT;
+        }
+        const VarInfo& leaving = vars_[basic_[row]];
+        pivotAndUpdate(row, entering, below ? leaving.lower.value : leaving.upper.value);
+    }
+}
+
+void Simplex::pivotAndUpdate(std::size_t row, Var entering, const Rational& value) {
+    Var leaving = basic_[row];
+    Rational theta = (value - vars_[leaving].value) / coefficient(row, entering);
+    vars_[leaving].value = value;
+    vars_[entering].value += theta;
+    for (std::uint32_t r : columns_[entering]) {
+        if (r != row) {
+            vars_[basic_[r]].value += coefficient(r, entering) * theta;
+        }
+    }
+    pivot(row, entering);
+}
+
+void Simplex::pivot(std::size_t row, Var entering) {
+    ++pivots_;
+    Var leaving = basic_[row];
+    Row& pivotRow = rows_[row];
+
+    // leaving = a·entering + Σ aₖxₖ  ⇒  entering = (1/a)·leaving − Σ (aₖ/a)·xₖ
+    auto at = std::lower_bound(pivotRow.begin(), pivotRow.end(), entering, byVar<Entry>);
+    Rational inverse = Rational(1) / at->coeff;
+    pivotRow.erase(at);
+    for (Entry& entry : pivotRow) {
+        entry.coeff = -entry.coeff * inverse;
+    }
+    pivotRow.insert(std::lower_bound(pivotRow.begin(), pivotRow.end(), leaving, byVar<Entry>),
+                    Entry{leaving, inverse});
+    columns_[leaving].push_back(static_cast<std::uint32_t>(row));
+
+    // Substitute entering in the other rows it occurs in; it is basic
+    // from now on, so its column ends up empty.
+    std::vector<std::uint32_t> column;
+    column.swap(columns_[entering]);
+    for (std::uint32_t r : column) {
+        if (r == row) {
+            continue;
+        }
+        Row& other = rows_[r];
+        auto it = std::lower_bound(other.begin(), other.end(), entering, byVar<Entry>);
+        Rational c = std::move(it->coeff);
+        other.erase(it);
+
+        // other += c · pivotRow, merging the sorted entries
+        scratch_.clear();
+        scratch_.reserve(other.size() + pivotRow.size());
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < other.size() || j < pivotRow.size()) {
+            if (j == pivotRow.size() || (i < other.size() && other[i].var < pivotRow[j].var)) {
+                scratch_.push_back(std::move(other[i++]));
+            } else if (i == other.size() || pivotRow[j].var < other[i].var) {
+                scratch_.push_back(Entry{pivotRow[j].var, c * pivotRow[j].coeff});
+                columns_[pivotRow[j].var].push_back(r);
+                ++j;
+            } else {
+                Rational sum = other[i].coeff + c * pivotRow[j].coeff;
+                if (sum.isZero()) {
+                    unlink(r, other[i].var);
+                } else {
+                    scratch_.push_back(Entry{other[i].var, std::move(sum)});
+                }
+                ++i;
+                ++j;
+            }
+        }
+        other.swap(scratch_);
+    }
+
+    basic_[row] = entering;
+    vars_[entering].row = static_cast<std::int32_t>(row);
+    vars_[leaving].row = -1;
+}
+
+void Simplex::explainRow(std::size_t row, bool belowLower) {
+    // basic = Σ cₖxₖ with every xₖ stuck at the bound that keeps the
+    // basic variable out of range; those bounds and the violated one
+    // sum to a contradiction.
+    const VarInfo& basic = vars_[basic_[row]];
+    const Bound& violated = belowLower ? basic.lower : basic.upper;
+    conflict_.push_back(FarkasTerm{violated.reason, !belowLower, Rational(1)});
+    for (const Entry& entry : rows_[row]) {
+        bool positive = entry.coeff.sign() > 0;
+        bool upper = belowLower == positive;
+        const Bound& bound = upper ? vars_[entry.var].upper : vars_[entry.var].lower;
+        conflict_.push_back(FarkasTerm{bound.reason, upper, positive ? entry.coeff : -entry.coeff});
+    }
+}
+
+} // namespace backends
+} // namespace semcal
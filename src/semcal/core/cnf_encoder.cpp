@@ -0,0 +1,501 @@
+#include "semcal/core/cnf_encoder.h"
+#include "semcal/core/cnf_formula.h"
+#include <string>
+
+namespace semcal {
+namespace core {
+
+namespace {
+
+// Interned symbols of the connectives
+struct CnfOps {
+    SymbolId notOp, andOp, orOp, impliesOp, xorOp, eqOp, distinctOp, iteOp;
+    SymbolId lt, le, gt, ge, trueSym, falseSym;
+};
+
+const CnfOps& cnfOps() {
+    static const CnfOps ops = [] {
+        SymbolTable& s = TermStore::global().symbols();
+        return CnfOps{s.intern("not"), s.intern("and"), s.intern("or"), s.intern("=>"),
+                      s.intern("xor"), s.intern("="), s.intern("distinct"), s.intern("ite"),
+                      s.intern("<"), s.intern("<="), s.intern(">"), s.intern(">="),
+                      s.intern("true"), s.intern("false")};
+    }();
+    return ops;
+}
+
+std::uint8_t flip(std::uint8_t polarities) {
+    return static_cast<std::uint8_t>(((polarities & 1) << 1) | ((polarities & 2) >> 1));
+}
+
+// A term that is Boolean by its shape, whatever the sorts of its leaves
+bool isBoolean(const TermStore& store, TermId t) {
+    const CnfOps& ops = cnfOps();
+    for (;;) {
+        SymbolId head = store.symbol(t);
+        if (store.isLeaf(t)) {
+            return head == ops.trueSym || head == ops.falseSym;
+        }
+        if (head == ops.iteOp && store.args(t).size() == 3) {
+            t = store.args(t)[1];
+            continue;
+        }
+        return head == ops.notOp || head == ops.andOp || head == ops.orOp ||
+               head == ops.impliesOp || head == ops.xorOp || head == ops.eqOp ||
+               head == ops.distinctOp || head == ops.lt || head == ops.le ||
+               head == ops.gt || head == ops.ge;
+    }
+}
+
+bool isNumeral(const std::string& name) {
+    return !name.empty() && (name[0] == '-' || name[0] == '#' || (name[0] >= '0' && name[0] <= '9'));
+}
+
+// Collect the leaves a term can evaluate to, looking through ite
+// branches; false if it can also evaluate to a compound term.
+bool operandLeaves(const TermStore& store, TermId t, std::vector<TermId>& leaves) {
+    const CnfOps& ops = cnfOps();
+    std::vector<TermId> todo{t};
+    bool leavesOnly = true;
+    while (!todo.empty()) {
+        TermId u = todo.back();
+        todo.pop_back();
+        if (store.isLeaf(u)) {
+            leaves.push_back(u);
+        } else if (store.isApp(u, ops.iteOp) && store.args(u).size() == 3) {
+            todo.push_back(store.args(u)[1]);
+            todo.push_back(store.args(u)[2]);
+        } else {
+            leavesOnly = false;
+        }
+    }
+    return leavesOnly;
+}
+
+} // namespace
+
+Var CnfEncoder::intern(VariableId variable, bool input) {
+    auto it = index_.find(variable);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    auto var = static_cast<Var>(variables_.size());
+    variables_.push_back(variable);
+    inputs_.push_back(input);
+    atoms_.push_back(kNullTerm);
+    index_.emplace(variable, var);
+    return var;
+}
+
+void CnfEncoder::encode(const Formula& formula) {
+    variables_.clear();
+    inputs_.clear();
+    atoms_.clear();
+    index_.clear();
+    propositional_ = true;
+
+    if (const auto* cnf = dynamic_cast<const CnfFormula*>(&formula)) {
+        arena_ = cnf->getArena();
+        variables_.reserve(arena_->numVars());
+        for (Var v = 0; v < arena_->numVars(); ++v) {
+            intern(ConcreteModel::variable(CnfFormula::variableName(v)), true);
+        }
+        return;
+    }
+
+    auto arena = std::make_shared<ClauseArena>();
+    out_ = arena.get();
+    classify(formula.getTerm());
+    encodeTerm(formula.getTerm());
+    out_ = nullptr;
+    nodes_.clear();
+    rewrites_.clear();
+    booleans_.clear();
+    arena->ensureVars(numVariables());
+    arena_ = std::move(arena);
+}
+
+void CnfEncoder::classify(TermId root) {
+    const TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+
+    // = and distinct without a visibly Boolean argument, with the leaves
+    // they compare; a leaf is theory-sorted once it is compared with or
+    // used as an operand of a theory term, and so is everything it is
+    // compared with.
+    std::vector<TermId> groups;
+    std::vector<std::vector<TermId>> groupLeaves;
+    std::vector<bool> theoryGroup;
+    std::unordered_map<TermId, std::vector<std::uint32_t>> groupsOf;  // leaf -> groups
+    std::unordered_set<TermId> theory;
+    std::vector<TermId> pending;  // theory leaves whose groups are not marked yet
+    auto mark = [&](TermId leaf) {
+        auto it = declared_.find(store.symbol(leaf));
+        if (it != declared_.end() && it->second) {
+            return;
+        }
+        if (theory.insert(leaf).second) {
+            pending.push_back(leaf);
+        }
+    };
+
+    std::unordered_set<TermId> visited;
+    std::vector<TermId> todo{root};
+    std::vector<TermId> leaves;
+    while (!todo.empty()) {
+        TermId t = todo.back();
+        todo.pop_back();
+        if (store.isLeaf(t) || !visited.insert(t).second) {
+            continue;
+        }
+        SymbolId head = store.symbol(t);
+        TermArgs args = store.args(t);
+        todo.insert(todo.end(), args.begin(), args.end());
+        if (head == ops.eqOp || head == ops.distinctOp) {
+            if (args.size() < 2) {
+                continue;
+            }
+            bool boolean = false;
+            for (TermId arg : args) {
+                boolean = boolean || isBoolean(store, arg);
+            }
+            if (boolean) {
+                booleans_.insert(t);
+                continue;
+            }
+            leaves.clear();
+            bool leavesOnly = true;
+            for (TermId arg : args) {
+                leavesOnly = operandLeaves(store, arg, leaves) && leavesOnly;
+            }
+            auto group = static_cast<std::uint32_t>(groups.size());
+            groups.push_back(t);
+            groupLeaves.push_back(leaves);
+            theoryGroup.push_back(false);
+            for (TermId leaf : leaves) {
+                groupsOf[leaf].push_back(group);
+                auto it = declared_.find(store.symbol(leaf));
+                if (!leavesOnly || isNumeral(store.name(leaf)) || (it != declared_.end() && !it->second)) {
+                    mark(leaf);
+                }
+            }
+            if (!leavesOnly) {
+                theoryGroup[group] = true;
+            }
+        } else if (head != ops.notOp && head != ops.andOp && head != ops.orOp &&
+                   head != ops.impliesOp && head != ops.xorOp && head != ops.iteOp) {
+            // Operands of a theory term: (<= x 3), (+ x y), (f x)
+            for (TermId arg : args) {
+                leaves.clear();
+                operandLeaves(store, arg, leaves);
+                for (TermId leaf : leaves) {
+                    mark(leaf);
+                }
+            }
+        }
+    }
+
+    while (!pending.empty()) {
+        TermId leaf = pending.back();
+        pending.pop_back();
+        auto it = groupsOf.find(leaf);
+        if (it == groupsOf.end()) {
+            continue;
+        }
+        for (std::uint32_t group : it->second) {
+            if (theoryGroup[group]) {
+                continue;
+            }
+            theoryGroup[group] = true;
+            for (TermId other : groupLeaves[group]) {
+                mark(other);
+            }
+        }
+    }
+    for (std::size_t group = 0; group < groups.size(); ++group) {
+        if (!theoryGroup[group]) {
+            booleans_.insert(groups[group]);
+        }
+    }
+}
+
+void CnfEncoder::encodeTerm(TermId term) {
+    const TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    TermArgs conjuncts{&term, 1};
+    if (store.isApp(term, ops.andOp)) {
+        conjuncts = store.args(term);
+    }
+
+    // Top-level clauses are emitted directly; only their non-literal
+    // disjuncts need Tseitin variables.
+    std::vector<Lit> lits;
+    for (TermId conjunct : conjuncts) {
+        TermArgs disjuncts{&conjunct, 1};
+        if (store.isApp(conjunct, ops.orOp)) {
+            disjuncts = store.args(conjunct);
+        }
+        lits.clear();
+        bool satisfied = false;
+        for (TermId disjunct : disjuncts) {
+            bool negated = false;
+            std::uint8_t polarities = kPositive;
+            TermId t = strip(disjunct, negated, polarities);
+            if (store.isLeaf(t) && (store.symbol(t) == ops.trueSym || store.symbol(t) == ops.falseSym)) {
+                satisfied = satisfied || ((store.symbol(t) == ops.trueSym) != negated);
+                continue;
+            }
+            lits.push_back(literal(disjunct, kPositive));
+        }
+        if (!satisfied) {
+            out_->addClause(lits);
+        }
+    }
+}
+
+TermId CnfEncoder::strip(TermId term, bool& negated, std::uint8_t& polarities) {
+    TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    while (store.isApp(term, ops.notOp) && store.args(term).size() == 1) {
+        term = store.args(term)[0];
+        negated = !negated;
+        polarities = flip(polarities);
+    }
+    if (store.isLeaf(term)) {
+        return term;
+    }
+
+    // Reduce n-ary xor, = and distinct over Booleans to binary gates.
+    auto it = rewrites_.find(term);
+    if (it != rewrites_.end()) {
+        return it->second;
+    }
+    SymbolId head = store.symbol(term);
+    TermArgs args = store.args(term);
+    TermId rewritten = term;
+    if (head == ops.xorOp && args.size() > 2) {
+        rewritten = store.mkApp(ops.xorOp, args.data, 2);
+        for (std::uint32_t i = 2; i < args.size(); ++i) {
+            TermId pair[2] = {rewritten, args[i]};
+            rewritten = store.mkApp(ops.xorOp, pair, 2);
+        }
+    } else if ((head == ops.eqOp || head == ops.distinctOp) && booleans_.count(term) != 0) {
+        if (head == ops.eqOp && args.size() > 2) {
+            std::vector<TermId> pairs;
+            for (std::uint32_t i = 0; i + 1 < args.size(); ++i) {
+                pairs.push_back(store.mkApp(ops.eqOp, args.data + i, 2));
+                booleans_.insert(pairs.back());
+            }
+            rewritten = store.mkAnd(pairs);
+        } else if (head == ops.distinctOp) {
+            // Three Booleans are never pairwise distinct.
+            rewritten = args.size() == 2 ? store.mkApp(ops.xorOp, args.data, 2) : store.mkFalse();
+        }
+    }
+    if (rewritten != term) {
+        rewrites_.emplace(term, rewritten);
+    }
+    return rewritten;
+}
+
+bool CnfEncoder::isGate(TermId term) const {
+    const TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    if (store.isLeaf(term)) {
+        return false;
+    }
+    SymbolId head = store.symbol(term);
+    TermArgs args = store.args(term);
+    if (head == ops.andOp || head == ops.orOp) {
+        return true;
+    }
+    if (head == ops.impliesOp) {
+        return args.size() >= 2;
+    }
+    if (head == ops.xorOp) {
+        return args.size() == 2;
+    }
+    if (head == ops.eqOp) {
+        return args.size() == 2 && booleans_.count(term) != 0;
+    }
+    return head == ops.iteOp && args.size() == 3;
+}
+
+Lit CnfEncoder::atom(TermId term) {
+    auto it = nodes_.find(term);
+    if (it != nodes_.end()) {
+        return mkLit(it->second.var);
+    }
+    TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    SymbolId symbol = store.symbol(term);
+    if (store.isLeaf(term) && symbol == ops.falseSym) {
+        return litNegate(atom(store.mkTrue()));
+    }
+
+    VariableId variable = symbol;
+    bool input = symbol != ops.trueSym;
+    if (!store.isLeaf(term)) {
+        variable = store.symbols().intern("@cnf" + std::to_string(term));
+        input = false;
+    } else if (isNumeral(store.name(term))) {
+        input = false;
+    }
+    propositional_ = propositional_ && (input || symbol == ops.trueSym);
+    Var var = intern(variable, input);
+    if (!store.isLeaf(term)) {
+        atoms_[var] = term;
+    }
+    nodes_.emplace(term, Node{var, kBoth});
+    if (symbol == ops.trueSym) {
+        emit({mkLit(var)});
+    }
+    return mkLit(var);
+}
+
+Lit CnfEncoder::literal(TermId term, std::uint8_t polarities) {
+    const TermStore& store = TermStore::global();
+    bool negated = false;
+    TermId root = strip(term, negated, polarities);
+    if (!isGate(root)) {
+        Lit lit = atom(root);
+        return negated ? litNegate(lit) : lit;
+    }
+
+    auto node = [&](TermId gate) -> Node& {
+        auto it = nodes_.find(gate);
+        if (it == nodes_.end()) {
+            std::string name = "@cnf" + std::to_string(gate);
+            Var var = intern(TermStore::global().symbols().intern(name), false);
+            it = nodes_.emplace(gate, Node{var, 0}).first;
+        }
+        return it->second;
+    };
+
+    Var var = node(root).var;
+    std::uint8_t missing = polarities & ~node(root).polarities;
+    if (missing != 0) {
+        stack_.push_back(Frame{root, missing, 0});
+    }
+    // Post-order over the gates below, each with the polarities it
+    // still lacks; gates already defined for them are not entered.
+    while (!stack_.empty()) {
+        Frame& frame = stack_.back();
+        TermArgs args = store.args(frame.term);
+        if (frame.next < args.size()) {
+            std::uint32_t i = frame.next++;
+            std::uint8_t childPolarities = this->childPolarities(frame.term, i, frame.polarities);
+            bool childNegated = false;
+            TermId child = strip(args[i], childNegated, childPolarities);
+            if (!isGate(child)) {
+                atom(child);
+                continue;
+            }
+            std::uint8_t childMissing = childPolarities & ~node(child).polarities;
+            if (childMissing != 0) {
+                stack_.push_back(Frame{child, childMissing, 0});
+            }
+            continue;
+        }
+        TermId gate = frame.term;
+        std::uint8_t gatePolarities = frame.polarities;
+        stack_.pop_back();
+        define(gate, gatePolarities);
+        node(gate).polarities |= gatePolarities;
+    }
+    return mkLit(var, negated);
+}
+
+std::uint8_t CnfEncoder::childPolarities(TermId gate, std::uint32_t index,
+                                         std::uint8_t polarities) const {
+    const TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    SymbolId head = store.symbol(gate);
+    if (head == ops.andOp || head == ops.orOp) {
+        return polarities;
+    }
+    if (head == ops.impliesOp) {
+        return index + 1 < store.args(gate).size() ? flip(polarities) : polarities;
+    }
+    if (head == ops.iteOp && index > 0) {
+        return polarities;
+    }
+    return kBoth;  // xor, =, the condition of ite
+}
+
+Lit CnfEncoder::childLiteral(TermId term) {
+    bool negated = false;
+    std::uint8_t polarities = kBoth;
+    TermId t = strip(term, negated, polarities);
+    Lit lit = isGate(t) ? mkLit(nodes_.at(t).var) : atom(t);
+    return negated ? litNegate(lit) : lit;
+}
+
+void CnfEncoder::emit(std::initializer_list<Lit> lits) {
+    out_->addClause(lits.begin(), lits.size());
+}
+
+void CnfEncoder::define(TermId gate, std::uint8_t polarities) {
+    const TermStore& store = TermStore::global();
+    const CnfOps& ops = cnfOps();
+    SymbolId head = store.symbol(gate);
+    TermArgs args = store.args(gate);
+    Lit g = mkLit(nodes_.at(gate).var);
+    bool positive = (polarities & kPositive) != 0;
+    bool negative = (polarities & kNegative) != 0;
+
+    if (head == ops.andOp || head == ops.orOp || head == ops.impliesOp) {
+        // g ↔ b₁ ∧ … ∧ bₙ, or g ↔ b₁ ∨ … ∨ bₙ (=> negates all but the last)
+        bool conjunction = head == ops.andOp;
+        clause_.assign(1, conjunction ? g : litNegate(g));
+        for (std::uint32_t i = 0; i < args.size(); ++i) {
+            Lit b = childLiteral(args[i]);
+            if (head == ops.impliesOp && i + 1 < args.size()) {
+                b = litNegate(b);
+            }
+            if (conjunction && positive) {
+                emit({litNegate(g), b});  // g → bᵢ
+            } else if (!conjunction && negative) {
+                emit({g, litNegate(b)});  // bᵢ → g
+            }
+            clause_.push_back(conjunction ? litNegate(b) : b);
+        }
+        if ((conjunction && negative) || (!conjunction && positive)) {
+            out_->addClause(clause_);  // ∧bᵢ → g, or g → ∨bᵢ
+        }
+        return;
+    }
+
+    Lit a = childLiteral(args[0]);
+    Lit b = childLiteral(args[1]);
+    if (head == ops.iteOp) {
+        // g ↔ (a ? b : c)
+        Lit c = childLiteral(args[2]);
+        if (positive) {
+            emit({litNegate(g), litNegate(a), b});
+            emit({litNegate(g), a, c});
+        }
+        if (negative) {
+            emit({g, litNegate(a), litNegate(b)});
+            emit({g, a, litNegate(c)});
+        }
+        return;
+    }
+
+    // g ↔ a ⊕ b; equality is g ↔ ¬(a ⊕ b)
+    if (head == ops.eqOp) {
+        g = litNegate(g);
+        std::swap(positive, negative);
+    }
+    if (positive) {
+        emit({litNegate(g), a, b});
+        emit({litNegate(g), litNegate(a), litNegate(b)});
+    }
+    if (negative) {
+        emit({g, litNegate(a), b});
+        emit({g, a, litNegate(b)});
+    }
+}
+
+} // namespace core
+} // namespace semcal
@@ -0,0 +1,80 @@
+#include "semcal/core/cnf_formula.h"
+
+namespace semcal {
+namespace core {
+
+CnfFormula::CnfFormula(std::shared_ptr<const ClauseArena> arena)
+    : arena_(std::move(arena)) {
+}
+
+CnfFormula::CnfFormula(ClauseArena arena)
+    : arena_(std::make_shared<const ClauseArena>(std::move(arena))) {
+}
+
+CnfFormula::CnfFormula(const CnfFormula& other)
+    : Formula(other),
+      arena_(other.arena_),
+      term_(other.term_.load(std::memory_order_relaxed)) {
+}
+
+std::string CnfFormula::variableName(Var var) {
+    return "x" + std::to_string(static_cast<std::uint64_t>(var) + 1);
+}
+
+TermId CnfFormula::getTerm() const {
+    TermId cached = term_.load(std::memory_order_acquire);
+    if (cached != kNullTerm) {
+        return cached;
+    }
+
+    TermStore& store = TermStore::global();
+    const ClauseArena& arena = *arena_;
+
+    // Literal terms, created lazily per variable
+    std::vector<TermId> literalTerms(static_cast<std::size_t>(arena.numVars()) * 2, kNullTerm);
+    auto literalTerm = [&](Lit lit) {
+        TermId& t = literalTerms[lit];
+        if (t == kNullTerm) {
+            TermId atom = store.mkLeaf(variableName(litVar(lit)));
+            t = litNegated(lit) ? store.mkNot(atom) : atom;
+        }
+        return t;
+    };
+
+    std::vector<TermId> clauses;
+    clauses.reserve(arena.numClauses());
+    std::vector<TermId> lits;
+    for (std::size_t i = 0; i < arena.numClauses(); ++i) {
+        lits.clear();
+        for (Lit lit : arena.clause(i)) {
+            lits.push_back(literalTerm(lit));
+        }
+        clauses.push_back(store.mkOr(lits));
+    }
+    TermId term = store.mkAnd(clauses);
+    term_.store(term, std::memory_order_release);
+    return term;
+}
+
+std::string CnfFormula::toString() const {
+    return TermStore::global().toString(getTerm());
+}
+
+std::unique_ptr<Formula> CnfFormula::clone() const {
+    return std::make_unique<CnfFormula>(*this);
+}
+
+bool CnfFormula::isEquivalent(const Formula& other) const {
+    if (auto cnf = dynamic_cast<const CnfFormula*>(&other)) {
+        if (cnf->arena_ == arena_) {
+            return true;
+        }
+    }
+    if (hash() != other.hash()) {
+        return false;
+    }
+    return getTerm() == other.getTerm();
+}
+
+} // namespace core
+} // namespace semcal
@@ -1,76 +1,86 @@
 #include "semcal/core/formula.h"
-#include <sstream>
+#include "semcal/core/linear_system.h"
 
 namespace semcal {
 namespace core {
 
+TermId Formula::getTerm() const {
+    return TermStore::global().parse(toString());
+}
+
+std::uint64_t Formula::hash() const {
+    return TermStore::global().hash(getTerm());
+}
+
+std::shared_ptr<const LinearSystem> Formula::getLinearSystem() const {
+    return LinearSystem::of(getTerm());
+}
+
 ConcreteFormula::ConcreteFormula(const std::string& expression)
-    : expression_(expression) {
+    : term_(TermStore::global().parse(expression)) {
 }
 
 ConcreteFormula::ConcreteFormula(const char* expression)
-    : expression_(expression ? expression : "") {
+    : term_(TermStore::global().parse(expression ? expression : "")) {
+}
+
+ConcreteFormula::ConcreteFormula(TermId term)
+    : term_(term) {
 }
 
 std::string ConcreteFormula::toString() const {
-    return expression_;
+    return TermStore::global().toString(term_);
 }
 
 std::unique_ptr<Formula> ConcreteFormula::clone() const {
-    return std::make_unique<ConcreteFormula>(expression_);
+    return std::make_unique<ConcreteFormula>(*this);
 }
 
 bool ConcreteFormula::isEquivalent(const Formula& other) const {
-    const auto* otherConcrete = dynamic_cast<const ConcreteFormula*>(&other);
-    if (!otherConcrete) {
+    // In a real implementation, this would check semantic equivalence
+    // For now, we compare normal forms: hashes first, then the
+    // hash-consed roots (equal structure <=> equal identifier)
+    if (hash() != other.hash()) {
         return false;
     }
-    // In a real implementation, this would check semantic equivalence
-    // For now, we do syntactic comparison
-    return expression_ == otherConcrete->expression_;
+    return term_ == other.getTerm();
+}
+
+void ConcreteFormula::setExpression(const std::string& expression) {
+    term_ = TermStore::global().parse(expression);
 }
 
 namespace FormulaFactory {
 
-std::unique_ptr<Formula> createConjunction(const std::vector<std::unique_ptr<Formula>>& formulas) {
-    if (formulas.empty()) {
-        return std::make_unique<ConcreteFormula>("true");
-    }
-    
-    std::ostringstream oss;
-    oss << "(and";
+namespace {
+
+std::vector<TermId> termsOf(const std::vector<std::unique_ptr<Formula>>& formulas) {
+    std::vector<TermId> terms;
+    terms.reserve(formulas.size());
     for (const auto& f : formulas) {
-        oss << " " << f->toString();
+        terms.push_back(f->getTerm());
     }
-    oss << ")";
-    return std::make_unique<ConcreteFormula>(oss.str());
+    return terms;
+}
+
+} // namespace
+
+std::unique_ptr<Formula> createConjunction(const std::vector<std::unique_ptr<Formula>>& formulas) {
+    return std::make_unique<ConcreteFormula>(TermStore::global().mkAnd(termsOf(formulas)));
 }
 
 std::unique_ptr<Formula> createDisjunction(const std::vector<std::unique_ptr<Formula>>& formulas) {
-    if (formulas.empty()) {
-        return std::make_unique<ConcreteFormula>("false");
-    }
-    
-    std::ostringstream oss;
-    oss << "(or";
-    for (const auto& f : formulas) {
-        oss << " " << f->toString();
-    }
-    oss << ")";
-    return std::make_unique<ConcreteFormula>(oss.str());
+    return std::make_unique<ConcreteFormula>(TermStore::global().mkOr(termsOf(formulas)));
 }
 
 std::unique_ptr<Formula> createNegation(std::unique_ptr<Formula> formula) {
-    std::ostringstream oss;
-    oss << "(not " << formula->toString() << ")";
-    return std::make_unique<ConcreteFormula>(oss.str());
+    return std::make_unique<ConcreteFormula>(TermStore::global().mkNot(formula->getTerm()));
 }
 
-std::unique_ptr<Formula> createImplication(std::unique_ptr<Formula> premise, 
+std::unique_ptr<Formula> createImplication(std::unique_ptr<Formula> premise,
                                            std::unique_ptr<Formula> conclusion) {
-    std::ostringstream oss;
-    oss << "(=> " << premise->toString() << " " << conclusion->toString() << ")";
-    return std::make_unique<ConcreteFormula>(oss.str());
+    return std::make_unique<ConcreteFormula>(
+        TermStore::global().mkImplies(premise->getTerm(), conclusion->getTerm()));
 }
 
 } // namespace FormulaFactory
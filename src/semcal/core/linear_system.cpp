@@ -0,0 +1,230 @@
+#include "semcal/core/linear_system.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace semcal {
+namespace core {
+
+using util::Rational;
+
+namespace {
+
+using LinearForm = std::map<VariableId, Rational>;
+
+struct PendingRow {
+    LinearForm coeffs;
+    bool hasLower = false;
+    bool hasUpper = false;
+    Rational bound;
+};
+
+bool isConstant(const LinearForm& form) {
+    for (const auto& entry : form) {
+        if (!entry.second.isZero()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Add scale·term to (coeffs, constant); false if term is not linear.
+bool linearize(TermId term, const Rational& scale, LinearForm& coeffs, Rational& constant) {
+    const TermStore& store = TermStore::global();
+    if (store.isLeaf(term)) {
+        const std::string& name = store.name(term);
+        Rational value;
+        if (Rational::parse(name, value)) {
+            constant += scale * value;
+            return true;
+        }
+        if (name == "true" || name == "false") {
+            return false;
+        }
+        coeffs[store.symbol(term)] += scale;
+        return true;
+    }
+
+    const std::string& head = store.name(term);
+    TermArgs args = store.args(term);
+    if (head == "+") {
+        for (TermId arg : args) {
+            if (!linearize(arg, scale, coeffs, constant)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (head == "-") {
+        if (args.size() == 1) {
+            return linearize(args[0], -scale, coeffs, constant);
+        }
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            if (!linearize(args[i], i == 0 ? scale : -scale, coeffs, constant)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (head == "*") {
+        // At most one factor may be non-constant.
+        Rational factor = scale;
+        LinearForm varying;
+        Rational varyingConstant;
+        bool haveVarying = false;
+        for (TermId arg : args) {
+            LinearForm form;
+            Rational value;
+            if (!linearize(arg, Rational(1), form, value)) {
+                return false;
+            }
+            if (isConstant(form)) {
+                factor *= value;
+            } else if (haveVarying) {
+                return false;
+            } else {
+                varying = std::move(form);
+                varyingConstant = value;
+                haveVarying = true;
+            }
+        }
+        if (!haveVarying) {
+            constant += factor;
+            return true;
+        }
+        for (const auto& [var, c] : varying) {
+            coeffs[var] += factor * c;
+        }
+        constant += factor * varyingConstant;
+        return true;
+    }
+    if (head == "/" && args.size() >= 2) {
+        // (/ a b c) = a / b / c with constant divisors
+        Rational divisor(1);
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            LinearForm form;
+            Rational value;
+            if (!linearize(args[i], Rational(1), form, value) || !isConstant(form) || value.isZero()) {
+                return false;
+            }
+            divisor *= value;
+        }
+        return linearize(args[0], scale / divisor, coeffs, constant);
+    }
+    if (head == "to_real" && args.size() == 1) {
+        return linearize(args[0], scale, coeffs, constant);
+    }
+    return false;
+}
+
+bool addRelation(const std::string& relation, TermId lhs, TermId rhs, bool negated,
+                 std::vector<PendingRow>& rows) {
+    // lhs − rhs = Σ cᵢxᵢ + k  ⋈ 0  ⇔  Σ cᵢxᵢ ⋈ −k
+    PendingRow row;
+    Rational constant;
+    if (!linearize(lhs, Rational(1), row.coeffs, constant) ||
+        !linearize(rhs, Rational(-1), row.coeffs, constant)) {
+        return false;
+    }
+    bool upperOnly = relation == "<=" || relation == "<";
+    bool lowerOnly = relation == ">=" || relation == ">";
+    if (negated) {
+        std::swap(upperOnly, lowerOnly);
+    }
+    row.hasUpper = !lowerOnly;
+    row.hasLower = !upperOnly;
+    row.bound = -constant;
+    rows.push_back(std::move(row));
+    return true;
+}
+
+void collectRows(TermId term, bool negated, std::vector<PendingRow>& rows) {
+    const TermStore& store = TermStore::global();
+    if (store.isLeaf(term)) {
+        return;
+    }
+    const std::string& head = store.name(term);
+    TermArgs args = store.args(term);
+    if (head == "and" && !negated) {
+        for (TermId arg : args) {
+            collectRows(arg, false, rows);
+        }
+    } else if (head == "not" && args.size() == 1) {
+        collectRows(args[0], !negated, rows);
+    } else if ((head == "<=" || head == "<" || head == ">=" || head == ">" || head == "=") &&
+               args.size() >= 2) {
+        if (negated && (head == "=" || args.size() > 2)) {
+            return;
+        }
+        for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+            addRelation(head, args[i], args[i + 1], negated, rows);
+        }
+    }
+}
+
+} // namespace
+
+LinearSystem::LinearSystem(TermId term) : term_(term) {
+    std::vector<PendingRow> rows;
+    if (term != kNullTerm) {
+        collectRows(term, false, rows);
+    }
+
+    for (const PendingRow& row : rows) {
+        for (const auto& [var, c] : row.coeffs) {
+            if (!c.isZero()) {
+                variables_.push_back(var);
+            }
+        }
+    }
+    std::sort(variables_.begin(), variables_.end());
+    variables_.erase(std::unique(variables_.begin(), variables_.end()), variables_.end());
+
+    rowStart_.reserve(rows.size() + 1);
+    sides_.reserve(rows.size());
+    lower_.reserve(rows.size());
+    upper_.reserve(rows.size());
+    for (PendingRow& row : rows) {
+        for (auto& [var, c] : row.coeffs) {
+            if (!c.isZero()) {
+                Column col;
+                columnOf(var, col);
+                columns_.push_back(col);
+                values_.push_back(std::move(c));
+            }
+        }
+        rowStart_.push_back(static_cast<std::uint32_t>(columns_.size()));
+        sides_.push_back(static_cast<std::uint8_t>((row.hasLower ? kLower : 0) |
+                                                   (row.hasUpper ? kUpper : 0)));
+        lower_.push_back(row.hasLower ? row.bound : Rational());
+        upper_.push_back(row.hasUpper ? std::move(row.bound) : Rational());
+    }
+}
+
+std::shared_ptr<const LinearSystem> LinearSystem::of(TermId term) {
+    static std::mutex mutex;
+    static std::unordered_map<TermId, std::shared_ptr<const LinearSystem>> cache;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(term);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+    auto system = std::make_shared<const LinearSystem>(term);
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(term, std::move(system)).first->second;
+}
+
+bool LinearSystem::columnOf(VariableId variable, Column& column) const {
+    auto it = std::lower_bound(variables_.begin(), variables_.end(), variable);
+    if (it == variables_.end() || *it != variable) {
+        return false;
+    }
+    column = static_cast<Column>(it - variables_.begin());
+    return true;
+}
+
+} // namespace core
+} // namespace semcal
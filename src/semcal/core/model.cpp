@@ -1,61 +1,316 @@
 #include "semcal/core/model.h"
+#include <algorithm>
+#include <functional>
 #include <sstream>
 
 namespace semcal {
 namespace core {
 
-ConcreteModel::ConcreteModel(const std::unordered_map<std::string, std::string>& assignments)
-    : assignments_(assignments) {
+namespace {
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Contribution of one assignment to the model hash (as in PartialModel).
+std::uint64_t entryHash(VariableId variable, const Value& value) {
+    return value.isNone() ? 0 : mix64(value.hash() ^ (variable * 0x9e3779b97f4a7c15ULL));
+}
+
+// Interned operator symbols understood by the evaluator
+struct EvalOps {
+    SymbolId notOp, andOp, orOp, xorOp, impliesOp, eqOp, distinctOp, iteOp;
+    SymbolId lt, le, gt, ge, plus, minus, times, div;
+};
+
+const EvalOps& evalOps() {
+    static const EvalOps ops = [] {
+        SymbolTable& s = TermStore::global().symbols();
+        return EvalOps{s.intern("not"), s.intern("and"), s.intern("or"), s.intern("xor"),
+                       s.intern("=>"), s.intern("="), s.intern("distinct"), s.intern("ite"),
+                       s.intern("<"), s.intern("<="), s.intern(">"), s.intern(">="),
+                       s.intern("+"), s.intern("-"), s.intern("*"), s.intern("/")};
+    }();
+    return ops;
+}
+
+// Value of a leaf that is not an assigned variable: a literal, or None.
+Value literalValue(const std::string& name) {
+    if (name.empty()) {
+        return Value();
+    }
+    char c = name[0];
+    if ((c >= '0' && c <= '9') || c == '#' || name == "true" || name == "false") {
+        Value v = Value::parse(name);
+        return v.kind() == Value::Kind::Symbol ? Value() : v;
+    }
+    return Value();
+}
+
+Value numericOp(SymbolId head, const EvalOps& ops, const Value& a, const Value& b) {
+    if (a.kind() == Value::Kind::Int && b.kind() == Value::Kind::Int) {
+        std::int64_t r;
+        bool overflow = true;
+        if (head == ops.plus) overflow = __builtin_add_overflow(a.asInt(), b.asInt(), &r);
+        else if (head == ops.minus) overflow = __builtin_sub_overflow(a.asInt(), b.asInt(), &r);
+        else if (head == ops.times) overflow = __builtin_mul_overflow(a.asInt(), b.asInt(), &r);
+        if (!overflow) {
+            return Value::integer(r);
+        }
+    }
+    util::Rational x = a.toRational(), y = b.toRational();
+    if (head == ops.plus) return Value::number(x + y);
+    if (head == ops.minus) return Value::number(x - y);
+    if (head == ops.times) return Value::number(x * y);
+    if (y.isZero()) {
+        return Value();  // division by zero is unspecified
+    }
+    return Value::number(x / y);
+}
+
+Value apply(SymbolId head, const Value* a, std::size_t n) {
+    const EvalOps& ops = evalOps();
+
+    if (head == ops.notOp) {
+        return n == 1 && a[0].isBool() ? Value::boolean(!a[0].asBool()) : Value();
+    }
+    if (head == ops.andOp || head == ops.orOp) {
+        // Three-valued: a decisive argument wins over unknown ones.
+        const bool decisive = head == ops.orOp;
+        bool unknown = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!a[i].isBool()) {
+                unknown = true;
+            } else if (a[i].asBool() == decisive) {
+                return Value::boolean(decisive);
+            }
+        }
+        return unknown ? Value() : Value::boolean(!decisive);
+    }
+    if (head == ops.impliesOp) {
+        // Right-associative: (=> a b c) = (=> a (=> b c))
+        Value r = n > 0 ? a[n - 1] : Value();
+        for (std::size_t i = n - 1; i-- > 0;) {
+            bool premiseFalse = a[i].isBool() && !a[i].asBool();
+            bool conclusionTrue = r.isBool() && r.asBool();
+            if (premiseFalse || conclusionTrue) {
+                r = Value::boolean(true);
+            } else if (a[i].isBool() && r.isBool()) {
+                r = Value::boolean(false);
+            } else {
+                r = Value();
+            }
+        }
+        return r;
+    }
+    if (head == ops.xorOp) {
+        bool parity = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!a[i].isBool()) return Value();
+            parity ^= a[i].asBool();
+        }
+        return Value::boolean(parity);
+    }
+    if (head == ops.iteOp) {
+        if (n != 3) return Value();
+        if (a[0].isBool()) return a[0].asBool() ? a[1] : a[2];
+        return a[1] == a[2] ? a[1] : Value();
+    }
+    if (head == ops.eqOp || head == ops.distinctOp) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (a[i].isNone()) return Value();
+        }
+        if (head == ops.eqOp) {
+            for (std::size_t i = 1; i < n; ++i) {
+                if (a[i] != a[0]) return Value::boolean(false);
+            }
+            return Value::boolean(true);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                if (a[i] == a[j]) return Value::boolean(false);
+            }
+        }
+        return Value::boolean(true);
+    }
+
+    const bool comparison = head == ops.lt || head == ops.le || head == ops.gt || head == ops.ge;
+    const bool arithmetic = head == ops.plus || head == ops.minus || head == ops.times || head == ops.div;
+    if (!comparison && !arithmetic) {
+        return Value();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!a[i].isNumber()) return Value();
+    }
+    if (n == 0) {
+        return Value();
+    }
+    if (comparison) {
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            int c = a[i].kind() == Value::Kind::Int && a[i + 1].kind() == Value::Kind::Int
+                        ? (a[i].asInt() > a[i + 1].asInt()) - (a[i].asInt() < a[i + 1].asInt())
+                        : util::Rational::compare(a[i].toRational(), a[i + 1].toRational());
+            bool holds = head == ops.lt ? c < 0 : head == ops.le ? c <= 0 : head == ops.gt ? c > 0 : c >= 0;
+            if (!holds) return Value::boolean(false);
+        }
+        return Value::boolean(true);
+    }
+    if (n == 1) {
+        return head == ops.minus ? numericOp(ops.minus, ops, Value::integer(0), a[0]) : a[0];
+    }
+    Value r = a[0];
+    for (std::size_t i = 1; i < n && !r.isNone(); ++i) {
+        r = numericOp(head, ops, r, a[i]);
+    }
+    return r;
+}
+
+} // namespace
+
+bool Model::satisfies(TermId constraint) const {
+    return satisfies(TermStore::global().toString(constraint));
+}
+
+std::uint64_t Model::hash() const {
+    return mix64(std::hash<std::string>()(toString()));
+}
+
+ConcreteModel::ConcreteModel(const std::unordered_map<std::string, std::string>& assignments) {
+    for (const auto& [variable, value] : assignments) {
+        setAssignment(variable, value);
+    }
+}
+
+VariableId ConcreteModel::variable(std::string_view name) {
+    return TermStore::global().symbols().intern(name);
+}
+
+std::vector<std::pair<VariableId, Value>>::const_iterator ConcreteModel::find(VariableId variable) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), variable,
+                               [](const auto& entry, VariableId v) { return entry.first < v; });
+    return it != entries_.end() && it->first == variable ? it : entries_.end();
+}
+
+void ConcreteModel::set(VariableId variable, Value value) {
+    // Models are mostly built in increasing id order: append in O(1).
+    auto it = entries_.empty() || entries_.back().first < variable
+                  ? entries_.end()
+                  : std::lower_bound(entries_.begin(), entries_.end(), variable,
+                                     [](const auto& entry, VariableId v) { return entry.first < v; });
+    if (it != entries_.end() && it->first == variable) {
+        hash_ ^= entryHash(variable, it->second) ^ entryHash(variable, value);
+        if (value.isNone()) {
+            entries_.erase(it);
+        } else {
+            it->second = std::move(value);
+        }
+        return;
+    }
+    if (value.isNone()) {
+        return;
+    }
+    hash_ ^= entryHash(variable, value);
+    entries_.emplace(it, variable, std::move(value));
+}
+
+void ConcreteModel::unset(VariableId variable) {
+    set(variable, Value());
+}
+
+const Value& ConcreteModel::get(VariableId variable) const {
+    static const Value none;
+    auto it = find(variable);
+    return it != entries_.end() ? it->second : none;
 }
 
 void ConcreteModel::setAssignment(const std::string& variable, const std::string& value) {
-    assignments_[variable] = value;
+    set(ConcreteModel::variable(variable), Value::parse(value));
 }
 
 std::string ConcreteModel::getAssignment(const std::string& variable) const {
-    auto it = assignments_.find(variable);
-    if (it != assignments_.end()) {
-        return it->second;
+    VariableId id;
+    if (!TermStore::global().symbols().lookup(variable, id)) {
+        return "";
     }
-    return "";
+    return get(id).toString();
 }
 
 bool ConcreteModel::hasAssignment(const std::string& variable) const {
-    return assignments_.find(variable) != assignments_.end();
+    VariableId id;
+    return TermStore::global().symbols().lookup(variable, id) && has(id);
+}
+
+Value ConcreteModel::evaluate(TermId term) const {
+    const TermStore& store = TermStore::global();
+    // Post-order walk with explicit stacks: (term, next argument), values
+    std::vector<std::pair<TermId, std::uint32_t>> stack;
+    std::vector<Value> values;
+    stack.emplace_back(term, 0);
+    while (!stack.empty()) {
+        TermId t = stack.back().first;
+        TermArgs args = store.args(t);
+        if (args.empty()) {
+            SymbolId s = store.symbol(t);
+            const Value& value = get(s);
+            values.push_back(!value.isNone() ? value : literalValue(store.name(t)));
+            stack.pop_back();
+            continue;
+        }
+        std::uint32_t& next = stack.back().second;
+        if (next < args.size()) {
+            TermId child = args[next++];
+            stack.emplace_back(child, 0);
+            continue;
+        }
+        std::size_t base = values.size() - args.size();
+        Value r = apply(store.symbol(t), values.data() + base, args.size());
+        values.resize(base);
+        values.push_back(std::move(r));
+        stack.pop_back();
+    }
+    return std::move(values.back());
+}
+
+bool ConcreteModel::satisfies(TermId constraint) const {
+    Value v = evaluate(constraint);
+    return !(v.isBool() && !v.asBool());
 }
 
 bool ConcreteModel::satisfies(const std::string& constraint) const {
-    // Default implementation: check if constraint string contains variable assignments
-    // In a real implementation, this would parse and evaluate the constraint
-    (void)constraint; // Suppress unused parameter warning
-    return true; // Placeholder
+    return satisfies(TermStore::global().parse(constraint));
 }
 
 std::string ConcreteModel::toString() const {
+    const SymbolTable& symbols = TermStore::global().symbols();
     std::ostringstream oss;
     oss << "{";
     bool first = true;
-    for (const auto& pair : assignments_) {
+    forEach([&](VariableId variable, const Value& value) {
         if (!first) {
             oss << ", ";
         }
-        oss << pair.first << " = " << pair.second;
+        oss << symbols.name(variable) << " = " << value.toString();
         first = false;
-    }
+    });
     oss << "}";
     return oss.str();
 }
 
 std::unique_ptr<Model> ConcreteModel::clone() const {
-    return std::make_unique<ConcreteModel>(assignments_);
+    return std::make_unique<ConcreteModel>(*this);
 }
 
 bool ConcreteModel::equals(const Model& other) const {
     const auto* otherConcrete = dynamic_cast<const ConcreteModel*>(&other);
-    if (!otherConcrete) {
+    if (!otherConcrete || hash_ != otherConcrete->hash_) {
         return false;
     }
-    return assignments_ == otherConcrete->assignments_;
+    return entries_ == otherConcrete->entries_;
 }
 
 } // namespace core
@@ -0,0 +1,124 @@
+#include "semcal/core/model_set.h"
+
+namespace semcal {
+namespace core {
+
+namespace {
+
+constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+constexpr std::size_t kMinBuckets = 16;
+
+} // namespace
+
+ModelSet::ModelSet(std::initializer_list<std::shared_ptr<Model>> models) {
+    reserve(models.size());
+    for (const auto& model : models) {
+        insert(model);
+    }
+}
+
+std::size_t ModelSet::find(const Model& model, std::uint64_t hash) const {
+    if (table_.empty()) {
+        return kNotFound;
+    }
+    std::size_t mask = table_.size() - 1;
+    for (std::size_t i = hash & mask; table_[i] != 0; i = (i + 1) & mask) {
+        std::size_t position = table_[i] - 1;
+        if (hashes_[position] == hash && models_[position]->equals(model)) {
+            return position;
+        }
+    }
+    return kNotFound;
+}
+
+void ModelSet::rehash(std::size_t buckets) {
+    table_.assign(buckets, 0);
+    std::size_t mask = buckets - 1;
+    for (std::size_t position = 0; position < models_.size(); ++position) {
+        std::size_t i = hashes_[position] & mask;
+        while (table_[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        table_[i] = static_cast<std::uint32_t>(position + 1);
+    }
+}
+
+void ModelSet::reserve(std::size_t count) {
+    models_.reserve(count);
+    hashes_.reserve(count);
+    // Keep the load factor at most 1/2.
+    std::size_t buckets = table_.empty() ? kMinBuckets : table_.size();
+    while (buckets < 2 * count) {
+        buckets *= 2;
+    }
+    if (buckets != table_.size()) {
+        rehash(buckets);
+    }
+}
+
+bool ModelSet::insert(std::shared_ptr<Model> model) {
+    std::uint64_t hash = model->hash();
+    return insert(std::move(model), hash);
+}
+
+bool ModelSet::insert(std::shared_ptr<Model> model, std::uint64_t hash) {
+    if (find(*model, hash) != kNotFound) {
+        return false;
+    }
+    if (2 * (models_.size() + 1) > table_.size()) {
+        rehash(table_.empty() ? kMinBuckets : 2 * table_.size());
+    }
+    std::size_t mask = table_.size() - 1;
+    std::size_t i = hash & mask;
+    while (table_[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    table_[i] = static_cast<std::uint32_t>(models_.size() + 1);
+    models_.push_back(std::move(model));
+    hashes_.push_back(hash);
+    return true;
+}
+
+bool ModelSet::contains(const Model& model) const {
+    return find(model, model.hash()) != kNotFound;
+}
+
+bool ModelSet::isSubsetOf(const ModelSet& other) const {
+    if (size() > other.size()) {
+        return false;
+    }
+    for (std::size_t position = 0; position < models_.size(); ++position) {
+        if (other.find(*models_[position], hashes_[position]) == kNotFound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ModelSet ModelSet::intersect(const ModelSet& other) const {
+    ModelSet result;
+    for (std::size_t position = 0; position < models_.size(); ++position) {
+        if (other.find(*models_[position], hashes_[position]) != kNotFound) {
+            result.insert(models_[position], hashes_[position]);
+        }
+    }
+    return result;
+}
+
+ModelSet ModelSet::unite(const ModelSet& other) const {
+    ModelSet result = *this;
+    result.reserve(size() + other.size());
+    for (std::size_t position = 0; position < other.models_.size(); ++position) {
+        result.insert(other.models_[position], other.hashes_[position]);
+    }
+    return result;
+}
+
+void ModelSet::clear() {
+    models_.clear();
+    hashes_.clear();
+    table_.clear();
+}
+
+} // namespace core
+} // namespace semcal
@@ -0,0 +1,97 @@
+#include "semcal/core/model_stream.h"
+
+namespace semcal {
+namespace core {
+
+namespace {
+
+class SetStream : public ModelStream {
+private:
+    ModelSet models_;
+    ModelSet::const_iterator it_;
+
+public:
+    explicit SetStream(ModelSet models) : models_(std::move(models)), it_(models_.begin()) {}
+
+    std::shared_ptr<Model> next() override {
+        return it_ == models_.end() ? nullptr : *it_++;
+    }
+};
+
+class GeneratorStream : public ModelStream {
+private:
+    std::function<std::shared_ptr<Model>()> generator_;
+
+public:
+    explicit GeneratorStream(std::function<std::shared_ptr<Model>()> generator)
+        : generator_(std::move(generator)) {}
+
+    std::shared_ptr<Model> next() override {
+        if (!generator_) {
+            return nullptr;
+        }
+        auto model = generator_();
+        if (!model) {
+            generator_ = nullptr;  // release the generator's state
+        }
+        return model;
+    }
+};
+
+class FilterStream : public ModelStream {
+private:
+    std::unique_ptr<ModelStream> source_;
+    std::function<bool(const Model&)> predicate_;
+
+public:
+    FilterStream(std::unique_ptr<ModelStream> source, std::function<bool(const Model&)> predicate)
+        : source_(std::move(source)), predicate_(std::move(predicate)) {}
+
+    std::shared_ptr<Model> next() override {
+        while (auto model = source_->next()) {
+            if (predicate_(*model)) {
+                return model;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace
+
+std::size_t ModelStream::countAtMost(std::size_t k) {
+    std::size_t count = 0;
+    while (count < k && next()) {
+        ++count;
+    }
+    return count;
+}
+
+ModelSet ModelStream::collect() {
+    ModelSet models;
+    while (auto model = next()) {
+        models.insert(std::move(model));
+    }
+    return models;
+}
+
+std::unique_ptr<ModelStream> ModelStream::empty() {
+    return std::make_unique<SetStream>(ModelSet());
+}
+
+std::unique_ptr<ModelStream> ModelStream::of(ModelSet models) {
+    return std::make_unique<SetStream>(std::move(models));
+}
+
+std::unique_ptr<ModelStream> ModelStream::generate(std::function<std::shared_ptr<Model>()> generator) {
+    return std::make_unique<GeneratorStream>(std::move(generator));
+}
+
+std::unique_ptr<ModelStream> ModelStream::filter(
+    std::unique_ptr<ModelStream> source,
+    std::function<bool(const Model&)> predicate) {
+    return std::make_unique<FilterStream>(std::move(source), std::move(predicate));
+}
+
+} // namespace core
+} // namespace semcal
@@ -1,74 +1,275 @@
 #include "semcal/core/partial_model.h"
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
 namespace semcal {
 namespace core {
 
-PartialModel::PartialModel(const std::unordered_map<std::string, std::string>& assignments)
-  : assignments_(assignments) {
+namespace {
+
+const Value& noValue() {
+  static const Value none;
+  return none;
+}
+
+std::uint64_t mix64(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// Contribution of one assignment to the (order-independent) model hash.
+std::uint64_t entryHash(VariableId variable, const Value& value) {
+  return value.isNone() ? 0 : mix64(value.hash() ^ (variable * 0x9e3779b97f4a7c15ULL));
+}
+
+} // namespace
+
+// Snapshot implementation
+
+const Value& PartialModel::Snapshot::get(VariableId variable) const {
+  for (const SnapshotChunk* chunk = head_.get(); chunk; chunk = chunk->parent.get()) {
+    for (auto it = chunk->entries.rbegin(); it != chunk->entries.rend(); ++it) {
+      if (it->first == variable) {
+        return it->second;
+      }
+    }
+  }
+  return noValue();
+}
+
+PartialModel PartialModel::Snapshot::materialize() const {
+  // Replay oldest chunk first so newer entries win.
+  std::vector<const SnapshotChunk*> chain;
+  for (const SnapshotChunk* chunk = head_.get(); chunk; chunk = chunk->parent.get()) {
+    chain.push_back(chunk);
+  }
+  PartialModel result;
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    for (const auto& [variable, value] : (*it)->entries) {
+      result.set(variable, value);
+    }
+  }
+  return result;
+}
+
+std::string PartialModel::Snapshot::toString() const {
+  return materialize().toString();
+}
+
+// PartialModel implementation
+
+PartialModel::PartialModel(const std::unordered_map<std::string, std::string>& assignments) {
+  for (const auto& [var, val] : assignments) {
+    setAssignment(var, val);
+  }
+}
+
+std::vector<std::pair<VariableId, Value>>::const_iterator PartialModel::find(VariableId variable) const {
+  auto it = std::lower_bound(entries_.begin(), entries_.end(), variable,
+                             [](const auto& entry, VariableId v) { return entry.first < v; });
+  return it != entries_.end() && it->first == variable ? it : entries_.end();
+}
+
+Value PartialModel::exchange(VariableId variable, Value value) {
+  // Assignments mostly arrive in increasing id order: append in O(1).
+  auto it = entries_.empty() || entries_.back().first < variable
+                ? entries_.end()
+                : std::lower_bound(entries_.begin(), entries_.end(), variable,
+                                   [](const auto& entry, VariableId v) { return entry.first < v; });
+  Value previous;
+  if (it != entries_.end() && it->first == variable) {
+    previous = std::move(it->second);
+    if (value.isNone()) {
+      entries_.erase(it);
+    } else {
+      it->second = std::move(value);
+      hash_ ^= entryHash(variable, it->second);
+    }
+  } else if (!value.isNone()) {
+    hash_ ^= entryHash(variable, value);
+    entries_.emplace(it, variable, std::move(value));
+  }
+  hash_ ^= entryHash(variable, previous);
+  return previous;
+}
+
+void PartialModel::compactBase() {
+  // At level 0 only the newest snapshot can be extended, and only by
+  // the changes made since it was taken.
+  snapshots_.erase(snapshots_.begin(), snapshots_.end() - 1);
+  trail_.erase(trail_.begin(), trail_.begin() + static_cast<std::ptrdiff_t>(snapshots_.back().first));
+  snapshots_.back().first = 0;
+  // A delta as large as the valuation is no cheaper than a full copy.
+  if (trail_.size() >= entries_.size()) {
+    trail_.clear();
+    snapshots_.clear();
+  }
+}
+
+void PartialModel::set(VariableId variable, Value value) {
+  if (get(variable) == value) {
+    return;
+  }
+  if (levels_.empty() && !snapshots_.empty()) {
+    compactBase();
+  }
+  Value previous = exchange(variable, std::move(value));
+  // Base-level changes need no undo record unless a snapshot builds on the trail.
+  if (!levels_.empty() || !snapshots_.empty()) {
+    trail_.push_back(TrailEntry{variable, std::move(previous)});
+  }
+}
+
+const Value& PartialModel::get(VariableId variable) const {
+  auto it = find(variable);
+  return it != entries_.end() ? it->second : noValue();
+}
+
+std::size_t PartialModel::pushLevel() {
+  levels_.push_back(trail_.size());
+  return levels_.size();
+}
+
+void PartialModel::popToLevel(std::size_t level) {
+  if (level >= levels_.size()) {
+    return;
+  }
+  const std::size_t mark = levels_[level];
+  while (trail_.size() > mark) {
+    TrailEntry& entry = trail_.back();
+    exchange(entry.variable, std::move(entry.previous));
+    trail_.pop_back();
+  }
+  levels_.resize(level);
+  // Snapshots taken above the mark describe undone states; drop them
+  // from the chain (handles held elsewhere stay valid).
+  while (!snapshots_.empty() && snapshots_.back().first > mark) {
+    snapshots_.pop_back();
+  }
+  if (levels_.empty()) {
+    if (snapshots_.empty()) {
+      trail_.clear();
+    } else {
+      compactBase();
+    }
+  }
+}
+
+PartialModel::Snapshot PartialModel::snapshot() const {
+  if (!snapshots_.empty() && snapshots_.back().first == trail_.size()) {
+    return Snapshot(snapshots_.back().second);
+  }
+  auto chunk = std::make_shared<SnapshotChunk>();
+  chunk->size = entries_.size();
+  if (snapshots_.empty()) {
+    forEach([&](VariableId variable, const Value& value) {
+      chunk->entries.emplace_back(variable, value);
+    });
+  } else {
+    // Changes since the previous snapshot, with their current values.
+    chunk->parent = snapshots_.back().second;
+    for (std::size_t i = snapshots_.back().first; i < trail_.size(); ++i) {
+      VariableId variable = trail_[i].variable;
+      chunk->entries.emplace_back(variable, get(variable));
+    }
+  }
+  // An older snapshot at or below the base level's mark can no longer
+  // become the newest one: backtracking stops at that mark.
+  std::size_t base = levels_.empty() ? trail_.size() : levels_.front();
+  auto reachable = snapshots_.begin();
+  for (auto it = snapshots_.begin(); it != snapshots_.end(); ++it) {
+    if (it->first <= base) {
+      reachable = it;
+    }
+  }
+  snapshots_.erase(snapshots_.begin(), reachable);
+  snapshots_.emplace_back(trail_.size(), chunk);
+  return Snapshot(std::move(chunk));
 }
 
 void PartialModel::setAssignment(const std::string& variable, const std::string& value) {
-  assignments_[variable] = value;
+  set(ConcreteModel::variable(variable), Value::parse(value));
 }
 
 std::string PartialModel::getAssignment(const std::string& variable) const {
-  auto it = assignments_.find(variable);
-  if (it != assignments_.end()) {
-    return it->second;
+  VariableId id;
+  if (!TermStore::global().symbols().lookup(variable, id)) {
+    return "";
   }
-  return "";
+  return get(id).toString();
 }
 
 bool PartialModel::hasAssignment(const std::string& variable) const {
-  return assignments_.find(variable) != assignments_.end();
+  VariableId id;
+  return TermStore::global().symbols().lookup(variable, id) && has(id);
 }
 
 bool PartialModel::isExtendedBy(const Model& model) const {
-  // Check if all assignments in this partial model are consistent with the total model
-  // This is a simplified check; real implementations should use proper model checking
-  for (const auto& [var, val] : assignments_) {
-    // For now, we assume the model can check consistency
-    // Real implementations should use proper theory-specific checking
-    (void)model;
-    (void)var;
-    (void)val;
+  // M ⊇ μ: every assignment of μ agrees with M
+  if (const auto* concrete = dynamic_cast<const ConcreteModel*>(&model)) {
+    bool extends = true;
+    forEach([&](VariableId variable, const Value& value) {
+      extends = extends && concrete->get(variable) == value;
+    });
+    return extends;
   }
-  return true; // Placeholder
+  // Other model kinds: ask the model to check (= x v) for each assignment
+  TermStore& store = TermStore::global();
+  bool extends = true;
+  forEach([&](VariableId variable, const Value& value) {
+    if (extends) {
+      TermId eq[2] = {store.mkLeaf(variable), store.parse(value.toString())};
+      extends = model.satisfies(store.mkApp("=", eq, 2));
+    }
+  });
+  return extends;
 }
 
 std::vector<std::string> PartialModel::getAssignedVariables() const {
   std::vector<std::string> vars;
-  vars.reserve(assignments_.size());
-  for (const auto& [var, _] : assignments_) {
-    vars.push_back(var);
-  }
+  vars.reserve(entries_.size());
+  const SymbolTable& symbols = TermStore::global().symbols();
+  forEach([&](VariableId variable, const Value&) {
+    vars.push_back(symbols.name(variable));
+  });
   return vars;
 }
 
+bool PartialModel::equals(const PartialModel& other) const {
+  return hash_ == other.hash_ && entries_ == other.entries_;
+}
+
 bool PartialModel::isEmpty() const {
-  return assignments_.empty();
+  return entries_.empty();
 }
 
 std::string PartialModel::toString() const {
-  if (assignments_.empty()) {
+  if (entries_.empty()) {
     return "{}";
   }
+  const SymbolTable& symbols = TermStore::global().symbols();
   std::ostringstream oss;
   oss << "{";
   bool first = true;
-  for (const auto& [var, val] : assignments_) {
+  forEach([&](VariableId variable, const Value& value) {
     if (!first) oss << ", ";
-    oss << var << " = " << val;
+    oss << symbols.name(variable) << " = " << value.toString();
     first = false;
-  }
+  });
   oss << "}";
   return oss.str();
 }
 
 std::unique_ptr<PartialModel> PartialModel::clone() const {
-  return std::make_unique<PartialModel>(assignments_);
+  auto copy = std::make_unique<PartialModel>();
+  copy->entries_ = entries_;
+  copy->hash_ = hash_;
+  return copy;
 }
 
 } // namespace core
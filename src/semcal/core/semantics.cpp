@@ -1,44 +1,34 @@
 #include "semcal/core/semantics.h"
-#include <algorithm>
-#include <iterator>
 
 namespace semcal {
 namespace core {
 
+ModelSet Semantics::interpret(const Formula& formula) const {
+    return models(formula)->collect();
+}
+
 ModelSet Semantics::intersect(const ModelSet& s1, const ModelSet& s2) const {
-    ModelSet result;
-    std::set_intersection(
-        s1.begin(), s1.end(),
-        s2.begin(), s2.end(),
-        std::inserter(result, result.begin())
-    );
-    return result;
+    return s1.intersect(s2);
 }
 
 ModelSet Semantics::unionSet(const ModelSet& s1, const ModelSet& s2) const {
-    ModelSet result;
-    std::set_union(
-        s1.begin(), s1.end(),
-        s2.begin(), s2.end(),
-        std::inserter(result, result.begin())
-    );
-    return result;
+    return s1.unite(s2);
 }
 
 bool Semantics::isEmpty(const ModelSet& modelSet) const {
     return modelSet.empty();
 }
 
-ModelSet DefaultSemantics::interpret(const Formula& formula) const {
-    // Default implementation: returns empty set
-    // In a real implementation, this would use a solver to compute models
+std::unique_ptr<ModelStream> DefaultSemantics::models(const Formula& formula) const {
+    // Default implementation: returns empty stream
+    // In a real implementation, this would use a solver to enumerate models
     (void)formula; // Suppress unused parameter warning
-    return ModelSet();
+    return ModelStream::empty();
 }
 
 bool DefaultSemantics::satisfies(const Model& model, const Formula& formula) const {
     // Default implementation: delegate to model
-    return model.satisfies(formula.toString());
+    return model.satisfies(formula.getTerm());
 }
 
 bool DefaultSemantics::areEquivalent(const Formula& f1, const Formula& f2) const {
@@ -0,0 +1,394 @@
+#include "semcal/core/term_store.h"
+#include <algorithm>
+#include <cstring>
+
+namespace semcal {
+namespace core {
+
+namespace {
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t hashBytes(std::string_view s) {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mix64(h);
+}
+
+std::uint64_t hashNode(std::uint64_t symbolHash, const TermId* args,
+                       std::uint32_t arity, const TermStore& store) {
+    std::uint64_t h = symbolHash ^ (0x9e3779b97f4a7c15ULL * (arity + 1));
+    for (std::uint32_t i = 0; i < arity; ++i) {
+        h ^= store.hash(args[i]) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return mix64(h);
+}
+
+constexpr std::size_t kArgChunkSize = 1 << 14;
+
+bool isDelimiter(char c) {
+    return c == '(' || c == ')' || c == ';' || c == '"' || c == '|' ||
+           c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+// SymbolTable implementation
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    auto id = static_cast<SymbolId>(entries_.push_back(Entry{std::string(name), hashBytes(name)}));
+    index_.emplace(std::string_view(entries_[id].name), id);
+    return id;
+}
+
+bool SymbolTable::lookup(std::string_view name, SymbolId& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(name);
+    if (it == index_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+// TermStore implementation
+
+TermStore::TermStore()
+    : table_(1024, kNullTerm),
+      listSymbol_(symbols_.intern("()")),
+      andSymbol_(symbols_.intern("and")),
+      orSymbol_(symbols_.intern("or")),
+      trueTerm_(mkLeaf("true")),
+      falseTerm_(mkLeaf("false")) {
+}
+
+TermStore& TermStore::global() {
+    static TermStore store;
+    return store;
+}
+
+const TermId* TermStore::storeArgs(const TermId* args, std::uint32_t arity) {
+    if (arity == 0) {
+        return nullptr;
+    }
+    if (arity > kArgChunkSize / 4) {
+        // Large argument lists get a dedicated block.
+        argChunks_.emplace_back(new TermId[arity]);
+        std::memcpy(argChunks_.back().get(), args, arity * sizeof(TermId));
+        return argChunks_.back().get();
+    }
+    if (argRemaining_ < arity) {
+        argChunks_.emplace_back(new TermId[kArgChunkSize]);
+        argCursor_ = argChunks_.back().get();
+        argRemaining_ = kArgChunkSize;
+    }
+    TermId* stored = argCursor_;
+    std::memcpy(stored, args, arity * sizeof(TermId));
+    argCursor_ += arity;
+    argRemaining_ -= arity;
+    return stored;
+}
+
+void TermStore::growTable() {
+    std::vector<TermId> bigger(table_.size() * 2, kNullTerm);
+    std::size_t mask = bigger.size() - 1;
+    for (TermId t : table_) {
+        if (t == kNullTerm) {
+            continue;
+        }
+        std::size_t i = nodes_[t].hash & mask;
+        while (bigger[i] != kNullTerm) {
+            i = (i + 1) & mask;
+        }
+        bigger[i] = t;
+    }
+    table_.swap(bigger);
+}
+
+TermId TermStore::intern(SymbolId symbol, const TermId* args, std::uint32_t arity) {
+    std::uint64_t h = hashNode(symbols_.hash(symbol), args, arity, *this);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t mask = table_.size() - 1;
+    std::size_t i = h & mask;
+    while (table_[i] != kNullTerm) {
+        const Node& n = nodes_[table_[i]];
+        if (n.hash == h && n.symbol == symbol && n.arity == arity &&
+            (arity == 0 || std::memcmp(n.args, args, arity * sizeof(TermId)) == 0)) {
+            return table_[i];
+        }
+        i = (i + 1) & mask;
+    }
+
+    auto id = static_cast<TermId>(nodes_.push_back(Node{symbol, arity, storeArgs(args, arity), h}));
+    table_[i] = id;
+    if (nodes_.size() * 2 > table_.size()) {
+        growTable();
+    }
+    return id;
+}
+
+TermId TermStore::mkLeaf(std::string_view token) {
+    return intern(symbols_.intern(token), nullptr, 0);
+}
+
+TermId TermStore::mkLeaf(SymbolId token) {
+    return intern(token, nullptr, 0);
+}
+
+TermId TermStore::mkApp(std::string_view head, const std::vector<TermId>& args) {
+    return mkApp(symbols_.intern(head), args.data(), args.size());
+}
+
+TermId TermStore::mkApp(std::string_view head, const TermId* args, std::size_t arity) {
+    return mkApp(symbols_.intern(head), args, arity);
+}
+
+TermId TermStore::mkApp(SymbolId head, const TermId* args, std::size_t arity) {
+    if ((head == andSymbol_ || head == orSymbol_) && arity != 0) {
+        return internAC(head, args, arity);
+    }
+    return intern(head, args, static_cast<std::uint32_t>(arity));
+}
+
+TermId TermStore::internAC(SymbolId symbol, const TermId* args, std::size_t arity) {
+    const bool isAnd = symbol == andSymbol_;
+    const TermId neutral = isAnd ? trueTerm_ : falseTerm_;
+    const TermId absorbing = isAnd ? falseTerm_ : trueTerm_;
+
+    // Arguments are already normalized, so one level of flattening suffices.
+    std::vector<TermId> flat;
+    flat.reserve(arity);
+    for (std::size_t i = 0; i < arity; ++i) {
+        TermId a = args[i];
+        if (a == absorbing) {
+            return absorbing;
+        }
+        if (a == neutral) {
+            continue;
+        }
+        if (isApp(a, symbol)) {
+            TermArgs nested = this->args(a);
+            flat.insert(flat.end(), nested.begin(), nested.end());
+        } else {
+            flat.push_back(a);
+        }
+    }
+
+    // Sort structurally so the order, and with it the resulting hash,
+    // does not depend on construction order.
+    std::sort(flat.begin(), flat.end(), [this](TermId a, TermId b) {
+        return compareStructure(a, b) < 0;
+    });
+    flat.erase(std::unique(flat.begin(), flat.end()), flat.end());
+
+    if (flat.empty()) {
+        return neutral;
+    }
+    if (flat.size() == 1) {
+        return flat.front();
+    }
+    return intern(symbol, flat.data(), static_cast<std::uint32_t>(flat.size()));
+}
+
+// Total order on terms that ignores identifiers: by structural hash, then
+// (on collision) by symbol name, arity and recursively by arguments.
+// Terms are hash-consed, so only a == b compares equal.
+int TermStore::compareStructure(TermId a, TermId b) const {
+    if (a == b) {
+        return 0;
+    }
+    std::uint64_t ha = hash(a), hb = hash(b);
+    if (ha != hb) {
+        return ha < hb ? -1 : 1;
+    }
+    const Node& na = nodes_[a];
+    const Node& nb = nodes_[b];
+    if (na.symbol != nb.symbol) {
+        int c = symbols_.name(na.symbol).compare(symbols_.name(nb.symbol));
+        if (c != 0) {
+            return c < 0 ? -1 : 1;
+        }
+    }
+    if (na.arity != nb.arity) {
+        return na.arity < nb.arity ? -1 : 1;
+    }
+    for (std::uint32_t i = 0; i < na.arity; ++i) {
+        if (int c = compareStructure(na.args[i], nb.args[i])) {
+            return c;
+        }
+    }
+    return 0;
+}
+
+TermId TermStore::mkList(const TermId* elements, std::size_t count) {
+    return intern(listSymbol_, elements, static_cast<std::uint32_t>(count));
+}
+
+TermId TermStore::mkNot(TermId t) {
+    return mkApp("not", &t, 1);
+}
+
+TermId TermStore::mkAnd(const std::vector<TermId>& args) {
+    if (args.empty()) {
+        return trueTerm_;
+    }
+    return internAC(andSymbol_, args.data(), args.size());
+}
+
+TermId TermStore::mkOr(const std::vector<TermId>& args) {
+    if (args.empty()) {
+        return falseTerm_;
+    }
+    return internAC(orSymbol_, args.data(), args.size());
+}
+
+TermId TermStore::mkImplies(TermId premise, TermId conclusion) {
+    TermId args[2] = {premise, conclusion};
+    return mkApp("=>", args, 2);
+}
+
+TermId TermStore::parse(std::string_view text) {
+    std::vector<TermId> elements;
+    std::vector<std::size_t> frames;  // start of each open list in elements
+    std::size_t pos = 0;
+    const std::size_t n = text.size();
+    bool failed = false;
+
+    auto opaque = [&]() {
+        std::size_t b = 0, e = n;
+        while (b < e && isSpace(text[b])) ++b;
+        while (e > b && isSpace(text[e - 1])) --e;
+        return mkLeaf(text.substr(b, e - b));
+    };
+
+    while (pos < n && !failed) {
+        char c = text[pos];
+        if (isSpace(c)) {
+            ++pos;
+        } else if (c == ';') {
+            while (pos < n && text[pos] != '\n') ++pos;
+        } else if (c == '(') {
+            if (frames.empty() && !elements.empty()) {
+                failed = true;  // more than one top-level expression
+                break;
+            }
+            frames.push_back(elements.size());
+            ++pos;
+        } else if (c == ')') {
+            if (frames.empty()) {
+                failed = true;
+                break;
+            }
+            std::size_t start = frames.back();
+            frames.pop_back();
+            std::size_t count = elements.size() - start;
+            // "()" and "(f)" have no arity-0 node of their own: as leaves
+            // they would be read back as the bare symbol, so reject them.
+            if (count == 0 || (count == 1 && isLeaf(elements[start]))) {
+                failed = true;
+                break;
+            }
+            TermId built;
+            if (isLeaf(elements[start]) && symbol(elements[start]) != listSymbol_) {
+                built = mkApp(symbol(elements[start]), elements.data() + start + 1, count - 1);
+            } else {
+                built = mkList(elements.data() + start, count);
+            }
+            elements.resize(start);
+            elements.push_back(built);
+            ++pos;
+        } else {
+            if (frames.empty() && !elements.empty()) {
+                failed = true;
+                break;
+            }
+            std::size_t begin = pos;
+            if (c == '|' || c == '"') {
+                ++pos;
+                while (pos < n) {
+                    if (text[pos] == c) {
+                        // "" is an escaped quote inside string literals
+                        if (c == '"' && pos + 1 < n && text[pos + 1] == '"') {
+                            pos += 2;
+                            continue;
+                        }
+                        break;
+                    }
+                    ++pos;
+                }
+                if (pos >= n) {
+                    failed = true;
+                    break;
+                }
+                ++pos;
+            } else {
+                while (pos < n && !isDelimiter(text[pos])) ++pos;
+            }
+            elements.push_back(mkLeaf(text.substr(begin, pos - begin)));
+        }
+    }
+
+    if (failed || !frames.empty() || elements.size() != 1) {
+        return opaque();
+    }
+    return elements.front();
+}
+
+void TermStore::print(TermId t, std::string& out) const {
+    // Explicit stack: (term, index of next argument to print)
+    std::vector<std::pair<TermId, std::uint32_t>> stack;
+    stack.emplace_back(t, 0);
+    while (!stack.empty()) {
+        auto& [term, next] = stack.back();
+        const Node& node = nodes_[term];
+        if (node.arity == 0) {
+            out += symbols_.name(node.symbol);
+            stack.pop_back();
+            continue;
+        }
+        if (next == 0) {
+            out += '(';
+            if (node.symbol != listSymbol_) {
+                out += symbols_.name(node.symbol);
+                out += ' ';
+            }
+        } else if (next == node.arity) {
+            out += ')';
+            stack.pop_back();
+            continue;
+        } else {
+            out += ' ';
+        }
+        TermId child = node.args[next++];
+        stack.emplace_back(child, 0);
+    }
+}
+
+std::string TermStore::toString(TermId t) const {
+    std::string out;
+    print(t, out);
+    return out;
+}
+
+} // namespace core
+} // namespace semcal
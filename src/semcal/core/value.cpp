@@ -0,0 +1,274 @@
+#include "semcal/core/value.h"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace semcal {
+namespace core {
+
+namespace {
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t doubleBits(double d) {
+    if (d == 0.0) {
+        d = 0.0;  // +0 and -0 compare equal
+    }
+    std::uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(d), "unexpected double size");
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\n')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n')) s.remove_suffix(1);
+    return s;
+}
+
+// Masks the unused high bits of the top word.
+void clampWords(std::vector<std::uint64_t>& words, std::uint32_t width) {
+    words.resize((width + 63) / 64, 0);
+    if (width % 64 != 0) {
+        words.back() &= (std::uint64_t(1) << (width % 64)) - 1;
+    }
+}
+
+} // namespace
+
+// BitVector implementation
+
+BitVector::BitVector(std::uint32_t width, std::uint64_t bits)
+    : width_(width),
+      bits_(width >= 64 ? bits : bits & ((std::uint64_t(1) << width) - 1)) {
+    if (width > 64) {
+        words_.assign((width + 63) / 64, 0);
+        words_[0] = bits;
+        bits_ = 0;
+    }
+}
+
+BitVector::BitVector(std::uint32_t width, std::vector<std::uint64_t> words)
+    : width_(width) {
+    if (width <= 64) {
+        std::uint64_t w = words.empty() ? 0 : words[0];
+        bits_ = width == 64 ? w : w & ((std::uint64_t(1) << width) - 1);
+    } else {
+        clampWords(words, width);
+        words_ = std::move(words);
+    }
+}
+
+std::uint64_t BitVector::word(std::size_t i) const {
+    if (width_ <= 64) {
+        return i == 0 ? bits_ : 0;
+    }
+    return i < words_.size() ? words_[i] : 0;
+}
+
+bool BitVector::parse(std::string_view text, BitVector& out) {
+    text = trim(text);
+    if (text.size() > 2 && text[0] == '#' && (text[1] == 'b' || text[1] == 'x')) {
+        const bool binary = text[1] == 'b';
+        const std::uint32_t bitsPerDigit = binary ? 1 : 4;
+        std::string_view digits = text.substr(2);
+        const auto width = static_cast<std::uint32_t>(digits.size() * bitsPerDigit);
+        std::vector<std::uint64_t> words((width + 63) / 64, 0);
+        std::uint32_t pos = 0;  // bit position of the current digit's LSB
+        for (std::size_t i = digits.size(); i-- > 0; pos += bitsPerDigit) {
+            char c = digits[i];
+            unsigned d;
+            if (c >= '0' && c <= '9') d = static_cast<unsigned>(c - '0');
+            else if (c >= 'a' && c <= 'f') d = static_cast<unsigned>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') d = static_cast<unsigned>(c - 'A' + 10);
+            else return false;
+            if (d >= (1u << bitsPerDigit)) {
+                return false;
+            }
+            words[pos / 64] |= static_cast<std::uint64_t>(d) << (pos % 64);
+        }
+        out = BitVector(width, std::move(words));
+        return true;
+    }
+    // (_ bvN W)
+    if (text.size() > 6 && text.front() == '(' && text.back() == ')') {
+        std::istringstream in(std::string(text.substr(1, text.size() - 2)));
+        std::string underscore, bv;
+        std::uint32_t width = 0;
+        if (!(in >> underscore >> bv >> width) || underscore != "_" || bv.compare(0, 2, "bv") != 0) {
+            return false;
+        }
+        util::BigInt value;
+        if (!util::BigInt::parse(std::string_view(bv).substr(2), value) || value.sign() < 0) {
+            return false;
+        }
+        // Extract 64-bit words by repeated division.
+        std::vector<std::uint64_t> words;
+        const util::BigInt base = util::BigInt(1 << 16) * util::BigInt(1 << 16);
+        while (!value.isZero()) {
+            util::BigInt q, lo, hi;
+            util::BigInt::divMod(value, base, q, lo);
+            util::BigInt::divMod(q, base, value, hi);
+            words.push_back(static_cast<std::uint64_t>(lo.toInt64()) |
+                            (static_cast<std::uint64_t>(hi.toInt64()) << 32));
+        }
+        out = BitVector(width, std::move(words));
+        return true;
+    }
+    return false;
+}
+
+std::string BitVector::toString() const {
+    std::string s = "#b";
+    s.reserve(2 + width_);
+    for (std::uint32_t i = width_; i-- > 0;) {
+        s += bit(i) ? '1' : '0';
+    }
+    return s;
+}
+
+std::uint64_t BitVector::hash() const {
+    std::uint64_t h = mix64(width_ ^ 0x5bd1e995u);
+    for (std::size_t i = 0; i < (width_ + 63) / 64; ++i) {
+        h = mix64(h ^ word(i));
+    }
+    return h;
+}
+
+// Value implementation
+
+Value Value::boolean(bool b) {
+    Value v;
+    v.data_.emplace<1>(b);
+    return v;
+}
+
+Value Value::integer(std::int64_t i) {
+    if (i == INT64_MIN) {
+        return number(util::Rational(i));  // not representable as a small rational
+    }
+    Value v;
+    v.data_.emplace<2>(i);
+    return v;
+}
+
+Value Value::number(const util::Rational& r) {
+    if (r.isSmall() && r.smallDen() == 1) {
+        return integer(r.smallNum());
+    }
+    Value v;
+    v.data_.emplace<3>(r);
+    return v;
+}
+
+Value Value::interval(double lo, double hi) {
+    Value v;
+    v.data_.emplace<4>(Interval{lo, hi});
+    return v;
+}
+
+Value Value::bitVector(BitVector bv) {
+    Value v;
+    v.data_.emplace<5>(std::move(bv));
+    return v;
+}
+
+Value Value::symbol(SymbolId s) {
+    Value v;
+    v.data_.emplace<6>(s);
+    return v;
+}
+
+Value Value::parse(std::string_view text) {
+    text = trim(text);
+    if (text == "true") {
+        return boolean(true);
+    }
+    if (text == "false") {
+        return boolean(false);
+    }
+    std::int64_t i;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), i);
+    if (ec == std::errc() && end == text.data() + text.size()) {
+        return integer(i);
+    }
+    util::Rational r;
+    if (util::Rational::parse(text, r)) {
+        return number(r);
+    }
+    if (text.size() > 4 && text.compare(0, 2, "(-") == 0 && text.back() == ')' &&
+        util::Rational::parse(trim(text.substr(2, text.size() - 3)), r)) {
+        return number(-r);
+    }
+    BitVector bv;
+    if (BitVector::parse(text, bv)) {
+        return bitVector(std::move(bv));
+    }
+    if (text.size() >= 5 && text.front() == '[' && text.back() == ']') {
+        std::string inner(text.substr(1, text.size() - 2));
+        char* end = nullptr;
+        double lo = std::strtod(inner.c_str(), &end);
+        if (end && *end == ',') {
+            char* end2 = nullptr;
+            double hi = std::strtod(end + 1, &end2);
+            if (end2 != end + 1 && trim(end2).empty()) {
+                return interval(lo, hi);
+            }
+        }
+    }
+    return symbol(TermStore::global().symbols().intern(text));
+}
+
+util::Rational Value::toRational() const {
+    return kind() == Kind::Int ? util::Rational(asInt()) : asRational();
+}
+
+std::string Value::toString() const {
+    switch (kind()) {
+        case Kind::None:
+            return "";
+        case Kind::Bool:
+            return asBool() ? "true" : "false";
+        case Kind::Int:
+            return std::to_string(asInt());
+        case Kind::Rational:
+            return asRational().toString();
+        case Kind::Interval: {
+            std::ostringstream oss;
+            oss.precision(17);
+            oss << "[" << asInterval().lo << ", " << asInterval().hi << "]";
+            return oss.str();
+        }
+        case Kind::BitVector:
+            return asBitVector().toString();
+        case Kind::Symbol:
+            return TermStore::global().symbols().name(asSymbol());
+    }
+    return "";
+}
+
+std::uint64_t Value::hash() const {
+    std::uint64_t h;
+    switch (kind()) {
+        case Kind::None: h = 0; break;
+        case Kind::Bool: h = asBool() ? 1 : 2; break;
+        case Kind::Int: h = static_cast<std::uint64_t>(asInt()); break;
+        case Kind::Rational: h = asRational().hash(); break;
+        case Kind::Interval: h = doubleBits(asInterval().lo) ^ mix64(doubleBits(asInterval().hi)); break;
+        case Kind::BitVector: h = asBitVector().hash(); break;
+        case Kind::Symbol: h = TermStore::global().symbols().hash(asSymbol()); break;
+        default: h = 0; break;
+    }
+    return mix64(h + static_cast<std::uint64_t>(kind()) * 0x9e3779b97f4a7c15ULL);
+}
+
+} // namespace core
+} // namespace semcal
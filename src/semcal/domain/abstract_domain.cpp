@@ -1,4 +1,5 @@
 #include "semcal/domain/abstract_domain.h"
+#include <functional>
 
 namespace semcal {
 namespace domain {
@@ -7,5 +8,9 @@ bool AbstractElement::isMorePreciseThan(const AbstractElement& other) const {
     return other.isLessPreciseThan(*this);
 }
 
+std::uint64_t AbstractElement::hash() const {
+    return std::hash<std::string>{}(toString());
+}
+
 } // namespace domain
 } // namespace semcal
@@ -0,0 +1,117 @@
+#include "semcal/domain/box_batch.h"
+#include <algorithm>
+#include <iterator>
+
+namespace semcal {
+namespace domain {
+
+BoxBatch::BoxBatch(std::vector<core::VariableId> variables) {
+    relayout(std::move(variables), 0);
+}
+
+void BoxBatch::relayout(std::vector<core::VariableId> variables, std::size_t stride) {
+    std::vector<double> lower(variables.size() * stride, -IntervalBox::kInfinity);
+    std::vector<double> upper(variables.size() * stride, IntervalBox::kInfinity);
+    // Both column lists are sorted, and the new one covers the old one.
+    for (std::size_t from = 0, to = 0; from < variables_.size(); ++from, ++to) {
+        while (variables[to] != variables_[from]) {
+            ++to;
+        }
+        std::copy_n(lower_.begin() + from * stride_, size_, lower.begin() + to * stride);
+        std::copy_n(upper_.begin() + from * stride_, size_, upper.begin() + to * stride);
+    }
+    variables_ = std::move(variables);
+    lower_ = std::move(lower);
+    upper_ = std::move(upper);
+    marked_.resize(stride, 0);
+    stride_ = stride;
+}
+
+std::size_t BoxBatch::column(core::VariableId variable) const {
+    auto it = std::lower_bound(variables_.begin(), variables_.end(), variable);
+    return it != variables_.end() && *it == variable ? static_cast<std::size_t>(it - variables_.begin()) : kNoColumn;
+}
+
+void BoxBatch::addColumns(const std::vector<core::VariableId>& variables) {
+    bool missing = false;
+    for (core::VariableId variable : variables) {
+        if (column(variable) == kNoColumn) {
+            missing = true;
+            break;
+        }
+    }
+    if (!missing) {
+        return;
+    }
+    std::vector<core::VariableId> merged;
+    merged.reserve(variables_.size() + variables.size());
+    std::set_union(variables_.begin(), variables_.end(), variables.begin(), variables.end(),
+                   std::back_inserter(merged));
+    relayout(std::move(merged), stride_);
+}
+
+void BoxBatch::reserve(std::size_t boxes) {
+    if (boxes > stride_) {
+        std::size_t stride = std::max(stride_ * 2, kBlock);
+        while (stride < boxes) {
+            stride *= 2;
+        }
+        relayout(variables_, stride);
+    }
+}
+
+std::size_t BoxBatch::append(const IntervalBox& box) {
+    reserve(size_ + 1);
+    std::size_t index = size_++;
+    assign(index, box);
+    return index;
+}
+
+void BoxBatch::assign(std::size_t index, const IntervalBox& box) {
+    if (box.isEmpty()) {
+        markEmpty(index);
+        return;
+    }
+    addColumns(box.variables());
+    marked_[index] = 0;
+    for (std::size_t col = 0; col < variables_.size(); ++col) {
+        lower_[col * stride_ + index] = box.lower(variables_[col]);
+        upper_[col * stride_ + index] = box.upper(variables_[col]);
+    }
+}
+
+IntervalBox BoxBatch::extract(std::size_t index) const {
+    if (isEmpty(index)) {
+        return IntervalBox::emptyBox();
+    }
+    IntervalBox box;
+    for (std::size_t col = 0; col < variables_.size(); ++col) {
+        box.set(variables_[col], lower_[col * stride_ + index], upper_[col * stride_ + index]);
+    }
+    return box;
+}
+
+bool BoxBatch::isEmpty(std::size_t index) const {
+    if (marked_[index]) {
+        return true;
+    }
+    for (std::size_t col = 0; col < variables_.size(); ++col) {
+        double lo = lower_[col * stride_ + index];
+        double hi = upper_[col * stride_ + index];
+        if (!(lo <= hi) || lo == IntervalBox::kInfinity || hi == -IntervalBox::kInfinity) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BoxBatch::markEmpty(std::size_t index) {
+    marked_[index] = 1;
+    for (std::size_t col = 0; col < variables_.size(); ++col) {
+        lower_[col * stride_ + index] = col == 0 ? IntervalBox::kInfinity : -IntervalBox::kInfinity;
+        upper_[col * stride_ + index] = col == 0 ? -IntervalBox::kInfinity : IntervalBox::kInfinity;
+    }
+}
+
+} // namespace domain
+} // namespace semcal
@@ -0,0 +1,121 @@
+#include "semcal/domain/box_domain.h"
+
+namespace semcal {
+namespace domain {
+
+namespace {
+
+IntervalBox asBox(const AbstractElement& element) {
+    const auto* box = dynamic_cast<const IntervalBox*>(&element);
+    return box ? *box : IntervalBox();
+}
+
+} // namespace
+
+std::unique_ptr<AbstractElement> BoxDomain::bottom() const {
+    return std::make_unique<IntervalBox>(IntervalBox::emptyBox());
+}
+
+std::unique_ptr<AbstractElement> BoxDomain::top() const {
+    return std::make_unique<IntervalBox>();
+}
+
+std::unique_ptr<AbstractElement> BoxDomain::join(
+    const AbstractElement& a,
+    const AbstractElement& b) const {
+    auto result = std::make_unique<IntervalBox>(asBox(a));
+    result->joinWith(asBox(b));
+    return result;
+}
+
+std::unique_ptr<AbstractElement> BoxDomain::meet(
+    const AbstractElement& a,
+    const AbstractElement& b) const {
+    auto result = std::make_unique<IntervalBox>(asBox(a));
+    result->meetWith(asBox(b));
+    return result;
+}
+
+std::unique_ptr<core::ModelStream> BoxConcretization::models(const AbstractElement& element) const {
+    const auto* box = dynamic_cast<const IntervalBox*>(&element);
+    if (!box || box->isEmpty() || box->isFull()) {
+        return core::ModelStream::empty();
+    }
+    auto model = std::make_shared<core::ConcreteModel>();
+    for (std::size_t i = 0; i < box->dimensions(); ++i) {
+        core::VariableId variable = box->variables()[i];
+        double lo = box->lowerAt(i);
+        double hi = box->upperAt(i);
+        if (lo == -IntervalBox::kInfinity && hi == IntervalBox::kInfinity) {
+            continue;
+        }
+        if (lo != hi) {
+            return core::ModelStream::empty();  // not a point: not enumerable
+        }
+        model->set(variable, core::Value::number(util::Rational::fromDouble(lo)));
+    }
+    return core::ModelStream::of({std::move(model)});
+}
+
+bool BoxConcretization::contains(const AbstractElement& element, const core::Model& model) const {
+    const auto* box = dynamic_cast<const IntervalBox*>(&element);
+    if (!box) {
+        return true;  // read as the full box
+    }
+    if (box->isEmpty()) {
+        return false;
+    }
+    const auto* concrete = dynamic_cast<const core::ConcreteModel*>(&model);
+    if (!concrete) {
+        return box->isFull() || Concretization::contains(element, model);
+    }
+    for (std::size_t i = 0; i < box->dimensions(); ++i) {
+        core::VariableId variable = box->variables()[i];
+        double lo = box->lowerAt(i);
+        double hi = box->upperAt(i);
+        if (lo == -IntervalBox::kInfinity && hi == IntervalBox::kInfinity) {
+            continue;
+        }
+        const core::Value& value = concrete->get(variable);
+        if (!value.isNumber()) {
+            return false;
+        }
+        util::Rational x = value.toRational();
+        if ((lo != -IntervalBox::kInfinity && x < util::Rational::fromDouble(lo)) ||
+            (hi != IntervalBox::kInfinity && util::Rational::fromDouble(hi) < x)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoxConcretization::containsAll(const AbstractElement& element, const core::ModelSet& models) const {
+    for (const auto& model : models) {
+        if (!contains(element, *model)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::function<bool(const core::Model&)> BoxConcretization::membership(
+    std::shared_ptr<const AbstractElement> element) const {
+    return [this, element = std::move(element)](const core::Model& model) { return contains(*element, model); };
+}
+
+bool BoxConcretization::isEmpty(const AbstractElement& element) const {
+    const auto* box = dynamic_cast<const IntervalBox*>(&element);
+    return box ? box->isEmpty() : Concretization::isEmpty(element);
+}
+
+bool BoxConcretization::isSubset(const AbstractElement& a, const AbstractElement& b) const {
+    const auto* boxA = dynamic_cast<const IntervalBox*>(&a);
+    if (boxA && boxA->isEmpty()) {
+        return true;
+    }
+    // Non-box elements are read as the full box.
+    return asBox(b).contains(boxA ? *boxA : IntervalBox());
+}
+
+} // namespace domain
+} // namespace semcal
@@ -1,37 +1,63 @@
 #include "semcal/domain/concretization.h"
+#include <optional>
 
 namespace semcal {
 namespace domain {
 
+core::ModelSet Concretization::concretize(const AbstractElement& element) const {
+    return models(element)->collect();
+}
+
+bool Concretization::contains(const AbstractElement& element, const core::Model& model) const {
+    auto stream = models(element);
+    while (auto other = stream->next()) {
+        if (model.equals(*other)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Concretization::containsAll(const AbstractElement& element, const core::ModelSet& models) const {
+    return models.empty() || models.isSubsetOf(concretize(element));
+}
+
+std::function<bool(const core::Model&)> Concretization::membership(
+    std::shared_ptr<const AbstractElement> element) const {
+    auto members = std::make_shared<std::optional<core::ModelSet>>();
+    return [this, element = std::move(element), members](const core::Model& model) {
+        if (!*members) {
+            *members = concretize(*element);
+        }
+        return (*members)->contains(model);
+    };
+}
+
 bool Concretization::isEmpty(const AbstractElement& element) const {
-    auto modelSet = concretize(element);
-    return modelSet.empty();
+    return models(element)->next() == nullptr;
 }
 
 bool Concretization::isSubset(const AbstractElement& a, const AbstractElement& b) const {
-    auto setA = concretize(a);
-    auto setB = concretize(b);
-    
-    for (const auto& model : setA) {
-        bool found = false;
-        for (const auto& otherModel : setB) {
-            if (model->equals(*otherModel)) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
+    // γ(b) is built only if a has a model; stop at the first one outside it
+    auto stream = models(a);
+    auto model = stream->next();
+    if (!model) {
+        return true;
+    }
+    core::ModelSet setB = concretize(b);
+    for (; model; model = stream->next()) {
+        if (!setB.contains(*model)) {
             return false;
         }
     }
     return true;
 }
 
-core::ModelSet DefaultConcretization::concretize(const AbstractElement& element) const {
-    // Default implementation: returns empty set
-    // In a real implementation, this would compute the actual model set
+std::unique_ptr<core::ModelStream> DefaultConcretization::models(const AbstractElement& element) const {
+    // Default implementation: returns empty stream
+    // In a real implementation, this would enumerate the actual model set
     (void)element; // Suppress unused parameter warning
-    return core::ModelSet();
+    return core::ModelStream::empty();
 }
 
 } // namespace domain
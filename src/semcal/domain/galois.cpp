@@ -15,23 +15,9 @@ bool GaloisConnection::satisfiesGaloisProperty(
     const AbstractElement& element) const {
     // Check: α(S) ⊑ a ⟺ S ⊆ γ(a)
     auto abstracted = abstraction_->abstract(modelSet);
-    auto concretized = concretization_->concretize(element);
     
     // Check S ⊆ γ(a)
-    bool subset = true;
-    for (const auto& model : modelSet) {
-        bool found = false;
-        for (const auto& otherModel : concretized) {
-            if (model->equals(*otherModel)) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            subset = false;
-            break;
-        }
-    }
+    bool subset = concretization_->containsAll(element, modelSet);
     
     // Check α(S) ⊑ a
     bool lessPrecise = abstracted->isLessPreciseThan(element);
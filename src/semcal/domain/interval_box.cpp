@@ -0,0 +1,275 @@
+#include "semcal/domain/interval_box.h"
+#include "semcal/domain/top_element.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+namespace semcal {
+namespace domain {
+
+namespace {
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t doubleBits(double d) {
+    if (d == 0.0) {
+        d = 0.0;  // -0.0 and 0.0 are the same bound
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    return bits;
+}
+
+bool isUnbounded(double lo, double hi) {
+    return lo == -IntervalBox::kInfinity && hi == IntervalBox::kInfinity;
+}
+
+// !(lo <= hi) also catches NaN; [inf, inf] and [-inf, -inf] hold no
+// real number
+bool isEmptyInterval(double lo, double hi) {
+    return !(lo <= hi) || lo == IntervalBox::kInfinity || hi == -IntervalBox::kInfinity;
+}
+
+} // namespace
+
+IntervalBox::IntervalBox(std::vector<core::VariableId> variables)
+    : variables_(std::move(variables)),
+      bounds_(2 * variables_.size()) {
+    for (std::size_t i = 0; i < bounds_.size(); i += 2) {
+        bounds_[i] = -kInfinity;
+        bounds_[i + 1] = kInfinity;
+    }
+}
+
+IntervalBox IntervalBox::emptyBox() {
+    IntervalBox box;
+    box.markEmpty();
+    return box;
+}
+
+void IntervalBox::markEmpty() {
+    empty_ = true;
+    variables_.clear();
+    bounds_.clear();
+}
+
+std::size_t IntervalBox::slot(core::VariableId variable) const {
+    auto it = std::lower_bound(variables_.begin(), variables_.end(), variable);
+    return it != variables_.end() && *it == variable ? static_cast<std::size_t>(it - variables_.begin()) : kNoSlot;
+}
+
+void IntervalBox::addSlots(const std::vector<core::VariableId>& variables) {
+    if (empty_) {
+        return;
+    }
+    // Cheap common case: the slots already exist (e.g. once per revise).
+    bool missing = false;
+    for (core::VariableId variable : variables) {
+        if (slot(variable) == kNoSlot) {
+            missing = true;
+            break;
+        }
+    }
+    if (!missing) {
+        return;
+    }
+    std::vector<core::VariableId> merged;
+    merged.reserve(variables_.size() + variables.size());
+    std::set_union(variables_.begin(), variables_.end(), variables.begin(), variables.end(),
+                   std::back_inserter(merged));
+    std::vector<double> bounds(2 * merged.size());
+    for (std::size_t i = 0, j = 0; i < merged.size(); ++i) {
+        bool kept = j < variables_.size() && variables_[j] == merged[i];
+        bounds[2 * i] = kept ? bounds_[2 * j] : -kInfinity;
+        bounds[2 * i + 1] = kept ? bounds_[2 * j + 1] : kInfinity;
+        j += kept;
+    }
+    variables_ = std::move(merged);
+    bounds_ = std::move(bounds);
+}
+
+void IntervalBox::setAt(std::size_t slot, double lo, double hi) {
+    if (empty_) {
+        return;
+    }
+    if (isEmptyInterval(lo, hi)) {
+        markEmpty();
+        return;
+    }
+    bounds_[2 * slot] = lo;
+    bounds_[2 * slot + 1] = hi;
+}
+
+void IntervalBox::set(core::VariableId variable, double lo, double hi) {
+    if (empty_) {
+        return;
+    }
+    std::size_t i = slot(variable);
+    if (i == kNoSlot) {
+        if (isUnbounded(lo, hi)) {
+            return;
+        }
+        addSlots({variable});
+        i = slot(variable);
+    }
+    setAt(i, lo, hi);
+}
+
+void IntervalBox::set(core::VariableId variable, const util::Rational& lo, const util::Rational& hi) {
+    set(variable, lo.toDoubleDown(), hi.toDoubleUp());
+}
+
+void IntervalBox::unbound(core::VariableId variable) {
+    std::size_t i = slot(variable);
+    if (!empty_ && i != kNoSlot) {
+        bounds_[2 * i] = -kInfinity;
+        bounds_[2 * i + 1] = kInfinity;
+    }
+}
+
+void IntervalBox::meetWith(const IntervalBox& other) {
+    if (empty_) {
+        return;
+    }
+    if (other.empty_) {
+        markEmpty();
+        return;
+    }
+    addSlots(other.variables_);
+    // Both slot lists are sorted and ours now covers theirs.
+    double* dst = bounds_.data();
+    const double* src = other.bounds_.data();
+    bool empty = false;
+    for (std::size_t i = 0, j = 0; j < other.variables_.size(); ++j) {
+        while (variables_[i] != other.variables_[j]) {
+            ++i;
+        }
+        dst[2 * i] = std::max(dst[2 * i], src[2 * j]);
+        dst[2 * i + 1] = std::min(dst[2 * i + 1], src[2 * j + 1]);
+        empty |= isEmptyInterval(dst[2 * i], dst[2 * i + 1]);
+    }
+    if (empty) {
+        markEmpty();
+    }
+}
+
+void IntervalBox::joinWith(const IntervalBox& other) {
+    if (other.empty_) {
+        return;
+    }
+    if (empty_) {
+        *this = other;
+        return;
+    }
+    // Variables missing from either box are unbounded in the hull.
+    for (std::size_t i = 0; i < variables_.size(); ++i) {
+        bounds_[2 * i] = std::min(bounds_[2 * i], other.lower(variables_[i]));
+        bounds_[2 * i + 1] = std::max(bounds_[2 * i + 1], other.upper(variables_[i]));
+    }
+}
+
+bool IntervalBox::contains(const IntervalBox& other) const {
+    if (other.empty_) {
+        return true;
+    }
+    if (empty_) {
+        return false;
+    }
+    // Only our bounded slots can exclude anything.
+    for (std::size_t i = nextBounded(0); i < variables_.size(); i = nextBounded(i + 1)) {
+        if (other.lower(variables_[i]) < bounds_[2 * i] || other.upper(variables_[i]) > bounds_[2 * i + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IntervalBox::isFull() const {
+    return !empty_ && nextBounded(0) == variables_.size();
+}
+
+std::size_t IntervalBox::nextBounded(std::size_t i) const {
+    while (i < variables_.size() && isUnbounded(bounds_[2 * i], bounds_[2 * i + 1])) {
+        ++i;
+    }
+    return i;
+}
+
+bool IntervalBox::isLessPreciseThan(const AbstractElement& other) const {
+    // this ⊑ other iff γ(this) ⊇ γ(other)
+    if (const auto* box = dynamic_cast<const IntervalBox*>(&other)) {
+        return contains(*box);
+    }
+    if (dynamic_cast<const TopElement*>(&other)) {
+        return isFull();
+    }
+    return false;
+}
+
+bool IntervalBox::equals(const AbstractElement& other) const {
+    const auto* box = dynamic_cast<const IntervalBox*>(&other);
+    if (!box || empty_ != box->empty_) {
+        return false;
+    }
+    // Unbounded slots are not part of the value.
+    std::size_t i = nextBounded(0);
+    std::size_t j = box->nextBounded(0);
+    while (i < variables_.size() && j < box->variables_.size()) {
+        if (variables_[i] != box->variables_[j] || bounds_[2 * i] != box->bounds_[2 * j] ||
+            bounds_[2 * i + 1] != box->bounds_[2 * j + 1]) {
+            return false;
+        }
+        i = nextBounded(i + 1);
+        j = box->nextBounded(j + 1);
+    }
+    return i == variables_.size() && j == box->variables_.size();
+}
+
+std::uint64_t IntervalBox::hash() const {
+    if (empty_) {
+        return 0x626f74ULL;
+    }
+    std::uint64_t h = mix64(0x626f78ULL);
+    for (std::size_t i = nextBounded(0); i < variables_.size(); i = nextBounded(i + 1)) {
+        h = mix64(h ^ variables_[i]);
+        h = mix64(h ^ doubleBits(bounds_[2 * i]));
+        h = mix64(h ^ doubleBits(bounds_[2 * i + 1]));
+    }
+    return h;
+}
+
+std::string IntervalBox::toString() const {
+    if (empty_) {
+        return "⊥";
+    }
+    if (isFull()) {
+        return "⊤";
+    }
+    const core::SymbolTable& symbols = core::TermStore::global().symbols();
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << "{";
+    bool first = true;
+    for (std::size_t i = nextBounded(0); i < variables_.size(); i = nextBounded(i + 1)) {
+        if (!first) oss << ", ";
+        oss << symbols.name(variables_[i]) << " ∈ [" << bounds_[2 * i] << ", " << bounds_[2 * i + 1] << "]";
+        first = false;
+    }
+    oss << "}";
+    return oss.str();
+}
+
+std::unique_ptr<AbstractElement> IntervalBox::clone() const {
+    return std::make_unique<IntervalBox>(*this);
+}
+
+} // namespace domain
+} // namespace semcal
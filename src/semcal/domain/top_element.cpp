@@ -12,6 +12,11 @@ bool TopElement::equals(const AbstractElement& other) const {
     return dynamic_cast<const TopElement*>(&other) != nullptr;
 }
 
+std::uint64_t TopElement::hash() const {
+    // All top elements are equal
+    return 0x746f70ULL;
+}
+
 std::string TopElement::toString() const {
     return "⊤";
 }
@@ -0,0 +1,203 @@
+#include "semcal/io/dimacs_reader.h"
+#include "semcal/io/mapped_file.h"
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+namespace semcal {
+namespace io {
+
+namespace {
+
+// Largest variable index representable in a Lit
+constexpr std::uint64_t kMaxVar = (std::uint64_t(1) << 31) - 1;
+
+class Scanner {
+public:
+    Scanner(const char* begin, const char* end) : cur_(begin), end_(end) {}
+
+    bool atEnd() const { return cur_ == end_; }
+    char peek() const { return *cur_; }
+    std::size_t line() const { return line_; }
+
+    void skipSpace() {
+        while (cur_ != end_) {
+            char c = *cur_;
+            if (c == '\n') {
+                ++line_;
+            } else if (c != ' ' && c != '\t' && c != '\r' && c != '\f' && c != '\v') {
+                return;
+            }
+            ++cur_;
+        }
+    }
+
+    void skipLine() {
+        while (cur_ != end_ && *cur_ != '\n') ++cur_;
+    }
+
+    bool skipWord(std::string_view word) {
+        skipSpace();
+        if (static_cast<std::size_t>(end_ - cur_) < word.size() ||
+            std::string_view(cur_, word.size()) != word) {
+            return false;
+        }
+        cur_ += word.size();
+        return true;
+    }
+
+    /**
+     * Parse an optionally negative decimal integer whose magnitude is
+     * at most kMaxVar.
+     */
+    bool readInt(std::int64_t& value) {
+        skipSpace();
+        bool negative = false;
+        if (cur_ != end_ && *cur_ == '-') {
+            negative = true;
+            ++cur_;
+        }
+        if (cur_ == end_ || static_cast<unsigned char>(*cur_ - '0') > 9) {
+            return false;
+        }
+        std::uint64_t v = 0;
+        do {
+            v = v * 10 + static_cast<unsigned>(*cur_ - '0');
+            if (v > kMaxVar) {
+                return false;
+            }
+            ++cur_;
+        } while (cur_ != end_ && static_cast<unsigned char>(*cur_ - '0') <= 9);
+        value = negative ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v);
+        return true;
+    }
+
+private:
+    const char* cur_;
+    const char* end_;
+    std::size_t line_ = 1;
+};
+
+DimacsReader::Result failure(DimacsDiagnostic diag) {
+    return DimacsReader::Result{util::OpStatus::ERROR, std::nullopt, std::move(diag)};
+}
+
+DimacsReader::Result success(core::ClauseArena arena) {
+    return DimacsReader::Result::ok(std::make_unique<core::CnfFormula>(std::move(arena)));
+}
+
+} // namespace
+
+std::string DimacsDiagnostic::toString() const {
+    std::ostringstream oss;
+    oss << "line " << line << ": " << message;
+    return oss.str();
+}
+
+bool DimacsReader::parse(std::string_view text, core::ClauseArena& arena, DimacsDiagnostic& diag) {
+    Scanner in(text.data(), text.data() + text.size());
+    auto fail = [&](const char* message) {
+        diag.message = message;
+        diag.line = in.line();
+        return false;
+    };
+
+    // Preamble: comments, then the problem line.
+    std::int64_t declaredVars = -1;
+    for (;;) {
+        in.skipSpace();
+        if (in.atEnd()) {
+            return fail("missing 'p cnf' header");
+        }
+        if (in.peek() == 'c') {
+            in.skipLine();
+            continue;
+        }
+        if (in.peek() != 'p') {
+            return fail("missing 'p cnf' header");
+        }
+        std::int64_t clauses = 0;
+        if (!in.skipWord("p") || !in.skipWord("cnf") ||
+            !in.readInt(declaredVars) || !in.readInt(clauses) ||
+            declaredVars < 0 || clauses < 0) {
+            return fail("malformed 'p cnf' header");
+        }
+        if (declaredVars > static_cast<std::int64_t>(UINT32_MAX >> 1)) {
+            return fail("too many variables in 'p cnf' header");
+        }
+        // Every literal takes at least two bytes ("1 "); expect about four.
+        // The header is untrusted: no more clauses than "0 " terminators fit.
+        arena.reserve(std::min<std::size_t>(static_cast<std::uint64_t>(clauses), text.size() / 2 + 1),
+                      text.size() / 4);
+        arena.ensureVars(static_cast<std::uint32_t>(declaredVars));
+        break;
+    }
+
+    for (;;) {
+        in.skipSpace();
+        if (in.atEnd()) {
+            break;
+        }
+        char c = in.peek();
+        if (c == 'c') {
+            in.skipLine();
+            continue;
+        }
+        if (c == '%') {
+            break;
+        }
+        std::int64_t lit;
+        if (!in.readInt(lit)) {
+            return fail("expected literal");
+        }
+        if (lit == 0) {
+            arena.endClause();
+            continue;
+        }
+        if (lit > declaredVars || -lit > declaredVars) {
+            return fail("literal exceeds the declared number of variables");
+        }
+        arena.addLiteral(core::litFromDimacs(lit));
+    }
+    if (arena.hasOpenClause()) {
+        arena.endClause();
+    }
+    return true;
+}
+
+DimacsReader::Result DimacsReader::readString(std::string_view text) {
+    core::ClauseArena arena;
+    DimacsDiagnostic diag;
+    if (!parse(text, arena, diag)) {
+        return failure(std::move(diag));
+    }
+    return success(std::move(arena));
+}
+
+DimacsReader::Result DimacsReader::readFile(const std::string& path) {
+    MappedFile mapped;
+    if (mapped.open(path)) {
+        return readString(std::string_view(mapped.data(), mapped.size()));
+    }
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return failure(DimacsDiagnostic{"cannot open " + path, 0});
+    }
+    auto result = readStream(file);
+    std::fclose(file);
+    return result;
+}
+
+DimacsReader::Result DimacsReader::readStream(std::FILE* file) {
+    // Streams cannot be mapped: slurp and parse from memory.
+    std::string text;
+    char buffer[1 << 16];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, n);
+    }
+    return readString(text);
+}
+
+} // namespace io
+} // namespace semcal
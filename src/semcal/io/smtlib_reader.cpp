@@ -0,0 +1,597 @@
+#include "semcal/io/smtlib_reader.h"
+#include "semcal/io/mapped_file.h"
+#include <cstdlib>
+#include <sstream>
+
+namespace semcal {
+namespace io {
+
+namespace {
+
+constexpr std::size_t kStreamBufferSize = 1 << 20;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isDelimiter(char c) {
+    return isSpace(c) || c == '(' || c == ')' || c == ';' || c == '"' || c == '|';
+}
+
+using Result = util::OpResult<void, SmtLibDiagnostic>;
+
+} // namespace
+
+std::string SmtLibDiagnostic::toString() const {
+    std::ostringstream oss;
+    oss << "line " << line << ": " << message;
+    return oss.str();
+}
+
+/**
+ * @brief Tokenizer over a memory region or a refillable stream buffer.
+ *
+ * Atom text is a view into the input when the token lies in one buffer
+ * and is copied into a reused scratch string only when it straddles a
+ * refill (or is quoted). The view is valid until the next call to next().
+ */
+class SmtLibReader::Scanner {
+public:
+    using Token = SmtLibReader::Token;
+
+    Scanner(const char* data, std::size_t size)
+        : cur_(data), end_(data + size) {}
+
+    explicit Scanner(std::FILE* file)
+        : file_(file), buffer_(kStreamBufferSize) {}
+
+    Token next();
+    std::string_view text() const { return text_; }
+    std::size_t line() const { return line_; }
+
+private:
+    const char* cur_ = nullptr;
+    const char* end_ = nullptr;
+    std::FILE* file_ = nullptr;
+    std::vector<char> buffer_;
+    std::string scratch_;
+    std::string_view text_;
+    std::size_t line_ = 1;
+
+    bool refill() {
+        if (!file_) {
+            return false;
+        }
+        std::size_t n = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+        cur_ = buffer_.data();
+        end_ = cur_ + n;
+        return n > 0;
+    }
+
+    bool available() { return cur_ != end_ || refill(); }
+};
+
+SmtLibReader::Token SmtLibReader::Scanner::next() {
+    for (;;) {
+        if (!available()) {
+            return Token::End;
+        }
+        char c = *cur_;
+        if (isSpace(c)) {
+            if (c == '\n') ++line_;
+            ++cur_;
+            continue;
+        }
+        if (c == ';') {
+            while (available() && *cur_ != '\n') ++cur_;
+            continue;
+        }
+        if (c == '(') {
+            ++cur_;
+            return Token::LParen;
+        }
+        if (c == ')') {
+            ++cur_;
+            return Token::RParen;
+        }
+        break;
+    }
+
+    char c = *cur_;
+    if (c == '|' || c == '"') {
+        // Quoted symbol or string literal; "" escapes a quote in strings.
+        scratch_.assign(1, c);
+        ++cur_;
+        for (;;) {
+            if (!available()) {
+                return Token::Error;
+            }
+            char d = *cur_++;
+            scratch_ += d;
+            if (d == '\n') ++line_;
+            if (d == c) {
+                if (c == '"' && available() && *cur_ == '"') {
+                    scratch_ += *cur_++;
+                    continue;
+                }
+                break;
+            }
+        }
+        text_ = scratch_;
+        return Token::Atom;
+    }
+
+    const char* begin = cur_;
+    bool spilled = false;
+    for (;;) {
+        while (cur_ != end_ && !isDelimiter(*cur_)) ++cur_;
+        if (cur_ != end_ || !file_) {
+            break;
+        }
+        // Token reaches the end of the buffer: keep its prefix and refill.
+        if (!spilled) {
+            scratch_.clear();
+            spilled = true;
+        }
+        scratch_.append(begin, cur_);
+        if (!refill()) {
+            break;
+        }
+        begin = cur_;
+    }
+    if (spilled) {
+        scratch_.append(begin, cur_);
+        text_ = scratch_;
+    } else {
+        text_ = std::string_view(begin, static_cast<std::size_t>(cur_ - begin));
+    }
+    return Token::Atom;
+}
+
+SmtLibReader::SmtLibReader(core::TermStore& store)
+    : store_(store) {
+}
+
+Result SmtLibReader::readFile(const std::string& path) {
+    MappedFile mapped;
+    if (mapped.open(path)) {
+        Scanner scanner(mapped.data(), mapped.size());
+        return run(scanner);
+    }
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return Result{util::OpStatus::ERROR, SmtLibDiagnostic{"cannot open " + path, 0}};
+    }
+    auto result = readStream(file);
+    std::fclose(file);
+    return result;
+}
+
+Result SmtLibReader::readStream(std::FILE* file) {
+    Scanner scanner(file);
+    return run(scanner);
+}
+
+Result SmtLibReader::readString(std::string_view text) {
+    Scanner scanner(text.data(), text.size());
+    return run(scanner);
+}
+
+std::unique_ptr<core::Formula> SmtLibReader::getAssertionFormula() const {
+    return std::make_unique<core::ConcreteFormula>(conjunction());
+}
+
+core::TermId SmtLibReader::conjunction() const {
+    if (conjunction_ == core::kNullTerm) {
+        conjunction_ = store_.mkAnd(assertions_);
+    }
+    return conjunction_;
+}
+
+void SmtLibReader::unbind(core::SymbolId symbol) {
+    auto it = bindings_.find(symbol);
+    it->second.pop_back();
+    if (it->second.empty()) {
+        bindings_.erase(it);
+    }
+    --activeBindings_;
+}
+
+Result SmtLibReader::run(Scanner& scanner) {
+    exited_ = false;
+    SmtLibDiagnostic diag;
+    while (!exited_) {
+        auto tok = scanner.next();
+        if (tok == Token::End) {
+            break;
+        }
+        if (tok != Token::LParen) {
+            return Result{util::OpStatus::ERROR, SmtLibDiagnostic{"expected '(' before command", scanner.line()}};
+        }
+        if (!readCommand(scanner, diag)) {
+            // Drop the partial term state so the reader can be reused.
+            frames_.clear();
+            argStack_.clear();
+            letPending_.clear();
+            bindings_.clear();
+            activeBindings_ = 0;
+            diag.line = scanner.line();
+            return Result{util::OpStatus::ERROR, diag};
+        }
+    }
+    return Result::ok();
+}
+
+bool SmtLibReader::expect(Scanner& scanner, Token token, SmtLibDiagnostic& diag) {
+    if (scanner.next() != token) {
+        diag.message = token == Token::RParen ? "expected ')'" : "expected '('";
+        return false;
+    }
+    return true;
+}
+
+bool SmtLibReader::readSymbol(Scanner& scanner, core::SymbolId& symbol, SmtLibDiagnostic& diag) {
+    if (scanner.next() != Token::Atom) {
+        diag.message = "expected symbol";
+        return false;
+    }
+    symbol = store_.symbols().intern(scanner.text());
+    return true;
+}
+
+bool SmtLibReader::readTerm(Scanner& scanner, core::TermId& result, SmtLibDiagnostic& diag) {
+    return readTermFrom(scanner, scanner.next(), result, diag);
+}
+
+bool SmtLibReader::readCommand(Scanner& scanner, SmtLibDiagnostic& diag) {
+    if (scanner.next() != Token::Atom) {
+        diag.message = "expected command name";
+        return false;
+    }
+    // Copied: the scanner may refill its buffer while the command is read.
+    const std::string cmd(scanner.text());
+
+    if (cmd == "assert") {
+        core::TermId t;
+        if (!readTerm(scanner, t, diag)) return false;
+        assertions_.push_back(t);
+        conjunction_ = core::kNullTerm;
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    if (cmd == "declare-fun" || cmd == "declare-const") {
+        const bool isConst = cmd == "declare-const";
+        SmtLibDeclaration decl;
+        if (!readSymbol(scanner, decl.name, diag)) return false;
+        if (!isConst) {
+            if (!expect(scanner, Token::LParen, diag)) return false;
+            for (auto tok = scanner.next(); tok != Token::RParen; tok = scanner.next()) {
+                core::TermId sort;
+                if (!readTermFrom(scanner, tok, sort, diag)) return false;
+                decl.argSorts.push_back(sort);
+            }
+        }
+        if (!readTerm(scanner, decl.sort, diag)) return false;
+        declarations_.push_back(std::move(decl));
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    if (cmd == "define-fun") {
+        core::SymbolId name;
+        Definition def;
+        if (!readSymbol(scanner, name, diag)) return false;
+        if (!expect(scanner, Token::LParen, diag)) return false;
+        for (auto tok = scanner.next(); tok != Token::RParen; tok = scanner.next()) {
+            core::SymbolId param;
+            core::TermId sort;
+            if (tok != Token::LParen) {
+                diag.message = "expected sorted variable";
+                return false;
+            }
+            if (!readSymbol(scanner, param, diag)) return false;
+            if (!readTerm(scanner, sort, diag)) return false;
+            if (!expect(scanner, Token::RParen, diag)) return false;
+            def.params.push_back(param);
+        }
+        core::TermId sort;
+        if (!readTerm(scanner, sort, diag)) return false;
+        // Parameters shadow outer definitions while the body is read.
+        for (core::SymbolId p : def.params) {
+            bindings_[p].push_back(store_.mkLeaf(p));
+            ++activeBindings_;
+        }
+        bool ok = readTerm(scanner, def.body, diag);
+        for (core::SymbolId p : def.params) {
+            unbind(p);
+        }
+        if (!ok) return false;
+        definitions_[name] = std::move(def);
+        definitionOrder_.push_back(name);
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    if (cmd == "push" || cmd == "pop") {
+        std::size_t n = 1;
+        auto tok = scanner.next();
+        if (tok == Token::Atom) {
+            n = static_cast<std::size_t>(std::strtoull(std::string(scanner.text()).c_str(), nullptr, 10));
+            tok = scanner.next();
+        }
+        if (tok != Token::RParen) {
+            diag.message = "expected ')'";
+            return false;
+        }
+        if (cmd == "push") {
+            for (std::size_t i = 0; i < n; ++i) {
+                scopes_.push_back(Scope{assertions_.size(), declarations_.size(), definitionOrder_.size()});
+            }
+            return true;
+        }
+        if (n > scopes_.size()) {
+            diag.message = "pop exceeds the number of open scopes";
+            return false;
+        }
+        popScopes(n);
+        return true;
+    }
+
+    if (cmd == "check-sat") {
+        ++checkSatCount_;
+        if (!expect(scanner, Token::RParen, diag)) return false;
+        if (onCheckSat_) {
+            core::ConcreteFormula assertions(conjunction());
+            onCheckSat_(assertions);
+        }
+        return true;
+    }
+
+    if (cmd == "set-logic") {
+        if (scanner.next() != Token::Atom) {
+            diag.message = "expected logic name";
+            return false;
+        }
+        logic_ = std::string(scanner.text());
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    if (cmd == "reset" || cmd == "reset-assertions") {
+        if (cmd == "reset") {
+            logic_.clear();
+        }
+        reset();
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    if (cmd == "exit") {
+        exited_ = true;
+        return expect(scanner, Token::RParen, diag);
+    }
+
+    // set-info, set-option, get-model, ...: not interpreted
+    return skipRest(scanner, diag);
+}
+
+bool SmtLibReader::skipRest(Scanner& scanner, SmtLibDiagnostic& diag) {
+    std::size_t depth = 1;
+    while (depth > 0) {
+        switch (scanner.next()) {
+            case Token::LParen: ++depth; break;
+            case Token::RParen: --depth; break;
+            case Token::Atom: break;
+            default:
+                diag.message = "unexpected end of input";
+                return false;
+        }
+    }
+    return true;
+}
+
+core::TermId SmtLibReader::resolveSymbol(core::SymbolId symbol) {
+    if (activeBindings_ != 0) {
+        auto it = bindings_.find(symbol);
+        if (it != bindings_.end() && !it->second.empty()) {
+            return it->second.back();
+        }
+    }
+    if (!definitions_.empty()) {
+        auto it = definitions_.find(symbol);
+        if (it != definitions_.end() && it->second.params.empty()) {
+            return it->second.body;
+        }
+    }
+    return store_.mkLeaf(symbol);
+}
+
+core::TermId SmtLibReader::applyDefinition(const Definition& def, const core::TermId* args, std::size_t count) {
+    // Substitute parameters by arguments over the body DAG, sharing results.
+    std::unordered_map<core::TermId, core::TermId> memo;
+    for (std::size_t i = 0; i < count; ++i) {
+        memo[store_.mkLeaf(def.params[i])] = args[i];
+    }
+    std::vector<core::TermId> stack{def.body};
+    std::vector<core::TermId> rebuilt;
+    while (!stack.empty()) {
+        core::TermId t = stack.back();
+        if (memo.count(t)) {
+            stack.pop_back();
+            continue;
+        }
+        core::TermArgs children = store_.args(t);
+        bool ready = true;
+        for (core::TermId c : children) {
+            if (!memo.count(c)) {
+                stack.push_back(c);
+                ready = false;
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+        stack.pop_back();
+        if (children.empty()) {
+            memo[t] = t;
+            continue;
+        }
+        rebuilt.clear();
+        bool changed = false;
+        for (core::TermId c : children) {
+            core::TermId r = memo[c];
+            changed |= r != c;
+            rebuilt.push_back(r);
+        }
+        memo[t] = changed ? store_.mkApp(store_.symbol(t), rebuilt.data(), rebuilt.size()) : t;
+    }
+    return memo[def.body];
+}
+
+bool SmtLibReader::readTermFrom(Scanner& scanner, Token tok,
+                                core::TermId& result, SmtLibDiagnostic& diag) {
+    // Iterative parser: deep terms do not consume native stack.
+    const std::size_t base = frames_.size();
+
+    auto fail = [&](const char* message) {
+        diag.message = message;
+        return false;
+    };
+
+    // Reads "(name" of the next let binding, or the ")" closing the list.
+    auto nextBinding = [&](Frame& frame) {
+        auto t = scanner.next();
+        if (t == Token::LParen) {
+            if (scanner.next() != Token::Atom) {
+                return false;
+            }
+            frame.pendingName = store_.symbols().intern(scanner.text());
+            return true;
+        }
+        if (t != Token::RParen) {
+            return false;
+        }
+        // All bindings read: activate them in parallel and read the body.
+        for (std::size_t i = frame.argStart; i < letPending_.size(); ++i) {
+            bindings_[letPending_[i].first].push_back(letPending_[i].second);
+            ++activeBindings_;
+        }
+        frame.kind = FrameKind::LetBody;
+        return true;
+    };
+
+    for (bool first = true;; first = false) {
+        if (!first) {
+            tok = scanner.next();
+        }
+        core::TermId value = core::kNullTerm;
+
+        if (tok == Token::Atom) {
+            if (frames_.size() > base && frames_.back().kind == FrameKind::App && !frames_.back().started) {
+                Frame& top = frames_.back();
+                top.started = true;
+                const std::string_view head = scanner.text();
+                if (head == "let") {
+                    top.kind = FrameKind::LetBindings;
+                    top.argStart = letPending_.size();
+                    if (scanner.next() != Token::LParen || !nextBinding(top)) {
+                        return fail("malformed let bindings");
+                    }
+                } else if (head == "!") {
+                    top.kind = FrameKind::Annotation;
+                } else {
+                    top.hasHead = true;
+                    top.head = store_.symbols().intern(head);
+                }
+                continue;
+            }
+            value = resolveSymbol(store_.symbols().intern(scanner.text()));
+        } else if (tok == Token::LParen) {
+            frames_.push_back(Frame{FrameKind::App, false, false, 0, argStack_.size(), 0});
+            continue;
+        } else if (tok == Token::RParen) {
+            if (frames_.size() == base || frames_.back().kind != FrameKind::App) {
+                return fail("unexpected ')'");
+            }
+            Frame top = frames_.back();
+            frames_.pop_back();
+            const core::TermId* args = argStack_.data() + top.argStart;
+            std::size_t count = argStack_.size() - top.argStart;
+            if (!top.hasHead) {
+                value = store_.mkList(args, count);
+            } else {
+                auto def = definitions_.empty() ? definitions_.end() : definitions_.find(top.head);
+                if (def != definitions_.end() && !def->second.params.empty()) {
+                    if (def->second.params.size() != count) {
+                        return fail("wrong number of arguments to defined function");
+                    }
+                    value = applyDefinition(def->second, args, count);
+                } else {
+                    value = store_.mkApp(top.head, args, count);
+                }
+            }
+            argStack_.resize(top.argStart);
+        } else {
+            return fail(tok == Token::End ? "unexpected end of input" : "unterminated quoted token");
+        }
+
+        // Deliver the completed value to the enclosing frames.
+        for (;;) {
+            if (frames_.size() == base) {
+                result = value;
+                return true;
+            }
+            Frame& top = frames_.back();
+            if (top.kind == FrameKind::App) {
+                top.started = true;
+                argStack_.push_back(value);
+                break;
+            }
+            if (top.kind == FrameKind::LetBindings) {
+                letPending_.emplace_back(top.pendingName, value);
+                if (scanner.next() != Token::RParen || !nextBinding(top)) {
+                    return fail("malformed let binding");
+                }
+                break;
+            }
+            if (top.kind == FrameKind::LetBody) {
+                if (scanner.next() != Token::RParen) {
+                    return fail("expected ')' after let body");
+                }
+                for (std::size_t i = top.argStart; i < letPending_.size(); ++i) {
+                    unbind(letPending_[i].first);
+                }
+                letPending_.resize(top.argStart);
+                frames_.pop_back();
+                continue;
+            }
+            // Annotation: keep the term, drop the attributes.
+            if (!skipRest(scanner, diag)) {
+                return false;
+            }
+            frames_.pop_back();
+        }
+    }
+}
+
+void SmtLibReader::popScopes(std::size_t count) {
+    Scope target = scopes_[scopes_.size() - count];
+    scopes_.resize(scopes_.size() - count);
+    if (target.assertions != assertions_.size()) {
+        assertions_.resize(target.assertions);
+        conjunction_ = core::kNullTerm;
+    }
+    declarations_.resize(target.declarations);
+    for (std::size_t i = target.definitions; i < definitionOrder_.size(); ++i) {
+        definitions_.erase(definitionOrder_[i]);
+    }
+    definitionOrder_.resize(target.definitions);
+}
+
+void SmtLibReader::reset() {
+    scopes_.clear();
+    assertions_.clear();
+    conjunction_ = core::kNullTerm;
+    declarations_.clear();
+    definitions_.clear();
+    definitionOrder_.clear();
+}
+
+} // namespace io
+} // namespace semcal
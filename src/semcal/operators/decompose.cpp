@@ -8,7 +8,7 @@ DefaultDecomposeOp::apply(const state::SemanticState& σ) {
   // Default implementation: returns a single-element vector (no decomposition)
   std::vector<std::unique_ptr<state::SemanticState>> result;
   result.push_back(σ.clone());
-  return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::ok(
+  return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::noProgress(
     std::move(result)
   );
 }
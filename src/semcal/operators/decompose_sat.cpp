@@ -0,0 +1,18 @@
+#include "semcal/operators/decompose_sat.h"
+
+namespace semcal {
+namespace operators {
+
+util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>
+SatDecomposeOp::apply(const state::SemanticState& σ) {
+  auto r = backend.decompose(σ);
+  if (r.status == util::OpStatus::OK && r.value) {
+    return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::ok(
+      std::move(*r.value)
+    );
+  }
+  return util::OpResult<std::vector<std::unique_ptr<state::SemanticState>>>::unknown();
+}
+
+} // namespace operators
+} // namespace semcal
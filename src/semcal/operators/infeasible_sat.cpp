@@ -0,0 +1,18 @@
+#include "semcal/operators/infeasible_sat.h"
+
+namespace semcal {
+namespace operators {
+
+util::OpResult<void, InfeasibleWitness>
+SatInfeasibleOp::apply(const state::SemanticState& σ) {
+  auto r = backend.refute(σ);
+  if (r.status == util::OpStatus::UNSAT) {
+    return util::OpResult<void, InfeasibleWitness>::unsat(
+      { r.witness.toString() }
+    );
+  }
+  return util::OpResult<void, InfeasibleWitness>::unknown();
+}
+
+} // namespace operators
+} // namespace semcal
@@ -0,0 +1,22 @@
+#include "semcal/operators/refine_sat.h"
+
+namespace semcal {
+namespace operators {
+
+util::OpResult<std::unique_ptr<core::Formula>, RefineWitness>
+SatRefineOp::apply(const core::Formula& originalFormula,
+                   const core::Formula& relaxedFormula,
+                   const core::Model& spuriousModel) const {
+  auto r = backend.refine(originalFormula, relaxedFormula, spuriousModel);
+  if (r.status != util::OpStatus::OK || !r.value) {
+    return util::OpResult<std::unique_ptr<core::Formula>, RefineWitness>::unknown();
+  }
+  auto result = util::OpResult<std::unique_ptr<core::Formula>, RefineWitness>::ok(
+    std::move(*r.value)
+  );
+  result.witness = { r.witness.toString() };
+  return result;
+}
+
+} // namespace operators
+} // namespace semcal
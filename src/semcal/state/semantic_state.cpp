@@ -13,24 +13,86 @@ SemanticState::SemanticState(
       partialModel_(partialModel ? std::move(partialModel) : std::make_unique<core::PartialModel>()) {
 }
 
-core::ModelSet SemanticState::concretize(
+SemanticState::SemanticState(
+    SharedTag,
+    FormulaHandle formula,
+    AbstractElementHandle abstractElement,
+    PartialModelHandle partialModel)
+    : formula_(std::move(formula)),
+      abstractElement_(std::move(abstractElement)),
+      partialModel_(partialModel ? std::move(partialModel) : std::make_shared<core::PartialModel>()) {
+}
+
+std::unique_ptr<SemanticState> SemanticState::fromHandles(
+    FormulaHandle formula,
+    AbstractElementHandle abstractElement,
+    PartialModelHandle partialModel) {
+    return std::unique_ptr<SemanticState>(new SemanticState(
+        SharedTag{}, std::move(formula), std::move(abstractElement), std::move(partialModel)));
+}
+
+std::unique_ptr<SemanticState> SemanticState::withAbstractElement(AbstractElementHandle abstractElement) const {
+    return fromHandles(formula_, std::move(abstractElement), partialModel_);
+}
+
+std::unique_ptr<SemanticState> SemanticState::withFormula(FormulaHandle formula) const {
+    return fromHandles(std::move(formula), abstractElement_, partialModel_);
+}
+
+std::unique_ptr<SemanticState> SemanticState::withPartialModel(PartialModelHandle partialModel) const {
+    auto derived = fromHandles(formula_, abstractElement_, std::move(partialModel));
+    derived->componentHash_.store(componentHash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return derived;
+}
+
+std::unique_ptr<core::ModelStream> SemanticState::models(
     const core::Semantics& semantics,
     const domain::Concretization& concretization) const {
     // Conc(σ) = { M ∈ [[F]] ∩ γ(a) | M ⊇ μ }
-    auto formulaModels = semantics.interpret(getFormula());
-    auto abstractModels = concretization.concretize(getAbstractElement());
-    auto baseSet = semantics.intersect(formulaModels, abstractModels);
-    
-    // Filter models that extend the partial model
-    // Real implementations should use proper model filtering
-    return baseSet; // Placeholder: should filter by M ⊇ μ
+    FormulaHandle formula = formula_;
+    PartialModelHandle partialModel = partialModel_;
+    std::function<bool(const core::Model&)> inElement = concretization.membership(abstractElement_);
+    return core::ModelStream::filter(
+        semantics.models(*formula),
+        [formula, partialModel, inElement](const core::Model& model) {
+            return partialModel->isExtendedBy(model) && inElement(model);
+        });
+}
+
+core::ModelSet SemanticState::concretize(
+    const core::Semantics& semantics,
+    const domain::Concretization& concretization) const {
+    return models(semantics, concretization)->collect();
 }
 
 bool SemanticState::isEmpty(
     const core::Semantics& semantics,
     const domain::Concretization& concretization) const {
-    auto concreteSet = concretize(semantics, concretization);
-    return semantics.isEmpty(concreteSet);
+    return models(semantics, concretization)->next() == nullptr;
+}
+
+std::uint64_t SemanticState::fingerprint() const {
+    // Racing threads compute the same value, so a relaxed store is enough.
+    std::uint64_t hash = componentHash_.load(std::memory_order_relaxed);
+    if (hash == 0) {
+        hash = formula_->hash() * 0x9e3779b97f4a7c15ULL ^ abstractElement_->hash();
+        hash += hash == 0;  // keep 0 free for "not yet"
+        componentHash_.store(hash, std::memory_order_relaxed);
+    }
+    return hash ^ (partialModel_->hash() * 0xc2b2ae3d27d4eb4fULL);
+}
+
+bool SemanticState::sameAs(const SemanticState& other) const {
+    if (this == &other) {
+        return true;
+    }
+    if (fingerprint() != other.fingerprint()) {
+        return false;
+    }
+    return (formula_ == other.formula_ || formula_->getTerm() == other.formula_->getTerm()) &&
+           (abstractElement_ == other.abstractElement_ ||
+            abstractElement_->equals(*other.abstractElement_)) &&
+           (partialModel_ == other.partialModel_ || partialModel_->equals(*other.partialModel_));
 }
 
 std::string SemanticState::toString() const {
@@ -42,11 +104,9 @@ std::string SemanticState::toString() const {
 }
 
 std::unique_ptr<SemanticState> SemanticState::clone() const {
-    return std::make_unique<SemanticState>(
-        formula_->clone(),
-        abstractElement_->clone(),
-        partialModel_->clone()
-    );
+    auto copy = fromHandles(formula_, abstractElement_, partialModel_);
+    copy->componentHash_.store(componentHash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return copy;
 }
 
 } // namespace state
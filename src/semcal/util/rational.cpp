@@ -0,0 +1,645 @@
+#include "semcal/util/rational.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+namespace semcal {
+namespace util {
+
+namespace {
+
+using Limbs = std::vector<std::uint32_t>;
+
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+int compareMag(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (std::size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+Limbs addMag(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs r(longer.size() + 1);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < longer.size(); ++i) {
+        std::uint64_t s = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0);
+        r[i] = static_cast<std::uint32_t>(s);
+        carry = s >> 32;
+    }
+    r[longer.size()] = static_cast<std::uint32_t>(carry);
+    return r;
+}
+
+// Requires |a| >= |b|.
+Limbs subMag(const Limbs& a, const Limbs& b) {
+    Limbs r(a.size());
+    std::int64_t borrow = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        std::int64_t d = static_cast<std::int64_t>(a[i]) - borrow - (i < b.size() ? b[i] : 0);
+        borrow = d < 0 ? 1 : 0;
+        r[i] = static_cast<std::uint32_t>(d + (borrow << 32));
+    }
+    return r;
+}
+
+Limbs mulMag(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    Limbs r(a.size() + b.size(), 0);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < b.size(); ++j) {
+            std::uint64_t t = static_cast<std::uint64_t>(a[i]) * b[j] + r[i + j] + carry;
+            r[i + j] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+        r[i + b.size()] = static_cast<std::uint32_t>(carry);
+    }
+    return r;
+}
+
+// Divides in place by a single limb, returns the remainder.
+std::uint32_t divSmall(Limbs& a, std::uint32_t d) {
+    std::uint64_t rem = 0;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        std::uint64_t cur = (rem << 32) | a[i];
+        a[i] = static_cast<std::uint32_t>(cur / d);
+        rem = cur % d;
+    }
+    return static_cast<std::uint32_t>(rem);
+}
+
+void mulAddSmall(Limbs& a, std::uint32_t m, std::uint32_t add) {
+    std::uint64_t carry = add;
+    for (auto& limb : a) {
+        std::uint64_t t = static_cast<std::uint64_t>(limb) * m + carry;
+        limb = static_cast<std::uint32_t>(t);
+        carry = t >> 32;
+    }
+    if (carry) {
+        a.push_back(static_cast<std::uint32_t>(carry));
+    }
+}
+
+int leadingZeros(std::uint32_t x) {
+    int n = 0;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+}
+
+// Knuth, TAOCP vol. 2, 4.3.1, Algorithm D (|u| >= |v|, v has >= 2 limbs).
+void divMag(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r) {
+    const std::size_t m = u.size();
+    const std::size_t n = v.size();
+    const int s = leadingZeros(v[n - 1]);
+    Limbs vn(n), un(m + 1);
+    for (std::size_t i = n - 1; i > 0; --i) {
+        vn[i] = (v[i] << s) | static_cast<std::uint32_t>(static_cast<std::uint64_t>(v[i - 1]) >> (32 - s));
+    }
+    vn[0] = v[0] << s;
+    un[m] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[m - 1]) >> (32 - s));
+    for (std::size_t i = m - 1; i > 0; --i) {
+        un[i] = (u[i] << s) | static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[i - 1]) >> (32 - s));
+    }
+    un[0] = u[0] << s;
+
+    const std::uint64_t base = std::uint64_t(1) << 32;
+    q.assign(m - n + 1, 0);
+    for (std::size_t j = m - n + 1; j-- > 0;) {
+        std::uint64_t num = (static_cast<std::uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+        std::uint64_t qhat = num / vn[n - 1];
+        std::uint64_t rhat = num % vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >= base) break;
+        }
+        // Multiply and subtract.
+        std::int64_t k = 0;
+        std::int64_t t;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t p = qhat * vn[i];
+            t = static_cast<std::int64_t>(un[i + j]) - k - static_cast<std::int64_t>(p & 0xffffffffu);
+            un[i + j] = static_cast<std::uint32_t>(t);
+            k = static_cast<std::int64_t>(p >> 32) - (t >> 32);
+        }
+        t = static_cast<std::int64_t>(un[j + n]) - k;
+        un[j + n] = static_cast<std::uint32_t>(t);
+        q[j] = static_cast<std::uint32_t>(qhat);
+        if (t < 0) {
+            // Estimate was one too large: add back.
+            --q[j];
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint64_t sum = static_cast<std::uint64_t>(un[i + j]) + vn[i] + carry;
+                un[i + j] = static_cast<std::uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            un[j + n] = static_cast<std::uint32_t>(un[j + n] + carry);
+        }
+    }
+    r.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        r[i] = (un[i] >> s) | static_cast<std::uint32_t>(static_cast<std::uint64_t>(un[i + 1]) << (32 - s));
+    }
+}
+
+#ifdef SEMCAL_HAVE_INT128
+UInt128 gcd128(UInt128 a, UInt128 b) {
+    while ((a >> 64) != 0 || (b >> 64) != 0) {
+        if (b == 0) return a;
+        UInt128 t = a % b;
+        a = b;
+        b = t;
+    }
+    std::uint64_t x = static_cast<std::uint64_t>(a), y = static_cast<std::uint64_t>(b);
+    while (y != 0) {
+        std::uint64_t t = x % y;
+        x = y;
+        y = t;
+    }
+    return x;
+}
+
+bool fitsSmall(Int128 v) {
+    return v > INT64_MIN && v <= INT64_MAX;
+}
+#endif
+
+} // namespace
+
+// BigInt implementation
+
+BigInt::BigInt(std::int64_t v) {
+    negative_ = v < 0;
+    std::uint64_t m = negative_ ? 0 - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+    mag_ = {static_cast<std::uint32_t>(m), static_cast<std::uint32_t>(m >> 32)};
+    trim();
+}
+
+#ifdef SEMCAL_HAVE_INT128
+BigInt BigInt::fromInt128(Int128 v) {
+    BigInt r;
+    r.negative_ = v < 0;
+    UInt128 m = r.negative_ ? 0 - static_cast<UInt128>(v) : static_cast<UInt128>(v);
+    for (int i = 0; i < 4; ++i) {
+        r.mag_.push_back(static_cast<std::uint32_t>(m));
+        m >>= 32;
+    }
+    r.trim();
+    return r;
+}
+#endif
+
+void BigInt::trim() {
+    while (!mag_.empty() && mag_.back() == 0) {
+        mag_.pop_back();
+    }
+    if (mag_.empty()) {
+        negative_ = false;
+    }
+}
+
+bool BigInt::parse(std::string_view text, BigInt& out) {
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    if (i == text.size()) {
+        return false;
+    }
+    BigInt r;
+    for (; i < text.size(); ++i) {
+        unsigned d = static_cast<unsigned char>(text[i] - '0');
+        if (d > 9) {
+            return false;
+        }
+        mulAddSmall(r.mag_, 10, d);
+    }
+    r.negative_ = negative;
+    r.trim();
+    out = std::move(r);
+    return true;
+}
+
+bool BigInt::fitsInt64() const {
+    if (mag_.size() > 2) {
+        return false;
+    }
+    std::uint64_t m = mag_.empty() ? 0 : mag_[0];
+    if (mag_.size() == 2) {
+        m |= static_cast<std::uint64_t>(mag_[1]) << 32;
+    }
+    return negative_ ? m <= (std::uint64_t(1) << 63) : m <= static_cast<std::uint64_t>(INT64_MAX);
+}
+
+std::int64_t BigInt::toInt64() const {
+    std::uint64_t m = mag_.empty() ? 0 : mag_[0];
+    if (mag_.size() == 2) {
+        m |= static_cast<std::uint64_t>(mag_[1]) << 32;
+    }
+    return negative_ ? -static_cast<std::int64_t>(m - 1) - 1 : static_cast<std::int64_t>(m);
+}
+
+double BigInt::toDouble() const {
+    double d = 0;
+    for (std::size_t i = mag_.size(); i-- > 0;) {
+        d = d * 4294967296.0 + mag_[i];
+    }
+    return negative_ ? -d : d;
+}
+
+std::string BigInt::toString() const {
+    if (isZero()) {
+        return "0";
+    }
+    Limbs m = mag_;
+    std::string digits;
+    while (!m.empty()) {
+        std::uint32_t chunk = divSmall(m, 1000000000u);
+        while (!m.empty() && m.back() == 0) m.pop_back();
+        for (int i = 0; i < 9 && (chunk != 0 || !m.empty()); ++i) {
+            digits += static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    if (negative_) {
+        digits += '-';
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+std::uint64_t BigInt::hash() const {
+    std::uint64_t h = negative_ ? 0x9e3779b97f4a7c15ULL : 0;
+    for (std::uint32_t limb : mag_) {
+        h = mix64(h ^ limb);
+    }
+    return h;
+}
+
+BigInt BigInt::operator-() const {
+    BigInt r = *this;
+    if (!r.isZero()) {
+        r.negative_ = !r.negative_;
+    }
+    return r;
+}
+
+BigInt BigInt::abs() const {
+    BigInt r = *this;
+    r.negative_ = false;
+    return r;
+}
+
+BigInt operator+(const BigInt& a, const BigInt& b) {
+    BigInt r;
+    if (a.negative_ == b.negative_) {
+        r.mag_ = addMag(a.mag_, b.mag_);
+        r.negative_ = a.negative_;
+    } else if (compareMag(a.mag_, b.mag_) >= 0) {
+        r.mag_ = subMag(a.mag_, b.mag_);
+        r.negative_ = a.negative_;
+    } else {
+        r.mag_ = subMag(b.mag_, a.mag_);
+        r.negative_ = b.negative_;
+    }
+    r.trim();
+    return r;
+}
+
+BigInt operator-(const BigInt& a, const BigInt& b) {
+    return a + (-b);
+}
+
+BigInt operator*(const BigInt& a, const BigInt& b) {
+    BigInt r;
+    r.mag_ = mulMag(a.mag_, b.mag_);
+    r.negative_ = a.negative_ != b.negative_;
+    r.trim();
+    return r;
+}
+
+void BigInt::divMod(const BigInt& a, const BigInt& b, BigInt& q, BigInt& r) {
+    assert(!b.isZero());
+    BigInt quot, rem;
+    if (compareMag(a.mag_, b.mag_) < 0) {
+        rem = a;
+    } else if (b.mag_.size() == 1) {
+        quot.mag_ = a.mag_;
+        rem.mag_ = {divSmall(quot.mag_, b.mag_[0])};
+    } else {
+        divMag(a.mag_, b.mag_, quot.mag_, rem.mag_);
+    }
+    quot.negative_ = a.negative_ != b.negative_;
+    rem.negative_ = a.negative_;
+    quot.trim();
+    rem.trim();
+    q = std::move(quot);
+    r = std::move(rem);
+}
+
+BigInt BigInt::gcd(BigInt a, BigInt b) {
+    a.negative_ = false;
+    b.negative_ = false;
+    while (!b.isZero()) {
+        BigInt q, r;
+        divMod(a, b, q, r);
+        a = std::move(b);
+        b = std::move(r);
+    }
+    return a;
+}
+
+int BigInt::compare(const BigInt& a, const BigInt& b) {
+    if (a.negative_ != b.negative_) {
+        return a.negative_ ? -1 : 1;
+    }
+    int c = compareMag(a.mag_, b.mag_);
+    return a.negative_ ? -c : c;
+}
+
+// Rational implementation
+
+Rational Rational::fromBig(BigInt num, BigInt den) {
+    assert(!den.isZero());
+    if (den.sign() < 0) {
+        num = -num;
+        den = -den;
+    }
+    BigInt g = BigInt::gcd(num, den);
+    if (!g.isZero() && g != BigInt(1)) {
+        BigInt rem;
+        BigInt::divMod(num, g, num, rem);
+        BigInt::divMod(den, g, den, rem);
+    }
+    Rational r;
+    if (num.fitsInt64() && den.fitsInt64() && num != BigInt(INT64_MIN) && den != BigInt(INT64_MIN)) {
+        r.num_ = num.toInt64();
+        r.den_ = num.isZero() ? 1 : den.toInt64();
+        return r;
+    }
+    r.num_ = 0;
+    r.den_ = 1;
+    r.big_ = std::make_shared<const Big>(Big{std::move(num), std::move(den)});
+    return r;
+}
+
+#ifdef SEMCAL_HAVE_INT128
+Rational Rational::fromWide(Int128 num, Int128 den) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    UInt128 g = gcd128(num < 0 ? 0 - static_cast<UInt128>(num) : static_cast<UInt128>(num),
+                       static_cast<UInt128>(den));
+    if (g > 1) {
+        num /= static_cast<Int128>(g);
+        den /= static_cast<Int128>(g);
+    }
+    if (fitsSmall(num) && fitsSmall(den)) {
+        Rational r;
+        if (num != 0) {
+            r.num_ = static_cast<std::int64_t>(num);
+            r.den_ = static_cast<std::int64_t>(den);
+        }
+        return r;
+    }
+    Rational r;
+    r.big_ = std::make_shared<const Big>(Big{BigInt::fromInt128(num), BigInt::fromInt128(den)});
+    return r;
+}
+#endif
+
+Rational Rational::fraction(std::int64_t num, std::int64_t den) {
+    assert(den != 0);
+    if (num != INT64_MIN && den != INT64_MIN) {
+        if (den < 0) {
+            num = -num;
+            den = -den;
+        }
+        std::uint64_t a = static_cast<std::uint64_t>(num < 0 ? -num : num);
+        std::uint64_t b = static_cast<std::uint64_t>(den);
+        while (b != 0) {
+            std::uint64_t t = a % b;
+            a = b;
+            b = t;
+        }
+        Rational r;
+        if (num != 0) {
+            r.num_ = num / static_cast<std::int64_t>(a);
+            r.den_ = den / static_cast<std::int64_t>(a);
+        }
+        return r;
+    }
+    return fromBig(BigInt(num), BigInt(den));
+}
+
+Rational Rational::fraction(const BigInt& num, const BigInt& den) {
+    return fromBig(num, den);
+}
+
+BigInt Rational::bigNum() const {
+    return big_ ? big_->num : BigInt(num_);
+}
+
+BigInt Rational::bigDen() const {
+    return big_ ? big_->den : BigInt(den_);
+}
+
+bool Rational::parse(std::string_view text, Rational& out) {
+    std::size_t slash = text.find('/');
+    if (slash != std::string_view::npos) {
+        BigInt num, den;
+        if (!BigInt::parse(text.substr(0, slash), num) ||
+            !BigInt::parse(text.substr(slash + 1), den) || den.isZero()) {
+            return false;
+        }
+        out = fromBig(std::move(num), std::move(den));
+        return true;
+    }
+    std::size_t dot = text.find('.');
+    if (dot != std::string_view::npos) {
+        std::string_view frac = text.substr(dot + 1);
+        std::string digits(text.substr(0, dot));
+        if (digits.empty() || digits == "-" || digits == "+" || frac.empty() ||
+            frac.find_first_not_of("0123456789") != std::string_view::npos) {
+            return false;
+        }
+        digits += frac;
+        BigInt num;
+        if (!BigInt::parse(digits, num)) {
+            return false;
+        }
+        BigInt den(1);
+        for (std::size_t i = 0; i < frac.size(); ++i) {
+            den = den * BigInt(10);
+        }
+        out = fromBig(std::move(num), std::move(den));
+        return true;
+    }
+    BigInt num;
+    if (!BigInt::parse(text, num)) {
+        return false;
+    }
+    out = fromBig(std::move(num), BigInt(1));
+    return true;
+}
+
+int Rational::sign() const {
+    if (big_) {
+        return big_->num.sign();
+    }
+    return (num_ > 0) - (num_ < 0);
+}
+
+double Rational::toDouble() const {
+    if (big_) {
+        return big_->num.toDouble() / big_->den.toDouble();
+    }
+    return static_cast<double>(num_) / static_cast<double>(den_);
+}
+
+Rational Rational::fromDouble(double d) {
+    if (d == 0.0) {
+        return Rational();
+    }
+    int exp = 0;
+    double m = std::frexp(d, &exp);  // d = m * 2^exp, 0.5 <= |m| < 1
+    std::int64_t mant = static_cast<std::int64_t>(std::ldexp(m, 53));
+    exp -= 53;
+    while ((mant & 1) == 0) {
+        mant /= 2;
+        ++exp;
+    }
+    Rational scale(1);
+    for (int k = exp < 0 ? -exp : exp; k > 0; k -= 62) {
+        scale *= Rational(std::int64_t(1) << (k < 62 ? k : 62));
+    }
+    return exp < 0 ? Rational(mant) / scale : Rational(mant) * scale;
+}
+
+double Rational::toDoubleDown() const {
+    double d = toDouble();
+    if (!std::isfinite(d)) {
+        if (*this > fromDouble(DBL_MAX)) return DBL_MAX;
+        if (*this < fromDouble(-DBL_MAX)) return -HUGE_VAL;
+        return -HUGE_VAL;  // both parts overflowed; stay sound
+    }
+    while (std::isfinite(d) && fromDouble(d) > *this) {
+        d = std::nextafter(d, -HUGE_VAL);
+    }
+    return d;
+}
+
+double Rational::toDoubleUp() const {
+    double d = toDouble();
+    if (!std::isfinite(d)) {
+        if (*this > fromDouble(DBL_MAX)) return HUGE_VAL;
+        if (*this < fromDouble(-DBL_MAX)) return -DBL_MAX;
+        return HUGE_VAL;
+    }
+    while (std::isfinite(d) && fromDouble(d) < *this) {
+        d = std::nextafter(d, HUGE_VAL);
+    }
+    return d;
+}
+
+std::string Rational::toString() const {
+    if (big_) {
+        return big_->den == BigInt(1) ? big_->num.toString()
+                                      : big_->num.toString() + "/" + big_->den.toString();
+    }
+    return den_ == 1 ? std::to_string(num_) : std::to_string(num_) + "/" + std::to_string(den_);
+}
+
+std::uint64_t Rational::hash() const {
+    if (big_) {
+        return mix64(big_->num.hash() ^ (big_->den.hash() * 0x9e3779b97f4a7c15ULL));
+    }
+    return mix64(static_cast<std::uint64_t>(num_) ^
+                 (static_cast<std::uint64_t>(den_) * 0x9e3779b97f4a7c15ULL));
+}
+
+Rational Rational::operator-() const {
+    if (big_) {
+        return fromBig(-big_->num, big_->den);
+    }
+    Rational r = *this;
+    r.num_ = -num_;  // num_ != INT64_MIN by invariant
+    return r;
+}
+
+Rational operator+(const Rational& a, const Rational& b) {
+#ifdef SEMCAL_HAVE_INT128
+    if (!a.big_ && !b.big_) {
+        if (a.den_ == 1 && b.den_ == 1) {
+            return Rational::fromWide(static_cast<Int128>(a.num_) + b.num_, 1);
+        }
+        return Rational::fromWide(static_cast<Int128>(a.num_) * b.den_ + static_cast<Int128>(b.num_) * a.den_,
+                        static_cast<Int128>(a.den_) * b.den_);
+    }
+#endif
+    return Rational::fromBig(a.bigNum() * b.bigDen() + b.bigNum() * a.bigDen(),
+                             a.bigDen() * b.bigDen());
+}
+
+Rational operator-(const Rational& a, const Rational& b) {
+    return a + (-b);
+}
+
+Rational operator*(const Rational& a, const Rational& b) {
+#ifdef SEMCAL_HAVE_INT128
+    if (!a.big_ && !b.big_) {
+        return Rational::fromWide(static_cast<Int128>(a.num_) * b.num_, static_cast<Int128>(a.den_) * b.den_);
+    }
+#endif
+    return Rational::fromBig(a.bigNum() * b.bigNum(), a.bigDen() * b.bigDen());
+}
+
+Rational operator/(const Rational& a, const Rational& b) {
+    assert(!b.isZero());
+#ifdef SEMCAL_HAVE_INT128
+    if (!a.big_ && !b.big_) {
+        return Rational::fromWide(static_cast<Int128>(a.num_) * b.den_, static_cast<Int128>(a.den_) * b.num_);
+    }
+#endif
+    return Rational::fromBig(a.bigNum() * b.bigDen(), a.bigDen() * b.bigNum());
+}
+
+int Rational::compare(const Rational& a, const Rational& b) {
+#ifdef SEMCAL_HAVE_INT128
+    if (!a.big_ && !b.big_) {
+        Int128 l = static_cast<Int128>(a.num_) * b.den_;
+        Int128 r = static_cast<Int128>(b.num_) * a.den_;
+        return (l > r) - (l < r);
+    }
+#endif
+    return BigInt::compare(a.bigNum() * b.bigDen(), b.bigNum() * a.bigDen());
+}
+
+} // namespace util
+} // namespace semcal
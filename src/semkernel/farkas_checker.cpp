@@ -0,0 +1,270 @@
+#include "semkernel/farkas_checker.h"
+#include "semcal/core/linear_system.h"
+#include "semcal/core/term_store.h"
+#include "semcal/domain/interval_box.h"
+#include <cctype>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace semcal {
+namespace kernel {
+
+using util::Rational;
+
+namespace {
+
+constexpr std::size_t kNoRow = static_cast<std::size_t>(-1);
+
+// One named bound and its multiplier: row r of the linear system, or
+// the single variable x when row == kNoRow. In ≤-form the coefficients
+// are negated for a lower bound, and rhs is stored already negated.
+struct Bound {
+    std::size_t row = kNoRow;
+    core::VariableId variable = 0;
+    bool upper = true;
+    Rational rhs;
+    Rational multiplier;
+};
+
+// Call f(variable, coefficient, negate) for each ≤-form term of a bound.
+template <class F>
+void forEachTerm(const core::LinearSystem* system, const Bound& bound, F&& f) {
+    if (bound.row == kNoRow) {
+        f(bound.variable, Rational(1), !bound.upper);
+        return;
+    }
+    for (std::size_t k = system->rowBegin(bound.row); k < system->rowEnd(bound.row); ++k) {
+        f(system->variable(system->column(k)), system->coefficient(k), !bound.upper);
+    }
+}
+
+struct Entry {
+    std::string kind;
+    std::string name;
+    bool upper;
+    Rational multiplier;
+};
+
+std::vector<std::string> tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (c == '(' || c == ')') {
+            tokens.emplace_back(1, c);
+            ++i;
+        } else {
+            std::size_t start = i;
+            while (i < text.size() && text[i] != '(' && text[i] != ')' &&
+                   !std::isspace(static_cast<unsigned char>(text[i]))) {
+                ++i;
+            }
+            tokens.push_back(text.substr(start, i - start));
+        }
+    }
+    return tokens;
+}
+
+// (farkas (kind name upper|lower multiplier) ...)
+bool parse(const std::string& text, std::vector<Entry>& entries) {
+    std::vector<std::string> tokens = tokenize(text);
+    if (tokens.size() < 3 || tokens[0] != "(" || tokens[1] != "farkas" || tokens.back() != ")") {
+        return false;
+    }
+    std::size_t end = tokens.size() - 1;
+    for (std::size_t i = 2; i < end; i += 6) {
+        if (i + 6 > end || tokens[i] != "(" || tokens[i + 5] != ")") {
+            return false;
+        }
+        Entry entry;
+        entry.kind = tokens[i + 1];
+        entry.name = tokens[i + 2];
+        if (tokens[i + 3] != "upper" && tokens[i + 3] != "lower") {
+            return false;
+        }
+        entry.upper = tokens[i + 3] == "upper";
+        if (!Rational::parse(tokens[i + 4], entry.multiplier)) {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool parseIndex(const std::string& text, std::size_t& index) {
+    if (text.empty() || text.size() > 9) {
+        return false;
+    }
+    index = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        index = index * 10 + static_cast<std::size_t>(c - '0');
+    }
+    return true;
+}
+
+#ifdef SEMCAL_HAVE_INT128
+using util::Int128;
+
+// Scale the multipliers to integers and sum in 128-bit arithmetic.
+// Returns false (caller falls back to Rational) if any value is not a
+// small integer after scaling or a partial sum overflows.
+bool sumSmall(const core::LinearSystem* system, const std::vector<Bound>& bounds, bool& refuted) {
+    std::int64_t scale = 1;
+    for (const Bound& bound : bounds) {
+        if (!bound.multiplier.isSmall()) {
+            return false;
+        }
+        std::int64_t den = bound.multiplier.smallDen();
+        std::int64_t factor = den / std::gcd(scale, den);
+        if (__builtin_mul_overflow(scale, factor, &scale)) {
+            return false;
+        }
+    }
+
+    std::unordered_map<core::VariableId, Int128> sums;
+    Int128 rhs = 0;
+    auto accumulate = [](Int128& sum, std::int64_t lambda, const Rational& value, bool negate) {
+        if (!value.isSmall() || !value.isInteger()) {
+            return false;
+        }
+        // |λ·v| < 2^126, so only the running sum can overflow.
+        Int128 term = static_cast<Int128>(lambda) * value.smallNum();
+        return !__builtin_add_overflow(sum, negate ? -term : term, &sum);
+    };
+    for (const Bound& bound : bounds) {
+        std::int64_t lambda;
+        if (__builtin_mul_overflow(bound.multiplier.smallNum(), scale / bound.multiplier.smallDen(),
+                                   &lambda)) {
+            return false;
+        }
+        bool fits = true;
+        forEachTerm(system, bound, [&](core::VariableId var, const Rational& c, bool negate) {
+            fits = fits && accumulate(sums[var], lambda, c, negate);
+        });
+        if (!fits || !accumulate(rhs, lambda, bound.rhs, false)) {
+            return false;
+        }
+    }
+
+    refuted = rhs < 0;
+    for (const auto& entry : sums) {
+        refuted = refuted && entry.second == 0;
+    }
+    return true;
+}
+#endif
+
+bool sumExact(const core::LinearSystem* system, const std::vector<Bound>& bounds) {
+    std::unordered_map<core::VariableId, Rational> sums;
+    Rational rhs;
+    for (const Bound& bound : bounds) {
+        forEachTerm(system, bound, [&](core::VariableId var, const Rational& c, bool negate) {
+            Rational term = bound.multiplier * c;
+            sums[var] += negate ? -term : term;
+        });
+        rhs += bound.multiplier * bound.rhs;
+    }
+    for (const auto& entry : sums) {
+        if (!entry.second.isZero()) {
+            return false;
+        }
+    }
+    return rhs.sign() < 0;
+}
+
+} // namespace
+
+bool FarkasChecker::check(const state::SemanticState& σ, const std::string& certificate) {
+    error_.clear();
+    fastPath_ = false;
+
+    std::vector<Entry> entries;
+    if (!parse(certificate, entries)) {
+        return fail("malformed certificate");
+    }
+
+    const core::SymbolTable& symbols = core::TermStore::global().symbols();
+    const auto* box = dynamic_cast<const domain::IntervalBox*>(&σ.getAbstractElement());
+    std::shared_ptr<const core::LinearSystem> system;
+
+    std::vector<Bound> bounds;
+    bounds.reserve(entries.size());
+    for (Entry& entry : entries) {
+        int sign = entry.multiplier.sign();
+        if (sign < 0) {
+            return fail("negative multiplier for " + entry.kind + " " + entry.name);
+        }
+        if (sign == 0) {
+            continue;
+        }
+
+        Bound bound;
+        bound.multiplier = std::move(entry.multiplier);
+        if (entry.kind == "row") {
+            if (!system) {
+                system = σ.getFormula().getLinearSystem();
+            }
+            std::size_t row;
+            if (!parseIndex(entry.name, row) || row >= system->numRows()) {
+                return fail("no linear constraint row " + entry.name);
+            }
+            if (entry.upper ? !system->hasUpper(row) : !system->hasLower(row)) {
+                return fail("row " + entry.name + " has no such bound");
+            }
+            bound.row = row;
+            bound.rhs = entry.upper ? system->upper(row) : system->lower(row);
+        } else if (entry.kind == "box" || entry.kind == "model") {
+            core::SymbolId var;
+            if (!symbols.lookup(entry.name, var)) {
+                return fail("unknown variable " + entry.name);
+            }
+            if (entry.kind == "box") {
+                if (!box) {
+                    return fail("state has no interval box");
+                }
+                double value = entry.upper ? box->upper(var) : box->lower(var);
+                if (!std::isfinite(value)) {
+                    return fail("no finite box bound on " + entry.name);
+                }
+                bound.rhs = Rational::fromDouble(value);
+            } else {
+                const core::Value& value = σ.getPartialModel().get(var);
+                if (!value.isNumber()) {
+                    return fail("no numeric model value for " + entry.name);
+                }
+                bound.rhs = value.toRational();
+            }
+            bound.variable = var;
+        } else {
+            return fail("cannot justify bound " + entry.kind + " " + entry.name);
+        }
+
+        bound.upper = entry.upper;
+        if (!entry.upper) {
+            bound.rhs = -bound.rhs;
+        }
+        bounds.push_back(std::move(bound));
+    }
+
+    bool refuted;
+#ifdef SEMCAL_HAVE_INT128
+    fastPath_ = sumSmall(system.get(), bounds, refuted);
+    if (!fastPath_) {
+        refuted = sumExact(system.get(), bounds);
+    }
+#else
+    refuted = sumExact(system.get(), bounds);
+#endif
+    return refuted ? true : fail("bounds do not sum to a contradiction");
+}
+
+} // namespace kernel
+} // namespace semcal
@@ -1,4 +1,6 @@
 #include "semkernel/kernel.h"
+#include "semkernel/farkas_checker.h"
+#include "semkernel/lrat_checker.h"
 #include "semcal/core/semantics.h"
 #include "semcal/domain/concretization.h"
 #include <sstream>
@@ -69,6 +71,19 @@ bool DefaultSemKernel::checkRefutation(const state::SemanticState& state,
   if (!evidence.isValid()) {
     return false;
   }
+
+  // LP refutations carry a Farkas certificate, checked exactly
+  if (evidence.type == "farkas" || evidence.data.compare(0, 7, "(farkas") == 0) {
+    FarkasChecker checker;
+    return checker.check(state, evidence.data);
+  }
+
+  // SAT refutations carry a binary LRAT proof, inline or in a file
+  if (evidence.type == "lrat" || evidence.type == "lrat-file") {
+    LratChecker checker;
+    return evidence.type == "lrat" ? checker.check(state, evidence.data)
+                                   : checker.checkFile(state, evidence.data);
+  }
   
   // Placeholder: real implementations should verify Conc(σ) = ∅
   return true;
@@ -0,0 +1,274 @@
+#include "semkernel/lrat_checker.h"
+#include "semcal/core/cnf_encoder.h"
+#include <fstream>
+
+namespace semcal {
+namespace kernel {
+
+using core::Lit;
+
+bool LratChecker::begin(const state::SemanticState& σ) {
+    literals_.clear();
+    clauses_.clear();
+    garbage_ = 0;
+    values_.clear();
+    assigned_.clear();
+    falsified_.clear();
+    mode_ = Mode::Step;
+    number_ = 0;
+    shift_ = 0;
+    refuted_ = false;
+    steps_ = 0;
+    error_.clear();
+
+    // Numbered exactly as the SAT backend loads the formula
+    core::CnfEncoder encoder;
+    encoder.encode(σ.getFormula());
+    const core::ClauseArena& arena = encoder.getClauses();
+    ensureVariables(arena.numVars());
+    literals_.reserve(arena.numLiterals());
+    clauses_.reserve(arena.numClauses());
+    for (std::size_t i = 0; i < arena.numClauses(); ++i) {
+        core::ClauseView clause = arena.clause(i);
+        store(i + 1, clause.data, clause.size());
+    }
+    for (Lit lit : encoder.literalsOf(σ.getPartialModel())) {
+        falsified_[core::litNegate(lit)] = 1;
+    }
+    return true;
+}
+
+void LratChecker::ensureVariables(std::uint32_t count) {
+    if (2 * static_cast<std::size_t>(count) > values_.size()) {
+        values_.resize(2 * static_cast<std::size_t>(count), 0);
+        falsified_.resize(2 * static_cast<std::size_t>(count), 0);
+    }
+}
+
+void LratChecker::store(std::uint64_t id, const Lit* lits, std::size_t count) {
+    clauses_.emplace(id, Slot{literals_.size(), static_cast<std::uint32_t>(count)});
+    literals_.insert(literals_.end(), lits, lits + count);
+}
+
+bool LratChecker::remove(std::uint64_t id) {
+    auto it = clauses_.find(id);
+    if (it == clauses_.end()) {
+        return fail("deleted clause " + std::to_string(id) + " does not exist");
+    }
+    garbage_ += it->second.size;
+    clauses_.erase(it);
+
+    // Reclaim deleted literals once they outweigh the live ones.
+    if (garbage_ > (1u << 20) && 2 * garbage_ > literals_.size()) {
+        std::vector<Lit> live;
+        live.reserve(literals_.size() - garbage_);
+        for (auto& entry : clauses_) {
+            Slot& slot = entry.second;
+            std::size_t offset = live.size();
+            live.insert(live.end(), literals_.begin() + slot.offset,
+                        literals_.begin() + slot.offset + slot.size);
+            slot.offset = offset;
+        }
+        literals_.swap(live);
+        garbage_ = 0;
+    }
+    return true;
+}
+
+bool LratChecker::feed(const std::uint8_t* data, std::size_t size) {
+    if (!error_.empty()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        std::uint8_t byte = data[i];
+        if (mode_ == Mode::Step) {
+            if (byte == 'a') {
+                mode_ = Mode::Id;
+            } else if (byte == 'd') {
+                mode_ = Mode::Delete;
+            } else {
+                return fail("unknown step '" + std::string(1, static_cast<char>(byte)) + "'");
+            }
+            continue;
+        }
+        if (shift_ > 63) {
+            return fail("number too large");
+        }
+        number_ |= static_cast<std::uint64_t>(byte & 0x7f) << shift_;
+        if (byte & 0x80) {
+            shift_ += 7;
+            continue;
+        }
+        std::uint64_t x = number_;
+        number_ = 0;
+        shift_ = 0;
+        if (!number(x)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LratChecker::number(std::uint64_t x) {
+    switch (mode_) {
+    case Mode::Id:
+        if (x == 0 || (x & 1) != 0) {
+            return fail("bad clause id");
+        }
+        id_ = x >> 1;
+        lits_.clear();
+        hints_.clear();
+        mode_ = Mode::Literals;
+        return true;
+    case Mode::Literals:
+        if (x == 0) {
+            mode_ = Mode::Hints;
+        } else if (x < 2 || x - 2 > 0xffffffffu) {
+            return fail("bad literal");
+        } else {
+            lits_.push_back(static_cast<Lit>(x - 2));  // 2(v + 1) + sign
+        }
+        return true;
+    case Mode::Hints:
+        if (x == 0) {
+            mode_ = Mode::Step;
+            return addStep();
+        }
+        if ((x & 1) != 0) {
+            return fail("step " + std::to_string(id_) + ": RAT hints are not supported");
+        }
+        hints_.push_back(x >> 1);
+        return true;
+    case Mode::Delete:
+        if (x == 0) {
+            mode_ = Mode::Step;
+            return true;
+        }
+        if ((x & 1) != 0) {
+            return fail("bad clause id");
+        }
+        return remove(x >> 1);
+    case Mode::Step:
+        break;
+    }
+    return fail("unexpected number");
+}
+
+bool LratChecker::addStep() {
+    if (clauses_.count(id_) != 0) {
+        return fail("step " + std::to_string(id_) + ": id already in use");
+    }
+    for (Lit lit : lits_) {
+        ensureVariables(core::litVar(lit) + 1);
+    }
+
+    // Assume the clause false; a tautology holds trivially.
+    bool tautology = false;
+    for (Lit lit : lits_) {
+        if (values_[lit] == 1) {
+            tautology = true;
+            break;
+        }
+        if (values_[lit] == 0) {
+            values_[lit] = -1;
+            values_[core::litNegate(lit)] = 1;
+            assigned_.push_back(core::litNegate(lit));
+        }
+    }
+    bool ok = tautology || propagate();
+    for (Lit lit : assigned_) {
+        values_[lit] = 0;
+        values_[core::litNegate(lit)] = 0;
+    }
+    assigned_.clear();
+    if (!ok) {
+        return false;
+    }
+
+    ++steps_;
+    store(id_, lits_.data(), lits_.size());
+    if (!tautology) {
+        bool refutes = true;
+        for (Lit lit : lits_) {
+            refutes = refutes && falsified_[lit] != 0;
+        }
+        refuted_ = refuted_ || refutes;
+    }
+    return true;
+}
+
+bool LratChecker::propagate() {
+    for (std::uint64_t hint : hints_) {
+        auto it = clauses_.find(hint);
+        if (it == clauses_.end()) {
+            return fail("step " + std::to_string(id_) + ": hint " + std::to_string(hint) +
+                        " is not a clause");
+        }
+        const Lit* lits = literals_.data() + it->second.offset;
+        Lit unit = 0;
+        bool found = false;
+        for (std::uint32_t k = 0; k < it->second.size; ++k) {
+            std::int8_t value = values_[lits[k]];
+            if (value == 1) {
+                return fail("step " + std::to_string(id_) + ": hint " + std::to_string(hint) +
+                            " is satisfied");
+            }
+            if (value == 0) {
+                if (found && lits[k] != unit) {
+                    return fail("step " + std::to_string(id_) + ": hint " + std::to_string(hint) +
+                                " is not unit");
+                }
+                unit = lits[k];
+                found = true;
+            }
+        }
+        if (!found) {
+            return true;  // falsified: the clause follows
+        }
+        values_[unit] = 1;
+        values_[core::litNegate(unit)] = -1;
+        assigned_.push_back(unit);
+    }
+    return fail("step " + std::to_string(id_) + ": hints end without a conflict");
+}
+
+bool LratChecker::finish() {
+    if (!error_.empty()) {
+        return false;
+    }
+    if (mode_ != Mode::Step || shift_ != 0) {
+        return fail("proof ends inside a step");
+    }
+    if (!refuted_) {
+        return fail("no derived clause is falsified by the partial model");
+    }
+    return true;
+}
+
+bool LratChecker::check(const state::SemanticState& σ, const std::string& proof) {
+    return begin(σ) &&
+           feed(reinterpret_cast<const std::uint8_t*>(proof.data()), proof.size()) &&
+           finish();
+}
+
+bool LratChecker::checkFile(const state::SemanticState& σ, const std::string& path) {
+    if (!begin(σ)) {
+        return false;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return fail("cannot open " + path);
+    }
+    std::vector<char> chunk(1 << 20);
+    while (in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        auto count = static_cast<std::size_t>(in.gcount());
+        if (!feed(reinterpret_cast<const std::uint8_t*>(chunk.data()), count)) {
+            return false;
+        }
+    }
+    return finish();
+}
+
+} // namespace kernel
+} // namespace semcal
@@ -0,0 +1,193 @@
+#include "semsearch/frontier.h"
+
+namespace semcal {
+namespace search {
+
+void StackFrontier::push(std::unique_ptr<state::SemanticState> state) {
+  stack_.push_back(std::move(state));
+}
+
+std::unique_ptr<state::SemanticState> StackFrontier::pop() {
+  if (stack_.empty()) {
+    return nullptr;
+  }
+  auto state = std::move(stack_.back());
+  stack_.pop_back();
+  return state;
+}
+
+void FifoFrontier::push(std::unique_ptr<state::SemanticState> state) {
+  queue_.push_back(std::move(state));
+}
+
+std::unique_ptr<state::SemanticState> FifoFrontier::pop() {
+  if (queue_.empty()) {
+    return nullptr;
+  }
+  auto state = std::move(queue_.front());
+  queue_.pop_front();
+  return state;
+}
+
+BestFirstFrontier::BestFirstFrontier(Heuristic heuristic, size_t capacity)
+  : heuristic_(std::move(heuristic)),
+    capacity_(capacity) {
+}
+
+void BestFirstFrontier::push(std::unique_ptr<state::SemanticState> state) {
+  double priority = heuristic_ && state ? heuristic_(*state) : 0.0;
+  push(std::move(state), priority);
+}
+
+BestFirstFrontier::Handle BestFirstFrontier::push(std::unique_ptr<state::SemanticState> state,
+                                                  double priority) {
+  if (bounded() && heap_.size() >= capacity_) {
+    // The new entry loses ties (it has the largest sequence number).
+    if (!(priority < entries_[worstHeap_.front()].priority)) {
+      ++evicted_;
+      return kNoHandle;
+    }
+    evictWorst();
+  }
+  Handle handle;
+  if (!freeSlots_.empty()) {
+    handle = freeSlots_.back();
+    freeSlots_.pop_back();
+    entries_[handle] = Entry{priority, nextSequence_++, std::move(state), {0, 0}};
+  } else {
+    handle = static_cast<Handle>(entries_.size());
+    entries_.push_back(Entry{priority, nextSequence_++, std::move(state), {0, 0}});
+  }
+  insert(kBest, handle);
+  if (bounded()) {
+    insert(kWorst, handle);
+  }
+  return handle;
+}
+
+std::unique_ptr<state::SemanticState> BestFirstFrontier::pop() {
+  if (heap_.empty()) {
+    return nullptr;
+  }
+  Handle top = heap_.front();
+  removeAt(kBest, 0);
+  if (bounded()) {
+    removeAt(kWorst, entries_[top].position[kWorst]);
+  }
+  auto state = std::move(entries_[top].state);
+  release(top);
+  return state;
+}
+
+const state::SemanticState* BestFirstFrontier::top() const {
+  return heap_.empty() ? nullptr : entries_[heap_.front()].state.get();
+}
+
+double BestFirstFrontier::topPriority() const {
+  return heap_.empty() ? 0.0 : entries_[heap_.front()].priority;
+}
+
+void BestFirstFrontier::updatePriority(Handle handle, double priority) {
+  entries_[handle].priority = priority;
+  for (int which : {kBest, kWorst}) {
+    if (which == kWorst && !bounded()) {
+      break;
+    }
+    siftUp(which, entries_[handle].position[which]);
+    siftDown(which, entries_[handle].position[which]);
+  }
+}
+
+void BestFirstFrontier::setCapacity(size_t capacity) {
+  capacity_ = capacity;
+  worstHeap_.clear();
+  if (!bounded()) {
+    return;
+  }
+  for (Handle handle : heap_) {
+    insert(kWorst, handle);
+  }
+  while (heap_.size() > capacity_) {
+    evictWorst();
+  }
+}
+
+void BestFirstFrontier::clear() {
+  entries_.clear();
+  freeSlots_.clear();
+  heap_.clear();
+  worstHeap_.clear();
+}
+
+void BestFirstFrontier::insert(int which, Handle handle) {
+  std::vector<Handle>& heap = heapFor(which);
+  heap.push_back(handle);
+  entries_[handle].position[which] = heap.size() - 1;
+  siftUp(which, heap.size() - 1);
+}
+
+void BestFirstFrontier::removeAt(int which, size_t position) {
+  std::vector<Handle>& heap = heapFor(which);
+  Handle last = heap.back();
+  heap.pop_back();
+  if (position < heap.size()) {
+    place(which, position, last);
+    siftUp(which, position);
+    siftDown(which, entries_[last].position[which]);
+  }
+}
+
+void BestFirstFrontier::siftUp(int which, size_t position) {
+  std::vector<Handle>& heap = heapFor(which);
+  Handle moving = heap[position];
+  while (position > 0) {
+    size_t parent = (position - 1) / kArity;
+    if (!precedes(which, moving, heap[parent])) {
+      break;
+    }
+    place(which, position, heap[parent]);
+    position = parent;
+  }
+  place(which, position, moving);
+}
+
+void BestFirstFrontier::siftDown(int which, size_t position) {
+  std::vector<Handle>& heap = heapFor(which);
+  Handle moving = heap[position];
+  const size_t n = heap.size();
+  for (;;) {
+    size_t first = position * kArity + 1;
+    if (first >= n) {
+      break;
+    }
+    size_t best = first;
+    size_t end = first + kArity < n ? first + kArity : n;
+    for (size_t child = first + 1; child < end; ++child) {
+      if (precedes(which, heap[child], heap[best])) {
+        best = child;
+      }
+    }
+    if (!precedes(which, heap[best], moving)) {
+      break;
+    }
+    place(which, position, heap[best]);
+    position = best;
+  }
+  place(which, position, moving);
+}
+
+void BestFirstFrontier::release(Handle handle) {
+  entries_[handle].state.reset();
+  freeSlots_.push_back(handle);
+}
+
+void BestFirstFrontier::evictWorst() {
+  Handle worst = worstHeap_.front();
+  removeAt(kWorst, 0);
+  removeAt(kBest, entries_[worst].position[kBest]);
+  release(worst);
+  ++evicted_;
+}
+
+} // namespace search
+} // namespace semcal
@@ -0,0 +1,293 @@
+#include "semsearch/parallel_search_engine.h"
+#include <thread>
+
+namespace semcal {
+namespace search {
+
+namespace {
+
+// Worker run by the current thread, if any; tagged with its engine so
+// that nested or unrelated engines do not pick it up.
+struct WorkerBinding {
+  const void* engine = nullptr;
+  size_t index = 0;
+};
+
+thread_local WorkerBinding currentBinding;
+
+// Idle rounds before a worker yields its core, and before it parks
+constexpr unsigned kSpinRounds = 64;
+constexpr unsigned kYieldRounds = 256;
+
+uint64_t nextRandom(uint64_t& x) {
+  // xorshift64
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+bool isDecisive(SearchResult result) {
+  return result == SearchResult::SAT || result == SearchResult::UNSAT;
+}
+
+} // namespace
+
+ParallelSearchEngine::ParallelSearchEngine(size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0) {
+      numThreads = 1;
+    }
+  }
+  workers_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+    workers_.push_back(std::move(worker));
+  }
+}
+
+ParallelSearchEngine::~ParallelSearchEngine() = default;
+
+ParallelSearchEngine::Worker* ParallelSearchEngine::currentWorker() const {
+  return currentBinding.engine == this ? workers_[currentBinding.index].get() : nullptr;
+}
+
+SearchResult ParallelSearchEngine::execute(
+    const state::SemanticState& initialState,
+    std::function<SearchResult(state::SemanticState&)> strategy,
+    SearchPolicy /*policy*/) {
+  clear();
+  error_ = nullptr;
+  strategy_ = std::move(strategy);
+  done_.store(false, std::memory_order_relaxed);
+  result_.store(static_cast<int>(SearchResult::UNKNOWN), std::memory_order_relaxed);
+  for (auto& worker : workers_) {
+    worker->steals.store(0, std::memory_order_relaxed);
+  }
+
+  // Seed worker 0 before any thread starts; thread creation publishes it.
+  pending_.store(1, std::memory_order_relaxed);
+  workers_[0]->deque.push(initialState.clone());
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers_.size() - 1);
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    threads.emplace_back([this, i] { runWorker(i); });
+  }
+  WorkerBinding saved = currentBinding;
+  runWorker(0);
+  currentBinding = saved;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // States left behind after an early SAT/UNSAT.
+  clear();
+  strategy_ = nullptr;
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+  return static_cast<SearchResult>(result_.load(std::memory_order_relaxed));
+}
+
+void ParallelSearchEngine::runWorker(size_t index) {
+  currentBinding = WorkerBinding{this, index};
+  Worker& self = *workers_[index];
+  unsigned idleRounds = 0;
+
+  while (!done_.load(std::memory_order_acquire)) {
+    auto state = self.deque.pop();
+    if (!state) {
+      state = takeExternal();
+    }
+    if (!state) {
+      state = stealFor(index);
+    }
+    if (!state) {
+      if (pending_.load(std::memory_order_acquire) == 0) {
+        break;
+      }
+      // Back off: spin briefly, then yield the core, then park.
+      if (++idleRounds > kYieldRounds) {
+        park();
+        idleRounds = 0;
+      } else if (idleRounds > kSpinRounds) {
+        std::this_thread::yield();
+      }
+      continue;
+    }
+    idleRounds = 0;
+
+    SearchResult result = SearchResult::UNKNOWN;
+    try {
+      result = strategy_(*state);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      done_.store(true, std::memory_order_release);
+    }
+    if (isDecisive(result)) {
+      int expected = static_cast<int>(SearchResult::UNKNOWN);
+      result_.compare_exchange_strong(expected, static_cast<int>(result),
+                                      std::memory_order_acq_rel);
+      done_.store(true, std::memory_order_release);
+    }
+    state.reset();
+    // Children were counted when pushed, so this cannot reach 0 early.
+    bool exhausted = pending_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    if (exhausted || done_.load(std::memory_order_relaxed)) {
+      wakeAll();
+    }
+  }
+  currentBinding = WorkerBinding{};
+}
+
+bool ParallelSearchEngine::hasQueuedWork() const {
+  if (externalSize_.load(std::memory_order_relaxed) != 0) {
+    return true;
+  }
+  for (const auto& worker : workers_) {
+    if (!worker->deque.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelSearchEngine::park() {
+  std::unique_lock<std::mutex> lock(parkMutex_);
+  parked_.fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in wakeOne(): either the pusher sees this
+  // worker parked, or this worker sees the pushed state.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t seen = wakeups_;
+  parkCv_.wait(lock, [&] {
+    return wakeups_ != seen || hasQueuedWork() ||
+           done_.load(std::memory_order_acquire) || pending_.load(std::memory_order_acquire) == 0;
+  });
+  parked_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ParallelSearchEngine::wakeOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (parked_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(parkMutex_);
+    ++wakeups_;
+  }
+  parkCv_.notify_one();
+}
+
+void ParallelSearchEngine::wakeAll() {
+  {
+    std::lock_guard<std::mutex> lock(parkMutex_);
+    ++wakeups_;
+  }
+  parkCv_.notify_all();
+}
+
+std::unique_ptr<state::SemanticState> ParallelSearchEngine::stealFor(size_t thief) {
+  const size_t n = workers_.size();
+  if (n == 1) {
+    return nullptr;
+  }
+  Worker& self = *workers_[thief];
+  // One round over all victims, starting at a random one.
+  size_t start = static_cast<size_t>(nextRandom(self.rng) % n);
+  for (size_t k = 0; k < n; ++k) {
+    size_t victim = (start + k) % n;
+    if (victim == thief) {
+      continue;
+    }
+    auto state = workers_[victim]->deque.steal();
+    if (state) {
+      self.steals.fetch_add(1, std::memory_order_relaxed);
+      return state;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<state::SemanticState> ParallelSearchEngine::takeExternal() {
+  if (externalSize_.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(externalMutex_);
+  if (external_.empty()) {
+    return nullptr;
+  }
+  auto state = std::move(external_.back());
+  external_.pop_back();
+  externalSize_.store(external_.size(), std::memory_order_release);
+  return state;
+}
+
+void ParallelSearchEngine::pushState(std::unique_ptr<state::SemanticState> state) {
+  if (!state) {
+    return;
+  }
+  pending_.fetch_add(1, std::memory_order_acq_rel);
+  if (Worker* worker = currentWorker()) {
+    worker->deque.push(std::move(state));
+  } else {
+    std::lock_guard<std::mutex> lock(externalMutex_);
+    external_.push_back(std::move(state));
+    externalSize_.store(external_.size(), std::memory_order_release);
+  }
+  wakeOne();
+}
+
+std::unique_ptr<state::SemanticState> ParallelSearchEngine::popState() {
+  std::unique_ptr<state::SemanticState> state;
+  if (Worker* worker = currentWorker()) {
+    state = worker->deque.pop();
+  } else {
+    std::lock_guard<std::mutex> lock(externalMutex_);
+    if (!external_.empty()) {
+      state = std::move(external_.back());
+      external_.pop_back();
+      externalSize_.store(external_.size(), std::memory_order_release);
+    }
+  }
+  if (state) {
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  return state;
+}
+
+bool ParallelSearchEngine::isEmpty() const {
+  return pending_.load(std::memory_order_acquire) == 0;
+}
+
+size_t ParallelSearchEngine::size() const {
+  return pending_.load(std::memory_order_acquire);
+}
+
+void ParallelSearchEngine::clear() {
+  for (auto& worker : workers_) {
+    worker->deque.clear();
+  }
+  std::lock_guard<std::mutex> lock(externalMutex_);
+  external_.clear();
+  externalSize_.store(0, std::memory_order_release);
+  pending_.store(0, std::memory_order_release);
+}
+
+uint64_t ParallelSearchEngine::getStealCount() const {
+  uint64_t total = 0;
+  for (const auto& worker : workers_) {
+    total += worker->steals.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+} // namespace search
+} // namespace semcal
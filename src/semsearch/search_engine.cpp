@@ -3,16 +3,34 @@
 namespace semcal {
 namespace search {
 
-DefaultSearchEngine::DefaultSearchEngine(SearchPolicy policy)
-  : currentPolicy_(policy) {
+std::unique_ptr<Frontier> makeFrontier(SearchPolicy policy, Heuristic heuristic) {
+  switch (policy) {
+    case SearchPolicy::DFS:
+      return std::make_unique<StackFrontier>();
+    case SearchPolicy::BFS:
+      return std::make_unique<FifoFrontier>();
+    case SearchPolicy::BEST_FIRST:
+      return std::make_unique<BestFirstFrontier>(std::move(heuristic));
+  }
+  return std::make_unique<StackFrontier>();
+}
+
+DefaultSearchEngine::DefaultSearchEngine(SearchPolicy policy, Heuristic heuristic)
+  : frontier_(makeFrontier(policy, heuristic)),
+    currentPolicy_(policy),
+    heuristic_(std::move(heuristic)) {
+}
+
+void DefaultSearchEngine::setPolicy(SearchPolicy policy) {
+  currentPolicy_ = policy;
+  frontier_ = makeFrontier(policy, heuristic_);
 }
 
 SearchResult DefaultSearchEngine::execute(
     const state::SemanticState& initialState,
     std::function<SearchResult(state::SemanticState&)> strategy,
     SearchPolicy policy) {
-  currentPolicy_ = policy;
-  clear();
+  setPolicy(policy);
   
   auto state = initialState.clone();
   pushState(std::move(state));
@@ -37,31 +55,23 @@ SearchResult DefaultSearchEngine::execute(
 }
 
 void DefaultSearchEngine::pushState(std::unique_ptr<state::SemanticState> state) {
-  stateQueue_.push(std::move(state));
+  frontier_->push(std::move(state));
 }
 
 std::unique_ptr<state::SemanticState> DefaultSearchEngine::popState() {
-  if (stateQueue_.empty()) {
-    return nullptr;
-  }
-  
-  auto state = std::move(stateQueue_.front());
-  stateQueue_.pop();
-  return state;
+  return frontier_->pop();
 }
 
 bool DefaultSearchEngine::isEmpty() const {
-  return stateQueue_.empty();
+  return frontier_->empty();
 }
 
 size_t DefaultSearchEngine::size() const {
-  return stateQueue_.size();
+  return frontier_->size();
 }
 
 void DefaultSearchEngine::clear() {
-  while (!stateQueue_.empty()) {
-    stateQueue_.pop();
-  }
+  frontier_->clear();
 }
 
 } // namespace search
@@ -0,0 +1,99 @@
+#include "semsearch/work_stealing_deque.h"
+
+namespace semcal {
+namespace search {
+
+WorkStealingDeque::WorkStealingDeque(size_t initialCapacity) {
+  int64_t capacity = 1;
+  while (capacity < static_cast<int64_t>(initialCapacity)) {
+    capacity <<= 1;
+  }
+  buffers_.push_back(std::make_unique<Buffer>(capacity));
+  buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  clear();
+}
+
+void WorkStealingDeque::push(std::unique_ptr<state::SemanticState> state) {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_acquire);
+  Buffer* buf = buffer_.load(std::memory_order_relaxed);
+  if (b - t > buf->capacity - 1) {
+    buf = grow(buf, t, b);
+  }
+  buf->put(b, state.release());
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+std::unique_ptr<state::SemanticState> WorkStealingDeque::pop() {
+  int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  Buffer* buf = buffer_.load(std::memory_order_relaxed);
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_relaxed);
+
+  state::SemanticState* result = nullptr;
+  if (t <= b) {
+    result = buf->get(b);
+    if (t == b) {
+      // Last element: race against thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        result = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+  } else {
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+  return std::unique_ptr<state::SemanticState>(result);
+}
+
+std::unique_ptr<state::SemanticState> WorkStealingDeque::steal() {
+  int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  Buffer* buf = buffer_.load(std::memory_order_acquire);
+  state::SemanticState* result = buf->get(t, std::memory_order_acquire);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return std::unique_ptr<state::SemanticState>(result);
+}
+
+size_t WorkStealingDeque::size() const {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  return b > t ? static_cast<size_t>(b - t) : 0;
+}
+
+void WorkStealingDeque::clear() {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  Buffer* buf = buffer_.load(std::memory_order_relaxed);
+  for (int64_t i = t; i < b; ++i) {
+    delete buf->get(i);
+  }
+  bottom_.store(t, std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Buffer* WorkStealingDeque::grow(Buffer* old, int64_t top, int64_t bottom) {
+  auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+  for (int64_t i = top; i < bottom; ++i) {
+    bigger->put(i, old->get(i));
+  }
+  Buffer* result = bigger.get();
+  buffers_.push_back(std::move(bigger));
+  buffer_.store(result, std::memory_order_release);
+  return result;
+}
+
+} // namespace search
+} // namespace semcal
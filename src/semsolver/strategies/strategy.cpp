@@ -1,6 +1,7 @@
 #include "semsolver/strategies/strategy.h"
 #include "semsolver/strategies/pipeline.h"
 #include "semcal/util/op_result.h"
+#include "semsearch/frontier.h"
 #include <queue>
 #include <algorithm>
 #include <vector>
@@ -43,7 +44,8 @@ std::vector<std::unique_ptr<semcal::state::SemanticState>> LegacyDepthFirstStrat
         }
         auto& decomposed = decomposeResult.value.value();
         
-        if (decomposed.size() == 1 && decomposed[0]->toString() == state->toString()) {
+        if (!decomposeResult.progress ||
+            (decomposed.size() == 1 && decomposed[0]->sameAs(*state))) {
             // No decomposition occurred, this is a leaf
             result.push_back(std::move(state));
         } else {
@@ -87,7 +89,8 @@ std::vector<std::unique_ptr<semcal::state::SemanticState>> LegacyBreadthFirstStr
         }
         auto& decomposed = decomposeResult.value.value();
         
-        if (decomposed.size() == 1 && decomposed[0]->toString() == state->toString()) {
+        if (!decomposeResult.progress ||
+            (decomposed.size() == 1 && decomposed[0]->sameAs(*state))) {
             // No decomposition occurred, this is a leaf
             result.push_back(std::move(state));
         } else {
@@ -112,22 +115,13 @@ std::vector<std::unique_ptr<semcal::state::SemanticState>> LegacyBestFirstStrate
     LegacyOperatorPipeline& pipeline) const {
     std::vector<std::unique_ptr<semcal::state::SemanticState>> result;
     
-    // Use a priority queue with the heuristic
-    auto compare = [this](const std::unique_ptr<semcal::state::SemanticState>& a,
-                          const std::unique_ptr<semcal::state::SemanticState>& b) {
-        return heuristic_(*a) > heuristic_(*b); // Lower heuristic value = higher priority
-    };
-    
-    std::priority_queue<
-        std::unique_ptr<semcal::state::SemanticState>,
-        std::vector<std::unique_ptr<semcal::state::SemanticState>>,
-        decltype(compare)> queue(compare);
+    // Priorities are computed once on push and cached in the frontier
+    semcal::search::BestFirstFrontier queue(heuristic_);
     
     queue.push(initialState.clone());
     
     while (!queue.empty()) {
-        auto state = std::move(const_cast<std::unique_ptr<semcal::state::SemanticState>&>(queue.top()));
-        queue.pop();
+        auto state = queue.pop();
         
         // Check if infeasible
         auto infeasibleResult = pipeline.getInfeasible().apply(*state);
@@ -142,7 +136,8 @@ std::vector<std::unique_ptr<semcal::state::SemanticState>> LegacyBestFirstStrate
         }
         auto& decomposed = decomposeResult.value.value();
         
-        if (decomposed.size() == 1 && decomposed[0]->toString() == state->toString()) {
+        if (!decomposeResult.progress ||
+            (decomposed.size() == 1 && decomposed[0]->sameAs(*state))) {
             // No decomposition occurred, this is a leaf
             result.push_back(std::move(state));
         } else {